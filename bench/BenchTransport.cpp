@@ -0,0 +1,218 @@
+/**
+ * @file BenchTransport.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <arpa/inet.h>
+#include <benchmark/benchmark.h>
+#include <fix/FixBuilder.hpp>
+#include <fix/FixTag.hpp>
+#include <logger/Logger.hpp>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <socket/Server.hpp>
+#include <socket/ShmChannel.hpp>
+#include <socket/SocketAddress.hpp>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+
+namespace
+{
+
+/* Sends every message straight back to the sender */
+class EchoServer : public Server
+{
+public:
+    using Server::Server;
+
+protected:
+    void handleMessage(Message message, SocketFD fromSocket) override { sendMessage(std::move(message), fromSocket); }
+};
+
+
+/* Blocking loopback client. Returns (-1) on error */
+int connectTo(ConnectionManager::Port port)
+{
+    int clientSocket = socket(AF_INET, SOCK_STREAM, 0);
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (clientSocket == (-1) || connect(clientSocket, (const struct sockaddr *)&address, sizeof(address)) == (-1))
+    {
+        return (-1);
+    }
+
+    int state{1};
+    setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &state, sizeof(state));
+    return clientSocket;
+}
+
+
+/* Blocking AF_UNIX stream client. Returns (-1) on error */
+int connectTo(const SocketAddress &address)
+{
+    int clientSocket = address.openSocket();
+
+    sockaddr_storage storage;
+    socklen_t length = address.toSockaddr(storage, true);
+
+    if (clientSocket == (-1) || connect(clientSocket, (const struct sockaddr *)&storage, length) == (-1))
+    {
+        return (-1);
+    }
+
+    return clientSocket;
+}
+
+
+bool readExactly(int socket, char *buffer, std::size_t n)
+{
+    for (std::size_t nRead = 0; nRead < n;)
+    {
+        long result = recv(socket, buffer + nRead, n - nRead, 0);
+        if (result <= 0)
+            return false;
+
+        nRead += result;
+    }
+
+    return true;
+}
+
+
+/* Round-trip a FIX message through an echo server. range(0): reactor threads; range(1): backend */
+void BM_LoopbackPingPong(benchmark::State &state)
+{
+    Logger::instance().setLevel(Logger::Warn);
+
+    static ConnectionManager::Port port = 24680;
+
+    EchoServer server(++port);
+    server.setReactorThreads(state.range(0), static_cast<ConnectionManager::ReactorBackend>(state.range(1)));
+    server.start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); /* Listening */
+
+    int clientSocket = connectTo(server.port());
+    if (clientSocket == (-1))
+    {
+        state.SkipWithError("Failed to connect to echo server");
+        server.stop();
+        server.wait();
+        return;
+    }
+
+    FixBuilder builder(256);
+    builder.set<FixTag::MsgType>(FixMsgType::NewOrderSingle);
+    builder.append(FixTag::ClOrdID, "yhsbzifzjntuzmi");
+    builder.set<FixTag::Price>(FixPrice::fromDouble(100.0));
+    std::string_view message = builder.finish();
+
+    std::vector<char> reply(message.size());
+
+    for (auto _ : state)
+    {
+        if (send(clientSocket, message.data(), message.size(), MSG_NOSIGNAL) != static_cast<long>(message.size()) ||
+            !readExactly(clientSocket, reply.data(), reply.size()))
+        {
+            state.SkipWithError("Echo failed");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    close(clientSocket);
+    server.stop();
+    server.wait();
+}
+
+
+/* As BM_LoopbackPingPong over a shared-memory channel: no kernel copies */
+void BM_SharedMemoryPingPong(benchmark::State &state)
+{
+    Logger::instance().setLevel(Logger::Warn);
+
+    SocketAddress address(SocketAddress::Family::SharedMemory, "/tmp/talos-bench-" + std::to_string(getpid()) + ".sock");
+
+    EchoServer server(address);
+    server.start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); /* Listening */
+
+    int clientSocket = connectTo(address);
+    std::unique_ptr<ShmChannel> channel;
+
+    try
+    {
+        channel = (clientSocket != (-1) ? ShmChannel::accept(clientSocket) : nullptr);
+    }
+    catch (const std::exception &)
+    {
+    }
+
+    if (!channel)
+    {
+        state.SkipWithError("Failed to connect to echo server");
+        server.stop();
+        server.wait();
+        return;
+    }
+
+    FixBuilder builder(256);
+    builder.set<FixTag::MsgType>(FixMsgType::NewOrderSingle);
+    builder.append(FixTag::ClOrdID, "yhsbzifzjntuzmi");
+    builder.set<FixTag::Price>(FixPrice::fromDouble(100.0));
+    std::string_view message = builder.finish();
+
+    std::vector<char> reply(message.size());
+    const auto strategy = Doorbell::defaultStrategy();
+
+    for (auto _ : state)
+    {
+        channel->tryWrite(message.data(), message.size()); /* Ring is empty between iterations */
+        channel->notifyPeer();
+
+        std::size_t nRead = 0;
+        while (nRead < reply.size() && channel->waitReadable(clientSocket, strategy))
+        {
+            nRead += channel->read(reply.data() + nRead, reply.size() - nRead);
+        }
+
+        if (nRead != reply.size())
+        {
+            state.SkipWithError("Echo failed");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    channel->close();
+    close(clientSocket);
+    server.stop();
+    server.wait();
+}
+
+} // namespace
+
+
+BENCHMARK(BM_LoopbackPingPong)
+    ->ArgNames({"reactors", "backend"})
+    ->Args({0, 0}) /* Thread per connection */
+    ->Args({1, 0}) /* epoll */
+    ->Args({1, 1}) /* io_uring (epoll if unsupported) */
+    ->UseRealTime();
+
+BENCHMARK(BM_SharedMemoryPingPong)->UseRealTime();
@@ -8,26 +8,67 @@
  */
 
 #include "exchange/ExchangeServer.hpp"
+#include "socket/SocketAddress.hpp"
+#include "socket/SocketOptions.hpp"
+#include <cstring>
+#include <exception>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 
 int main(int argc, char *argv[])
 {
-    if (argc != 2)
+    if (argc < 2 || argc % 2 != 0)
     {
-        std::cout << "Usage: " << argv[0] << " [PORT]" << std::endl;
-        std::cout << "Run an exchange server on the specified port." << std::endl;
+        std::cout << "Usage: " << argv[0] << " [PORT|ADDRESS] [--socket-options SPEC] [--journal DIR]" << std::endl;
+        std::cout << "Run an exchange server on the specified port or address." << std::endl;
+        std::cout << "  ADDRESS: unix:/path (stream), unixpacket:/path (seqpacket) or shm:/path (shared memory) for co-located components" << std::endl;
+        std::cout << "  --socket-options: socket profile for connections, e.g. nodelay=1,sndbuf=262144,keepalive=30:10:3" << std::endl;
+        std::cout << "  --journal: number messages (MsgSeqNo) on sessions that log on with a SenderCompID, journaling sent messages in DIR for resends" << std::endl;
         return 0;
     }
 
-    int exchangePort = std::atoi(argv[1]);
-    if (!exchangePort)
+    SocketAddress exchangeAddress;
+    SocketOptions socketOptions;
+    std::string journalDirectory;
+
+    try
+    {
+        exchangeAddress = SocketAddress::parse(argv[1]);
+
+        for (int i = 2; i < argc; i += 2)
+        {
+            if (std::strcmp(argv[i], "--socket-options") == 0)
+                socketOptions = SocketOptions::parse(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--journal") == 0)
+                journalDirectory = argv[i + 1];
+            else
+                throw std::invalid_argument(std::string("unknown option ") + argv[i]);
+        }
+    }
+    catch (const std::exception &error)
     {
-        std::cerr << argv[0] << ": invalid port " << argv[1] << std::endl;
+        std::cerr << argv[0] << ": " << error.what() << std::endl;
         return 1;
     }
 
-    ExchangeServer exchange(static_cast<Server::Port>(exchangePort));
+    ExchangeServer exchange(exchangeAddress);
+    exchange.setSocketOptions(socketOptions);
+
+    if (!journalDirectory.empty())
+    {
+        try
+        {
+            exchange.enableSequencing(journalDirectory, "Exchange");
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << argv[0] << ": " << error.what() << std::endl;
+            return 1;
+        }
+    }
+
     exchange.start();
     exchange.wait();
     return 0;
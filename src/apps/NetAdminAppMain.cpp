@@ -9,6 +9,7 @@
 
 #include "netadmin/NetAdmin.hpp"
 #include <chrono>
+#include <exception>
 #include <iostream>
 #include <thread>
 
@@ -16,21 +17,26 @@ int main(int argc, char *argv[])
 {
     if (argc != 3 && argc != 4)
     {
-        std::cout << "Usage: " << argv[0] << " [PORT] [CMD]" << std::endl;
+        std::cout << "Usage: " << argv[0] << " [PORT|ADDRESS] [CMD]" << std::endl;
         std::cout << "Send admin commands to the specified application." << std::endl;
         return 0;
     }
 
-    int thePort = std::atoi(argv[1]);
-    if (!thePort)
+    SocketAddress serverAddress;
+
+    try
+    {
+        serverAddress = SocketAddress::parse(argv[1]);
+    }
+    catch (const std::exception &error)
     {
-        std::cerr << argv[0] << ": invalid port " << argv[1] << std::endl;
+        std::cerr << argv[0] << ": " << error.what() << std::endl;
         return 1;
     }
 
     NetAdmin adminClient;
     adminClient.start();
-    adminClient.connectToServer(static_cast<Client::Port>(thePort));
+    adminClient.connectToServer(serverAddress);
 
     adminClient.sendAdminCommand(std::string(argv[2]));
 
@@ -8,8 +8,20 @@
  */
 
 #include "engine/OMEngine.hpp"
+#include "logger/Logger.hpp"
+#include "socket/BackpressurePolicy.hpp"
+#include "socket/SocketAddress.hpp"
+#include "socket/SocketOptions.hpp"
+#include "utilities/ThreadTuning.hpp"
+#include <algorithm>
 #include <cstring>
+#include <exception>
 #include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 
 /**
@@ -17,27 +29,135 @@
  */
 int main(int argc, char *argv[])
 {
-    if (argc != 7)
+    if (argc < 7)
     {
-        std::cout << "Usage: " << argv[0] << "[--engine PORT] [--exchange EXCHANGE_PORT] [--database DB_PORT]" << std::endl;
+        std::cout << "Usage: " << argv[0] << "[--engine PORT|ADDRESS] [--exchange EXCHANGE_PORT|ADDRESS] [--database DB_PORT|ADDRESS] [--binary] [--reactor THREADS] [--uring] [--acceptors THREADS] [--ingress-wait spin|park|block] [--handlers THREADS] [--busy-spin] [--busy-poll USEC] [--fifo PRIORITY] [--pin-receive CPUS] [--pin-handler CPUS] [--pin-sender CPUS] [--pin-logger CPU] [--socket-options SPEC] [--exchange-socket-options SPEC] [--database-socket-options SPEC] [--backpressure SPEC] [--exchange-backpressure SPEC] [--database-backpressure SPEC] [--journal DIR]" << std::endl;
         std::cout << "Run a Talos OMEngine server on the specified port." << std::endl;
+        std::cout << "  ADDRESS: unix:/path (stream), unixpacket:/path (seqpacket) or shm:/path (shared memory) for co-located components" << std::endl;
+        std::cout << "  --binary: use binary encoding on exchange/database links" << std::endl;
+        std::cout << "  --reactor: run connections on THREADS epoll event-loops" << std::endl;
+        std::cout << "  --uring: use io_uring event-loops instead of epoll (falls back on older kernels)" << std::endl;
+        std::cout << "  --acceptors: accept client connections on THREADS threads with SO_REUSEPORT (default: 1)" << std::endl;
+        std::cout << "  --ingress-wait: how the message handler waits for input (default: park, block on one CPU)" << std::endl;
+        std::cout << "  --handlers: handle messages on THREADS threads, sharded by order (default: 1)" << std::endl;
+        std::cout << "  --busy-spin: receive, handler, sender and logger threads spin instead of sleeping" << std::endl;
+        std::cout << "  --busy-poll: set SO_BUSY_POLL to USEC on connections" << std::endl;
+        std::cout << "  --fifo: run pinned threads as SCHED_FIFO at PRIORITY (1-99)" << std::endl;
+        std::cout << "  --pin-*: pin threads of each role to CPUS round-robin (e.g. 2,3 or 4-7)" << std::endl;
+        std::cout << "  --socket-options: socket profile for all connections, e.g. nodelay=1,quickack=1,sndbuf=262144,rcvbuf=262144,busypoll=50,usertimeout=5000,keepalive=30:10:3" << std::endl;
+        std::cout << "  --exchange-socket-options, --database-socket-options: socket profile for that link only" << std::endl;
+        std::cout << "  --backpressure: outgoing queue policy for client sessions, e.g. policy=block|drop|disconnect,high=1024,low=768,timeout=5000" << std::endl;
+        std::cout << "  --exchange-backpressure, --database-backpressure: outgoing queue policy for that link only" << std::endl;
+        std::cout << "  --journal: number messages (MsgSeqNo) on exchange/database links and sequenced clients, journaling sent messages in DIR for resends" << std::endl;
         return 0;
     }
 
-    int enginePort{0}, exchangePort{0}, databasePort{0};
+    std::optional<SocketAddress> engineAddress, exchangeAddress, databaseAddress;
+    int reactorThreads{0};
+    int acceptorThreads{1};
+    int handlerThreads{1};
+    bool binaryInternalLinks{false};
+    bool useIoUring{false};
+    Doorbell::WaitStrategy ingressWait{Doorbell::defaultStrategy()};
+    ConnectionManager::LowLatencyConfig lowLatency;
+    int loggerCpu{-1};
+    SocketOptions socketOptions;
+    std::optional<SocketOptions> exchangeSocketOptions, databaseSocketOptions;
+    int busyPollMicros{0};
+    BackpressurePolicy backpressure;
+    std::optional<BackpressurePolicy> exchangeBackpressure, databaseBackpressure;
+    std::string journalDirectory;
 
-    for (int i = 1; i < argc; i += 2)
+    try /* Unknown options, missing values, malformed addresses/CPU lists/socket options/backpressure policies */
     {
-        if (std::strcmp(argv[i], "--engine") == 0)
-            enginePort = atoi(argv[i + 1]);
-        else if (std::strcmp(argv[i], "--exchange") == 0)
-            exchangePort = atoi(argv[i + 1]);
-        else if (std::strcmp(argv[i], "--database") == 0)
-            databasePort = atoi(argv[i + 1]);
+        /* Value of the option at argv[i] */
+        auto value = [argc, argv](int &i) -> const char *
+        {
+            if (i + 1 == argc)
+                throw std::invalid_argument(std::string("missing value for option ") + argv[i]);
+
+            return argv[++i];
+        };
+
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "--binary") == 0)
+                binaryInternalLinks = true;
+            else if (std::strcmp(argv[i], "--uring") == 0)
+                useIoUring = true;
+            else if (std::strcmp(argv[i], "--busy-spin") == 0)
+                lowLatency.busySpin = true;
+            else if (std::strcmp(argv[i], "--engine") == 0)
+                engineAddress = SocketAddress::parse(value(i));
+            else if (std::strcmp(argv[i], "--exchange") == 0)
+                exchangeAddress = SocketAddress::parse(value(i));
+            else if (std::strcmp(argv[i], "--database") == 0)
+                databaseAddress = SocketAddress::parse(value(i));
+            else if (std::strcmp(argv[i], "--reactor") == 0)
+                reactorThreads = atoi(value(i));
+            else if (std::strcmp(argv[i], "--acceptors") == 0)
+                acceptorThreads = atoi(value(i));
+            else if (std::strcmp(argv[i], "--handlers") == 0)
+                handlerThreads = atoi(value(i));
+            else if (std::strcmp(argv[i], "--ingress-wait") == 0)
+            {
+                const char *strategy = value(i);
+
+                if (std::strcmp(strategy, "spin") == 0)
+                    ingressWait = Doorbell::WaitStrategy::Spin;
+                else if (std::strcmp(strategy, "block") == 0)
+                    ingressWait = Doorbell::WaitStrategy::Block;
+                else if (std::strcmp(strategy, "park") == 0)
+                    ingressWait = Doorbell::WaitStrategy::SpinThenPark;
+                else
+                    throw std::invalid_argument(std::string("unknown ingress wait strategy ") + strategy);
+            }
+            else if (std::strcmp(argv[i], "--busy-poll") == 0)
+                busyPollMicros = atoi(value(i));
+            else if (std::strcmp(argv[i], "--socket-options") == 0)
+                socketOptions = SocketOptions::parse(value(i));
+            else if (std::strcmp(argv[i], "--exchange-socket-options") == 0)
+                exchangeSocketOptions = SocketOptions::parse(value(i));
+            else if (std::strcmp(argv[i], "--database-socket-options") == 0)
+                databaseSocketOptions = SocketOptions::parse(value(i));
+            else if (std::strcmp(argv[i], "--backpressure") == 0)
+                backpressure = BackpressurePolicy::parse(value(i));
+            else if (std::strcmp(argv[i], "--exchange-backpressure") == 0)
+                exchangeBackpressure = BackpressurePolicy::parse(value(i));
+            else if (std::strcmp(argv[i], "--database-backpressure") == 0)
+                databaseBackpressure = BackpressurePolicy::parse(value(i));
+            else if (std::strcmp(argv[i], "--journal") == 0)
+                journalDirectory = value(i);
+            else if (std::strcmp(argv[i], "--fifo") == 0)
+                lowLatency.fifoPriority = atoi(value(i));
+            else if (std::strncmp(argv[i], "--pin-", 6) == 0)
+            {
+                const char *role = argv[i] + 6;
+                std::vector<int> cpus = ThreadTuning::parseCpuList(value(i));
+
+                if (std::strcmp(role, "receive") == 0)
+                    lowLatency.receiveCpus = std::move(cpus);
+                else if (std::strcmp(role, "handler") == 0)
+                    lowLatency.handlerCpus = std::move(cpus);
+                else if (std::strcmp(role, "sender") == 0)
+                    lowLatency.senderCpus = std::move(cpus);
+                else if (std::strcmp(role, "logger") == 0)
+                    loggerCpu = ThreadTuning::select(cpus, 0);
+                else
+                    throw std::invalid_argument(std::string("unknown option ") + argv[i - 1]);
+            }
+            else
+                throw std::invalid_argument(std::string("unknown option ") + argv[i]);
+        }
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << argv[0] << ": " << error.what() << std::endl;
+        return 1;
     }
 
     /* Verify */
-    if (!enginePort || !exchangePort || !databasePort)
+    if (!engineAddress || !exchangeAddress || !databaseAddress)
     {
         std::cerr << argv[1] << ": invalid/missing port(s)" << std::endl;
         return 1;
@@ -45,10 +165,54 @@ int main(int argc, char *argv[])
 
     /* TODO: - enable connections to multiple exchanges (can figure-out by tag 100 [named exchange]) */
 
-    OMEngine engineServer(static_cast<Server::Port>(enginePort));
+    if (busyPollMicros > 0) /* Shorthand: every connection */
+    {
+        socketOptions.busyPollMicros = busyPollMicros;
+        if (exchangeSocketOptions)
+            exchangeSocketOptions->busyPollMicros = busyPollMicros;
+        if (databaseSocketOptions)
+            databaseSocketOptions->busyPollMicros = busyPollMicros;
+    }
+
+    Logger::instance().setThreadTuning(loggerCpu, (loggerCpu >= 0 ? lowLatency.fifoPriority : 0), lowLatency.busySpin);
+
+    OMEngine engineServer(*engineAddress);
+
+    if (!journalDirectory.empty())
+    {
+        try
+        {
+            engineServer.enableSequencing(journalDirectory, "OMEngine");
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << argv[0] << ": " << error.what() << std::endl;
+            return 1;
+        }
+    }
+
+    engineServer.enableBinaryInternalLinks(binaryInternalLinks);
+    engineServer.setIngressWaitStrategy(ingressWait);
+    engineServer.setHandlerThreads(static_cast<std::size_t>(std::max(handlerThreads, 1)));
+    engineServer.setAcceptorThreads(static_cast<std::size_t>(std::max(acceptorThreads, 1)));
+    engineServer.setLowLatencyConfig(std::move(lowLatency));
+    engineServer.setSocketOptions(socketOptions);
+    if (exchangeSocketOptions)
+        engineServer.setSocketOptions(*exchangeAddress, *exchangeSocketOptions);
+    if (databaseSocketOptions)
+        engineServer.setSocketOptions(*databaseAddress, *databaseSocketOptions);
+    engineServer.setBackpressurePolicy(backpressure);
+    if (exchangeBackpressure)
+        engineServer.setBackpressurePolicy(*exchangeAddress, *exchangeBackpressure);
+    if (databaseBackpressure)
+        engineServer.setBackpressurePolicy(*databaseAddress, *databaseBackpressure);
+    if (useIoUring)
+        engineServer.setReactorThreads(static_cast<std::size_t>(std::max(reactorThreads, 1)), ConnectionManager::ReactorBackend::IoUring);
+    else
+        engineServer.setReactorThreads(static_cast<std::size_t>(std::max(reactorThreads, 0)));
     engineServer.start();
-    engineServer.connectToExchangeServer(static_cast<Server::Port>(exchangePort));
-    engineServer.connectToDatabaseServer(static_cast<Server::Port>(databasePort));
+    engineServer.connectToExchangeServer(*exchangeAddress);
+    engineServer.connectToDatabaseServer(*databaseAddress);
     engineServer.wait();
     return 0;
 }
\ No newline at end of file
@@ -8,13 +8,14 @@
  */
 
 #include "client/OrderGenerator.hpp"
+#include <exception>
 #include <iostream>
 
 int main(int argc, char *argv[])
 {
     if (argc != 2)
     {
-        std::cout << "Usage: " << argv[0] << " [ENGINE_PORT]" << std::endl;
+        std::cout << "Usage: " << argv[0] << " [ENGINE_PORT|ADDRESS]" << std::endl;
         std::cout << "Send Fix messages to a Talos OMEngine on the specified port." << std::endl;
         return 0;
     }
@@ -22,16 +23,21 @@ int main(int argc, char *argv[])
     /* TODO: - add additional options to connect to multiple engines, use broadcast to send messages to all */
     /* TODO: - add option for # messages to be sent and interval */
 
-    int enginePort = std::atoi(argv[1]);
-    if (!enginePort)
+    SocketAddress serverAddress;
+
+    try
+    {
+        serverAddress = SocketAddress::parse(argv[1]);
+    }
+    catch (const std::exception &error)
     {
-        std::cerr << argv[0] << ": invalid port " << argv[1] << std::endl;
+        std::cerr << argv[0] << ": " << error.what() << std::endl;
         return 1;
     }
 
     OrderGenerator orderGeneratorClient;
     orderGeneratorClient.start();
-    orderGeneratorClient.connectToServer(static_cast<Client::Port>(enginePort));
+    orderGeneratorClient.connectToServer(serverAddress);
     orderGeneratorClient.sendNewOrders(1000, 1000); // 1second between orders for testing
     orderGeneratorClient.wait();
     return 0;
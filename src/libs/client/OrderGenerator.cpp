@@ -9,6 +9,7 @@
 
 #include "OrderGenerator.hpp"
 #include "logger/Logger.hpp"
+#include "utilities/Clock.hpp"
 #include "utilities/UUID.hpp"
 #include <chrono>
 #include <stdexcept>
@@ -16,6 +17,19 @@
 #include <unistd.h>
 
 
+namespace
+{
+/* Fields common to every dummy order. Encoded once */
+const FixTemplate newOrderTemplate{{FixTag::MsgType, "D"},
+                                   {FixTag::Side, "1"},
+                                   {FixTag::Currency, "GBP"},
+                                   {FixTag::ExecTransType, "0"}, // 20=0
+                                   {FixTag::ExecType, "0"},      // 150=0
+                                   {FixTag::OrdStatus, "0"},     // 39=0 (New)
+                                   {FixTag::SenderSubID, "OrderGenerator"}};
+} // namespace
+
+
 void OrderGenerator::sendNewOrders(std::size_t nOrders, std::size_t delayMS)
 {
     auto sockets = _portSocketMappings.getSockets();
@@ -25,40 +39,32 @@ void OrderGenerator::sendNewOrders(std::size_t nOrders, std::size_t delayMS)
         return;
     }
 
+    FixBuilder builder(512); /* Fixed fields plus a 15-character ClOrdID. Each broadcast takes the buffer */
+
     for (std::size_t iOrder = 0; iOrder < nOrders; ++iOrder)
     {
-        auto newOrder = buildNewOrder();
+        std::string clOrdID = UUID::instance().generate(15); /* New unique ID for client order */
 
         if (delayMS)
         {
             std::this_thread::sleep_for(std::chrono::milliseconds(delayMS));
         }
 
-        for (auto socket : sockets)
-        {
-            sendFixMessage(newOrder, socket);
-        }
+        builder.reset();
+        buildNewOrder(builder, clOrdID);
+        broadcastFixMessage(builder, sockets);
     }
 }
 
 
-FixMessage OrderGenerator::buildNewOrder()
+void OrderGenerator::buildNewOrder(FixBuilder &builder, std::string_view clOrdID) const
 {
-    FixMessage dummyOrder;
+    newOrderTemplate.apply(builder);
 
-    dummyOrder.setTag(FixTag::MsgType, "D");
-    dummyOrder.setTag(FixTag::Side, "1");
-    dummyOrder.setTag(FixTag::Currency, "GBP");
-    dummyOrder.setTag(FixTag::OrderQty, "1");
-    dummyOrder.setTag(FixTag::Price, "100.00");
-    dummyOrder.setTag(FixTag::ExecTransType, "0");
-    dummyOrder.setTag(FixTag::ExecTransType, "0"); // 20=0
-    dummyOrder.setTag(FixTag::ExecType, "0");      // 150=0
-    dummyOrder.setTag(FixTag::OrderQty, "0");      // 39=0 (New)
-    dummyOrder.setTag(FixTag::SenderSubID, "OrderGenerator");
-    dummyOrder.setTag(FixTag::ClOrdID, UUID::instance().generate(15)); /* New unique ID for client order */
+    /* Variable slots */
+    builder.set<FixTag::OrderQty>(1);
+    builder.set<FixTag::Price>(FixPrice::fromDouble(100.0));
+    builder.append(FixTag::ClOrdID, clOrdID);
+    builder.appendTimestamp(FixTag::TransactTime);
     /* TODO: - add security and other tags */
-    /* TODO: - add tag 60 as current time */
-
-    return dummyOrder;
 }
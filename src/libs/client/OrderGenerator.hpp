@@ -8,8 +8,9 @@
  */
 
 #pragma once
-#include "fix/FixMessage.hpp"
+#include "fix/FixBuilder.hpp"
 #include "socket/FixClient.hpp"
+#include <string_view>
 
 
 /* Generates dummy FIX orders for stress-testing an OMEngine */
@@ -20,9 +21,9 @@ public:
 
 protected:
     /* Note: Not handling any incoming messages currently */
-    void handleFixMessage(FixMessage, SocketFD) final{};
+    void handleFixMessage(const FixMessageView &, SocketFD) final{};
 
-    FixMessage buildNewOrder();
+    void buildNewOrder(FixBuilder &builder, std::string_view clOrdID) const;
 
     /* Add correct, cancel methods to construct those message with message ID */
 };
\ No newline at end of file
@@ -17,14 +17,14 @@ void DatabaseServer::onRegisterMsgTypes()
     FixServer::onRegisterMsgTypes();
 
     /* New */
-    registerMsgTypeHandler("D", std::bind(&DatabaseServer::handleNewOrder, this, std::placeholders::_1, std::placeholders::_2));
+    registerMsgTypeHandler(FixMsgType::NewOrderSingle, std::bind(&DatabaseServer::handleNewOrder, this, std::placeholders::_1, std::placeholders::_2));
 
     /* Execution report */
-    registerMsgTypeHandler("8", std::bind(&DatabaseServer::handleExecutionReport, this, std::placeholders::_1, std::placeholders::_2));
+    registerMsgTypeHandler(FixMsgType::ExecutionReport, std::bind(&DatabaseServer::handleExecutionReport, this, std::placeholders::_1, std::placeholders::_2));
 }
 
 
-void DatabaseServer::handleNewOrder(FixMessage fixMsg, SocketFD)
+void DatabaseServer::handleNewOrder(const FixMessageView &fixMsg, SocketFD)
 {
     std::string clOrdID(fixMsg.getValue(FixTag::ClOrdID));
 
@@ -37,12 +37,12 @@ void DatabaseServer::handleNewOrder(FixMessage fixMsg, SocketFD)
     auto orderRecord = std::make_unique<OrderRecord>();
 
     orderRecord->clOrdID = clOrdID;
-    orderRecord->orderStatus = "0"; /* New */
-    orderRecord->side = fixMsg.getValue(FixTag::Side);
-    orderRecord->currency = fixMsg.getValue(FixTag::Currency);
-    orderRecord->orderQty = fixMsg.getValue(FixTag::OrderQty);
-    orderRecord->price = fixMsg.getValue(FixTag::Price);
-    orderRecord->execType = "0";
+    orderRecord->orderStatus = FixOrdStatus::New;
+    orderRecord->side = fixMsg.get<FixTag::Side>();
+    orderRecord->currency = fixMsg.get<FixTag::Currency>();
+    orderRecord->orderQty = fixMsg.get<FixTag::OrderQty>();
+    orderRecord->price = fixMsg.get<FixTag::Price>();
+    orderRecord->execType = FixExecType::New;
     orderRecord->lastUpdateTime = orderRecord->creationTime = nowUTC();
 
     Logger::instance().info("Created new order record for ClOrdID " + clOrdID);
@@ -52,7 +52,7 @@ void DatabaseServer::handleNewOrder(FixMessage fixMsg, SocketFD)
 }
 
 
-void DatabaseServer::handleExecutionReport(FixMessage fixMsg, SocketFD)
+void DatabaseServer::handleExecutionReport(const FixMessageView &fixMsg, SocketFD)
 {
     std::string clOrdID(fixMsg.getValue(FixTag::ClOrdID));
 
@@ -63,9 +63,9 @@ void DatabaseServer::handleExecutionReport(FixMessage fixMsg, SocketFD)
         return;
     }
 
-    std::string newOrdStatus(fixMsg.getValue(FixTag::OrdStatus));
+    FixOrdStatus newOrdStatus = fixMsg.get<FixTag::OrdStatus>();
 
-    Logger::instance().info("Updating " + clOrdID + ": " + orderRecord->orderStatus + " => " + newOrdStatus);
+    Logger::instance().info("Updating " + clOrdID + ": " + static_cast<char>(orderRecord->orderStatus) + " => " + static_cast<char>(newOrdStatus));
 
     std::unique_lock lock(_orderRecordMutex);
     orderRecord->orderStatus = newOrdStatus;
@@ -13,23 +13,24 @@
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 
 class DatabaseServer : public FixServer
 {
 public:
-    DatabaseServer(Port dbPort) : FixServer(dbPort) {}
+    DatabaseServer(SocketAddress dbAddress) : FixServer(std::move(dbAddress)) {}
 
 protected:
     struct OrderRecord
     {
-        std::string clOrdID;     // 11
-        std::string orderStatus; // 39: current execution report: 0=New, 1=PartialFill, 2=Fill, 4=Cancelled; 8=Rejected
-        std::string side;        // 54: 1=Buy, 2=Sell
-        std::string currency;    // 15: GBP, USD, EUR
-        std::string orderQty;    // 38
-        std::string price;       // 44
-        std::string execType;    // 150: specific execution report
+        std::string clOrdID;      // 11
+        FixOrdStatus orderStatus; // 39: current execution report: 0=New, 1=PartialFill, 2=Fill, 4=Cancelled; 8=Rejected
+        FixSide side;             // 54: 1=Buy, 2=Sell
+        std::string currency;     // 15: GBP, USD, EUR
+        FixQty orderQty;          // 38
+        FixPrice price;           // 44
+        FixExecType execType;     // 150: specific execution report
         std::string creationTime;
         std::string lastUpdateTime;
     };
@@ -38,10 +39,10 @@ protected:
     OrderRecord *lookupOrderRecord(std::string originalClOrdID);
 
     /* 35=D message */
-    void handleNewOrder(FixMessage message, SocketFD socket);
+    void handleNewOrder(const FixMessageView &message, SocketFD socket);
 
     /* 35=8 message */
-    void handleExecutionReport(FixMessage message, SocketFD socket);
+    void handleExecutionReport(const FixMessageView &message, SocketFD socket);
 
     /* Hooks */
     void onRegisterMsgTypes() override;
@@ -8,21 +8,29 @@
  */
 
 #include "OMEngine.hpp"
+#include "fix/FixBuilder.hpp"
 #include "logger/Logger.hpp"
 #include <functional>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 
 
+namespace
+{
+/* Acknowledgement of a new client order: 35=8; 39=0 */
+const FixTemplate newExecReportTemplate{{FixTag::MsgType, "8"}, {FixTag::OrdStatus, "0"}};
+} // namespace
+
+
 void OMEngine::onRegisterMsgTypes()
 {
     FixServer::onRegisterMsgTypes();
 
-    /* TODO: - use an enum rather than a string for msgType */
     /* TODO: - add a callback on a timer if we don't receive a response from the exchange within T milliseconds => Error */
-    registerMsgTypeHandler("D", std::bind(&OMEngine::handleClientFixMessage, this, std::placeholders::_1, std::placeholders::_2));
-    registerMsgTypeHandler("8", std::bind(&OMEngine::handleExchangeFixMessage, this, std::placeholders::_1, std::placeholders::_2));
+    registerMsgTypeHandler(FixMsgType::NewOrderSingle, std::bind(&OMEngine::handleClientFixMessage, this, std::placeholders::_1, std::placeholders::_2));
+    registerMsgTypeHandler(FixMsgType::ExecutionReport, std::bind(&OMEngine::handleExchangeFixMessage, this, std::placeholders::_1, std::placeholders::_2));
 }
 
 
@@ -42,7 +50,7 @@ void OMEngine::onRegisterNetAdminCmds()
         std::ostringstream response;
         for (auto socket : _portSocketMappings.getSockets())
         {
-            response << "socket " << socket << " <--> port " << _portSocketMappings.getPort(socket) << std::endl;
+            response << "socket " << socket << " <--> " << _portSocketMappings.getAddress(socket) << std::endl;
         }
         sendNetAdminResponse(response.str(), senderSocket);
     });
@@ -53,75 +61,85 @@ void OMEngine::onRegisterNetAdminCmds()
 
 /* TODO: - add a retry connection loop if we fail to connect the first couple of times (try every few seconds) */
 
-bool OMEngine::connectToExchangeServer(Port exchangePort)
+bool OMEngine::connectToExchangeServer(const SocketAddress &exchangeAddress)
 {
-    bool ok = connectToServer(exchangePort);
+    bool ok = connectToServer(exchangeAddress);
     if (ok)
     {
-        _exchangeSocket = _portSocketMappings.getSocket(exchangePort);
+        _exchangeSocket = _portSocketMappings.getSocket(exchangeAddress);
+
+        if (_binaryInternalLinks || sequencingEnabled())
+            logon(_exchangeSocket, _binaryInternalLinks);
     }
 
     return ok;
 }
 
 
-bool OMEngine::connectToDatabaseServer(Port databasePort)
+bool OMEngine::connectToDatabaseServer(const SocketAddress &databaseAddress)
 {
-    bool ok = connectToServer(databasePort);
+    bool ok = connectToServer(databaseAddress);
     if (ok)
     {
-        _databaseSocket = _portSocketMappings.getSocket(databasePort);
+        _databaseSocket = _portSocketMappings.getSocket(databaseAddress);
+
+        if (_binaryInternalLinks || sequencingEnabled())
+            logon(_databaseSocket, _binaryInternalLinks);
     }
 
     return ok;
 }
 
 
-void OMEngine::handleClientFixMessage(FixMessage clientFixMsg, SocketFD clientSocket)
+void OMEngine::handleClientFixMessage(const FixMessageView &clientFixMsg, SocketFD clientSocket)
 {
     /* TODO: - add additional subhandling for different message types such as new/correction/cancellation */
     /* NB: currently assume all messages from client are 20=0; 39=0; 150=0; */
     /* TODO: - enable routing to multiple exchanges based on message tags */
 
     /* Client (35=D) --> OMEngine */
-    updateClientSocketMap(clientFixMsg.getValue(FixTag::ClOrdID), clientSocket);
+    updateClientSocketMap(std::string(clientFixMsg.getValue(FixTag::ClOrdID)), clientSocket);
 
     /* OMEngine --> Exchange, Database (35=D) */
-    sendFixMessage(clientFixMsg, _exchangeSocket);
-    sendFixMessage(clientFixMsg, _databaseSocket);
+    FixMessage order(clientFixMsg);
+
+    sendFixMessage(order, _exchangeSocket);
+    sendFixMessage(order, _databaseSocket);
 
     /* OMEngine --> Client, Database (35=8) */
-    FixMessage execReport(clientFixMsg);
-    execReport.setTag(FixTag::MsgType, "8");
-    execReport.setTag(FixTag::OrdStatus, "0"); /* New */
+    /* Copies the order's fields => sized from the order. Each send hands the buffer to the queue */
+    FixBuilder execReport(clientFixMsg.textLength() + 256);
 
-    sendFixMessage(execReport, clientSocket);
-    sendFixMessage(execReport, _databaseSocket);
+    for (SocketFD socket : {clientSocket, _databaseSocket})
+    {
+        execReport.reset();
+        newExecReportTemplate.apply(execReport);
+        execReport.appendFieldsOf(clientFixMsg, {FixTag::MsgType, FixTag::MsgSeqNo, FixTag::OrdStatus, FixTag::TransactTime, FixTag::SendingTime});
+        execReport.appendTimestamp(FixTag::TransactTime);
+
+        sendFixMessage(execReport, socket);
+    }
 }
 
 
-void OMEngine::handleExchangeFixMessage(FixMessage exchFixMsg, SocketFD exchangeSocket)
+void OMEngine::handleExchangeFixMessage(const FixMessageView &exchFixMsg, SocketFD exchangeSocket)
 {
-    /* TODO: - map to an enum */
-    std::string orderStatus(exchFixMsg.getValue(FixTag::OrdStatus));
-
-    if (orderStatus == "1") /* Partial fill */
-    {
-        handleExchangePartialFill(std::move(exchFixMsg), exchangeSocket);
-    }
-    else if (orderStatus == "2") /* Fill */
-    {
-        handleExchangeFill(std::move(exchFixMsg), exchangeSocket);
-    }
-    else
+    switch (exchFixMsg.get<FixTag::OrdStatus>())
     {
-        /* Handle other cases */
-        Logger::instance().error("Not handling exchange message with order status [" + orderStatus + "]");
+        case FixOrdStatus::PartiallyFilled:
+            handleExchangePartialFill(exchFixMsg, exchangeSocket);
+            break;
+        case FixOrdStatus::Filled:
+            handleExchangeFill(exchFixMsg, exchangeSocket);
+            break;
+        default: /* Handle other cases */
+            Logger::instance().error("Not handling exchange message with order status [" + std::string(exchFixMsg.getValue(FixTag::OrdStatus)) + "]");
+            break;
     }
 }
 
 
-void OMEngine::handleExchangePartialFill(FixMessage exchFixMsg, SocketFD)
+void OMEngine::handleExchangePartialFill(const FixMessageView &exchFixMsg, SocketFD)
 {
     /* Exchange (35=8; 39=1) => OMEngine */
     /* OMEngine (35=8) => Client, DB */
@@ -133,16 +151,18 @@ void OMEngine::handleExchangePartialFill(FixMessage exchFixMsg, SocketFD)
 
     /* NB: do not erase clOrdID from map => wait for Fill/Rejection */
 
+    FixMessage execReport(exchFixMsg);
+
     if (clientSocket == (-1))
         Logger::instance().error("No client socket found for clOrdID " + clOrdID);
     else
-        sendFixMessage(exchFixMsg, clientSocket);
+        sendFixMessage(execReport, clientSocket);
 
-    sendFixMessage(exchFixMsg, _databaseSocket);
+    sendFixMessage(execReport, _databaseSocket);
 }
 
 
-void OMEngine::handleExchangeFill(FixMessage exchFixMsg, SocketFD)
+void OMEngine::handleExchangeFill(const FixMessageView &exchFixMsg, SocketFD)
 {
     /* Exchange (35=8; 39=2) => OMEngine */
     /* OMEngine (35=8) => Client, DB */
@@ -155,12 +175,14 @@ void OMEngine::handleExchangeFill(FixMessage exchFixMsg, SocketFD)
     /* Now we have a fill, we can erase the clOrdID from the map to save memory */
     eraseClientSocketMap(clOrdID);
 
+    FixMessage execReport(exchFixMsg);
+
     if (clientSocket == (-1))
         Logger::instance().error("No client socket found for clOrdID " + clOrdID);
     else
-        sendFixMessage(exchFixMsg, clientSocket);
+        sendFixMessage(execReport, clientSocket);
 
-    sendFixMessage(exchFixMsg, _databaseSocket);
+    sendFixMessage(execReport, _databaseSocket);
 }
 
 
@@ -13,6 +13,7 @@
 #include "socket/FixServer.hpp"
 #include <shared_mutex>
 #include <unordered_map>
+#include <utility>
 
 
 /**
@@ -31,27 +32,30 @@ class OMEngine : public FixServer
 public:
     OMEngine() = delete;
 
-    OMEngine(Port enginePort) : FixServer(enginePort) {}
+    OMEngine(SocketAddress engineAddress) : FixServer(std::move(engineAddress)) {}
 
     /* Setup connection to exchange server. Should be called after start() and before wait() */
-    bool connectToExchangeServer(Port exchangePort);
+    bool connectToExchangeServer(const SocketAddress &exchangeAddress);
 
-    bool connectToDatabaseServer(Port databasePort);
+    bool connectToDatabaseServer(const SocketAddress &databaseAddress);
+
+    /* Negotiate binary encoding on exchange/database links. Call before connecting */
+    inline void enableBinaryInternalLinks(bool enable = true) { _binaryInternalLinks = enable; }
 
 protected:
     using FixServer::connectToServer; /* Protect since we have the exchange, DB methods */
 
     /* 35=D */
-    void handleClientFixMessage(FixMessage fixMsg, SocketFD senderSocket);
+    void handleClientFixMessage(const FixMessageView &fixMsg, SocketFD senderSocket);
 
     /* 35=8 */
-    void handleExchangeFixMessage(FixMessage fixMsg, SocketFD senderSocket);
+    void handleExchangeFixMessage(const FixMessageView &fixMsg, SocketFD senderSocket);
 
     /* 39=1, 150=1 */
-    void handleExchangePartialFill(FixMessage fixMsg, SocketFD senderSocket);
+    void handleExchangePartialFill(const FixMessageView &fixMsg, SocketFD senderSocket);
 
     /* 39=2, 150=2 */
-    void handleExchangeFill(FixMessage fixMsg, SocketFD senderSocket);
+    void handleExchangeFill(const FixMessageView &fixMsg, SocketFD senderSocket);
 
     /* TODO: - handle other exchange states and client cancellation/corrections */
 
@@ -64,6 +68,8 @@ private:
     SocketFD _exchangeSocket{-1};
     SocketFD _databaseSocket{-1};
 
+    bool _binaryInternalLinks{false};
+
     /* TODO: - encapsulate in a struct */
     /* TODO: - use a shared hash map for lower-latency and to make it more lock-free for higher-performance */
     std::shared_mutex _clientSocketMutex;
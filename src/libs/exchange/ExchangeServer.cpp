@@ -9,43 +9,54 @@
 
 #include "ExchangeServer.hpp"
 #include "logger/Logger.hpp"
-#include <chrono>
+
+namespace
+{
+/* Fixed fields of execution reports. Remaining fields copied from the order */
+const FixTemplate partialFillTemplate{{FixTag::MsgType, "8"}, {FixTag::ExecType, "1"}, {FixTag::OrdStatus, "1"}};
+const FixTemplate fillTemplate{{FixTag::MsgType, "8"}, {FixTag::ExecType, "2"}, {FixTag::OrdStatus, "2"}};
+
+/* Order fields replaced in the execution report */
+const std::initializer_list<int> replacedTags{FixTag::MsgType, FixTag::MsgSeqNo, FixTag::ExecType, FixTag::OrdStatus, FixTag::TransactTime, FixTag::SendingTime};
+} // namespace
+
 
 void ExchangeServer::onRegisterMsgTypes()
 {
     FixServer::onRegisterMsgTypes();
 
-    auto handler = [this](FixMessage message, SocketFD socket) -> void
+    auto handler = [this](const FixMessageView &message, SocketFD socket) -> void
     {
-        sendFixMessage(buildPartialFill(message), socket);
-        sendFixMessage(buildFill(message), socket);
+        /* Copies the order's fields => sized from the order. Each send hands the buffer to the queue */
+        FixBuilder builder(message.textLength() + 256);
+
+        buildPartialFill(message, builder);
+        sendFixMessage(builder, socket);
+
+        builder.reset();
+        buildFill(message, builder);
+        sendFixMessage(builder, socket);
     };
 
-    registerMsgTypeHandler("D", handler); /* TODO: - extend for corrections/cancellations (different types) */
+    registerMsgTypeHandler(FixMsgType::NewOrderSingle, handler); /* TODO: - extend for corrections/cancellations (different types) */
 }
 
 
-FixMessage ExchangeServer::buildPartialFill(const FixMessage &clientFix) const
+void ExchangeServer::buildPartialFill(const FixMessageView &clientFix, FixBuilder &builder) const
 {
-    /* Construct 35=AR message */
-    FixMessage ackMessage = clientFix;
-    ackMessage.setTag(FixTag::MsgType, "8");
-    ackMessage.setTag(FixTag::ExecType, "1");
-    ackMessage.setTag(FixTag::OrdStatus, "1");
+    /* Construct 35=8; 150=1; 39=1 message */
+    partialFillTemplate.apply(builder);
+    builder.appendFieldsOf(clientFix, replacedTags);
+    builder.appendTimestamp(FixTag::TransactTime);
     /* TODO: - set remaining tags */
-
-    return ackMessage;
 }
 
 
-FixMessage ExchangeServer::buildFill(const FixMessage &clientFix) const
+void ExchangeServer::buildFill(const FixMessageView &clientFix, FixBuilder &builder) const
 {
-    /* Construct 35=AE message */
-    FixMessage fillMessage = clientFix;
-    fillMessage.setTag(FixTag::MsgType, "8");
-    fillMessage.setTag(FixTag::ExecType, "2"); /* Fill */
-    fillMessage.setTag(FixTag::OrdStatus, "2");
+    /* Construct 35=8; 150=2; 39=2 message */
+    fillTemplate.apply(builder);
+    builder.appendFieldsOf(clientFix, replacedTags);
+    builder.appendTimestamp(FixTag::TransactTime);
     /* TODO: - set remaining tags */
-
-    return fillMessage;
-}
\ No newline at end of file
+}
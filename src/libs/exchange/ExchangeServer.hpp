@@ -8,14 +8,15 @@
  */
 
 #pragma once
-#include "fix/FixMessage.hpp"
+#include "fix/FixBuilder.hpp"
 #include "socket/FixServer.hpp"
+#include <utility>
 
 
 class ExchangeServer : public FixServer
 {
 public:
-    ExchangeServer(uint16_t exchangePort) : FixServer(exchangePort) {}
+    ExchangeServer(SocketAddress exchangeAddress) : FixServer(std::move(exchangeAddress)) {}
 
 protected:
     /* Hooks */
@@ -23,6 +24,6 @@ protected:
 
 private:
     /* Message builders */
-    FixMessage buildPartialFill(const FixMessage &message) const;
-    FixMessage buildFill(const FixMessage &message) const;
+    void buildPartialFill(const FixMessageView &message, FixBuilder &builder) const;
+    void buildFill(const FixMessageView &message, FixBuilder &builder) const;
 };
\ No newline at end of file
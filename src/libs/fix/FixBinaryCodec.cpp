@@ -0,0 +1,390 @@
+/**
+ * @file FixBinaryCodec.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FixBinaryCodec.hpp"
+#include "FixBuilder.hpp"
+#include "FixFrameDecoder.hpp"
+#include "FixKernels.hpp"
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace
+{
+
+/* Presence bits for the fixed block */
+enum Presence : uint16_t
+{
+    HasSide = (1u << 0),
+    HasOrdStatus = (1u << 1),
+    HasExecType = (1u << 2),
+    HasExecTransType = (1u << 3),
+    HasOrderQty = (1u << 4),
+    HasPrice = (1u << 5),
+    HasClOrdID = (1u << 6),
+    HasTransactTime = (1u << 7),
+    HasSendingTime = (1u << 8)
+};
+
+constexpr std::size_t MsgTypeOffset = 2;
+constexpr std::size_t LengthOffset = 4;
+constexpr std::size_t PresenceOffset = 8;
+constexpr std::size_t ChecksumOffset = 10;
+constexpr std::size_t SideOffset = 12;
+constexpr std::size_t OrdStatusOffset = 13;
+constexpr std::size_t ExecTypeOffset = 14;
+constexpr std::size_t ExecTransTypeOffset = 15;
+constexpr std::size_t OrderQtyOffset = 16;
+constexpr std::size_t PriceOffset = 24;
+constexpr std::size_t ClOrdIDOffset = 32;
+constexpr std::size_t TransactTimeOffset = 64;
+constexpr std::size_t SendingTimeOffset = 85;
+
+constexpr std::size_t MaxClOrdIDLength = 31;
+constexpr std::size_t TimestampLength = 21; /* YYYYMMDD-HH:MM:SS.sss */
+
+/* Variable field header: uint16 tag, uint16 length */
+constexpr std::size_t VariableHeaderLength = 4;
+
+/* Single-character fields in the fixed block */
+struct CharField
+{
+    int tag;
+    std::size_t offset;
+    uint16_t bit;
+};
+
+constexpr CharField charFields[] = {{FixTag::Side, SideOffset, HasSide},
+                                    {FixTag::OrdStatus, OrdStatusOffset, HasOrdStatus},
+                                    {FixTag::ExecType, ExecTypeOffset, HasExecType},
+                                    {FixTag::ExecTransType, ExecTransTypeOffset, HasExecTransType}};
+
+
+template <typename T>
+inline void storeLE(char *buffer, T value)
+{
+    auto bits = static_cast<std::make_unsigned_t<T>>(value);
+
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        buffer[i] = static_cast<char>(bits & 0xFF);
+        bits = static_cast<std::make_unsigned_t<T>>(bits >> 8);
+    }
+}
+
+
+template <typename T>
+inline T loadLE(const char *buffer)
+{
+    std::make_unsigned_t<T> bits = 0;
+
+    for (std::size_t i = sizeof(T); i-- > 0;)
+    {
+        bits = static_cast<std::make_unsigned_t<T>>((bits << 8) | static_cast<uint8_t>(buffer[i]));
+    }
+
+    return static_cast<T>(bits);
+}
+
+
+/* Copy value into a fixed-width slot if it fits. Returns false if it belongs in the variable section */
+bool placeFixed(char *block, uint16_t &presence, int tag, std::string_view value)
+{
+    char buffer[FixCodec::MaxEncodedLength];
+
+    for (const CharField &field : charFields)
+    {
+        if (field.tag == tag)
+        {
+            if ((presence & field.bit) || value.size() != 1)
+                return false;
+
+            block[field.offset] = value[0];
+            presence |= field.bit;
+            return true;
+        }
+    }
+
+    switch (tag)
+    {
+        case FixTag::OrderQty:
+        {
+            int64_t qty = FixCodec::parseInt(value);
+            if ((presence & HasOrderQty) || FixCodec::formatInt(qty, buffer) != value)
+                return false;
+
+            storeLE(block + OrderQtyOffset, qty);
+            presence |= HasOrderQty;
+            return true;
+        }
+        case FixTag::Price:
+        {
+            FixPrice price = FixCodec::parsePrice(value);
+            if ((presence & HasPrice) || FixCodec::formatPrice(price, buffer) != value)
+                return false;
+
+            storeLE(block + PriceOffset, price.mantissa);
+            presence |= HasPrice;
+            return true;
+        }
+        case FixTag::ClOrdID:
+        {
+            if ((presence & HasClOrdID) || value.size() > MaxClOrdIDLength)
+                return false;
+
+            block[ClOrdIDOffset] = static_cast<char>(value.size());
+            value.copy(block + ClOrdIDOffset + 1, value.size());
+            presence |= HasClOrdID;
+            return true;
+        }
+        case FixTag::TransactTime:
+        case FixTag::SendingTime:
+        {
+            uint16_t bit = (tag == FixTag::TransactTime ? HasTransactTime : HasSendingTime);
+            std::size_t offset = (tag == FixTag::TransactTime ? TransactTimeOffset : SendingTimeOffset);
+
+            if ((presence & bit) || value.size() != TimestampLength)
+                return false;
+
+            value.copy(block + offset, TimestampLength);
+            presence |= bit;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+
+/* Sum of the frame's bytes excluding the checksum itself */
+uint16_t checksumOf(std::string_view frame)
+{
+    const char *begin = frame.data();
+    return static_cast<uint16_t>(FixKernels::sum(begin, begin + ChecksumOffset) + FixKernels::sum(begin + ChecksumOffset + 2, begin + frame.size()));
+}
+
+} // namespace
+
+
+uint32_t FixBinaryCodec::frameLength(std::string_view header)
+{
+    return loadLE<uint32_t>(header.data() + LengthOffset);
+}
+
+
+FixMsgType FixBinaryCodec::msgType(std::string_view header)
+{
+    return static_cast<FixMsgType>(loadLE<uint16_t>(header.data() + MsgTypeOffset));
+}
+
+
+std::string FixBinaryCodec::encode(const FixMessageView &message)
+{
+    std::string frame(BlockLength, '\0');
+    frame.reserve(BlockLength + message.toStringView().size());
+
+    uint16_t msgType = 0;
+    uint16_t presence = 0;
+
+    for (std::size_t i = 0; i < message.size(); ++i)
+    {
+        FixMessageView::Tag tag = message.tagAt(i);
+        FixMessageView::Value value = message.valueAt(i);
+
+        if (tag == 8 || tag == 9 || tag == 10)
+        {
+            continue; /* Framing replaced by binary header */
+        }
+        else if (tag == FixTag::MsgType && msgType == 0 && FixCodec::parseMsgType(value) != FixMsgType::Unknown)
+        {
+            msgType = static_cast<uint16_t>(FixCodec::parseMsgType(value));
+            continue;
+        }
+        else if (placeFixed(frame.data(), presence, tag, value))
+        {
+            continue;
+        }
+
+        if (tag < 0 || tag > 0xFFFF || value.size() > 0xFFFF)
+        {
+            throw std::length_error("tag/value cannot be binary encoded");
+        }
+
+        char fieldHeader[VariableHeaderLength];
+        storeLE(fieldHeader, static_cast<uint16_t>(tag));
+        storeLE(fieldHeader + 2, static_cast<uint16_t>(value.size()));
+
+        frame.append(fieldHeader, VariableHeaderLength).append(value);
+    }
+
+    if (frame.size() > FixFrameDecoder::MaxBodyLength)
+    {
+        throw std::length_error("binary frame too large");
+    }
+
+    frame[0] = static_cast<char>(Magic);
+    frame[1] = static_cast<char>(Version);
+    storeLE(frame.data() + MsgTypeOffset, msgType);
+    storeLE(frame.data() + LengthOffset, static_cast<uint32_t>(frame.size()));
+    storeLE(frame.data() + PresenceOffset, presence);
+    storeLE(frame.data() + ChecksumOffset, checksumOf(frame));
+
+    return frame;
+}
+
+
+bool FixBinaryCodec::verify(std::string_view frame)
+{
+    return (frame.size() >= BlockLength && loadLE<uint16_t>(frame.data() + ChecksumOffset) == checksumOf(frame));
+}
+
+
+FixMessageView FixBinaryCodec::parse(std::string_view frame)
+{
+    if (frame.size() < BlockLength || !isBinary(frame) || static_cast<uint8_t>(frame[1]) != Version || frameLength(frame) != frame.size())
+    {
+        throw std::runtime_error("malformed binary frame header");
+    }
+
+    const char *block = frame.data();
+    uint16_t presence = loadLE<uint16_t>(block + PresenceOffset);
+
+    FixMessageView view;
+    view._message = frame;
+    view._binary = true;
+
+    uint32_t nScratch = 0;
+
+    /* Formatted value goes in the view's scratch buffer */
+    auto addFormatted = [&view, &nScratch](int tag, auto value, auto format)
+    {
+        std::string_view encoded = format(value, view._scratch.data() + nScratch);
+        view.addField(FixMessageView::Field{tag, nScratch | FixMessageView::ScratchBit, static_cast<uint32_t>(encoded.size())});
+        nScratch += static_cast<uint32_t>(encoded.size());
+    };
+
+    auto addFrameValue = [&view](int tag, std::size_t offset, std::size_t length)
+    {
+        view.addField(FixMessageView::Field{tag, static_cast<uint32_t>(offset), static_cast<uint32_t>(length)});
+    };
+
+    if (auto msgType = loadLE<uint16_t>(block + MsgTypeOffset); msgType != 0)
+        addFormatted(FixTag::MsgType, static_cast<FixMsgType>(msgType), FixCodec::formatMsgType);
+
+    for (const CharField &field : charFields)
+    {
+        if (presence & field.bit)
+            addFrameValue(field.tag, field.offset, 1);
+    }
+
+    if (presence & HasOrderQty)
+        addFormatted(FixTag::OrderQty, loadLE<int64_t>(block + OrderQtyOffset), FixCodec::formatInt);
+
+    if (presence & HasPrice)
+        addFormatted(FixTag::Price, FixPrice{loadLE<int64_t>(block + PriceOffset)}, FixCodec::formatPrice);
+
+    if (presence & HasClOrdID)
+    {
+        std::size_t length = static_cast<uint8_t>(block[ClOrdIDOffset]);
+        if (length > MaxClOrdIDLength)
+        {
+            throw std::runtime_error("malformed binary ClOrdID");
+        }
+
+        addFrameValue(FixTag::ClOrdID, ClOrdIDOffset + 1, length);
+    }
+
+    if (presence & HasTransactTime)
+        addFrameValue(FixTag::TransactTime, TransactTimeOffset, TimestampLength);
+
+    if (presence & HasSendingTime)
+        addFrameValue(FixTag::SendingTime, SendingTimeOffset, TimestampLength);
+
+    /* Variable fields */
+    for (std::size_t iCurr = BlockLength; iCurr < frame.size();)
+    {
+        if (frame.size() - iCurr < VariableHeaderLength)
+        {
+            throw std::runtime_error("truncated binary field header");
+        }
+
+        auto tag = loadLE<uint16_t>(block + iCurr);
+        auto length = loadLE<uint16_t>(block + iCurr + 2);
+        iCurr += VariableHeaderLength;
+
+        if (frame.size() - iCurr < length)
+        {
+            throw std::runtime_error("truncated binary field value");
+        }
+
+        addFrameValue(tag, iCurr, length);
+        iCurr += length;
+    }
+
+    return view;
+}
+
+
+std::string FixBinaryCodec::decode(std::string_view frame)
+{
+    FixMessageView view = parse(frame);
+
+    std::string text(view.textLength() + FixBuilder::HeaderReserve + FixBuilder::TrailerLength, '\0');
+    FixBuilder builder(text.data(), text.size());
+
+    builder.appendFieldsOf(view);
+
+    std::string_view encoded = builder.finish();
+
+    /* Header was written right-aligned in front of the body => shift to start of string */
+    std::size_t offset = static_cast<std::size_t>(encoded.data() - text.data());
+    std::size_t length = encoded.size();
+
+    text.erase(0, offset);
+    text.resize(length);
+    return text;
+}
+
+
+std::string_view FixBinaryCodec::findValue(std::string_view frame, int tag)
+{
+    if (frame.size() < BlockLength || !isBinary(frame))
+    {
+        return std::string_view();
+    }
+
+    const char *block = frame.data();
+
+    if (tag == FixTag::ClOrdID && (loadLE<uint16_t>(block + PresenceOffset) & HasClOrdID))
+    {
+        std::size_t length = static_cast<uint8_t>(block[ClOrdIDOffset]);
+        return (length <= MaxClOrdIDLength ? std::string_view(block + ClOrdIDOffset + 1, length) : std::string_view());
+    }
+
+    for (std::size_t iCurr = BlockLength; frame.size() - iCurr >= VariableHeaderLength;)
+    {
+        auto fieldTag = loadLE<uint16_t>(block + iCurr);
+        auto length = loadLE<uint16_t>(block + iCurr + 2);
+        iCurr += VariableHeaderLength;
+
+        if (frame.size() - iCurr < length)
+        {
+            break;
+        }
+
+        if (fieldTag == tag)
+        {
+            return frame.substr(iCurr, length);
+        }
+
+        iCurr += length;
+    }
+
+    return std::string_view();
+}
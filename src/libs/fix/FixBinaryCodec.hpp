@@ -0,0 +1,76 @@
+/**
+ * @file FixBinaryCodec.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "FixDictionary.hpp"
+#include "FixMessageView.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+
+/**
+ * Compact SBE-style binary encoding for internal links (engine <--> exchange/database).
+ *
+ * Frame layout (little-endian integers):
+ *
+ *   0   uint8   Magic (0xFB: cannot start a text frame)
+ *   1   uint8   Version
+ *   2   uint16  MsgType (packed as FixMsgType)
+ *   4   uint32  Frame length (including header)
+ *   8   uint16  Presence bitmap for the fixed block
+ *   10  uint16  Checksum: sum of every other byte in the frame (mod 2^16)
+ *   12  char    Side, OrdStatus, ExecType, ExecTransType
+ *   16  int64   OrderQty
+ *   24  int64   Price (FixPrice mantissa)
+ *   32  uint8   ClOrdID length, followed by up to 31 characters
+ *   64  char    TransactTime[21], SendingTime[21] (millisecond UTCTimestamp)
+ *   112         Variable fields: { uint16 tag, uint16 length, value }...
+ *
+ * A value is only placed in the fixed block if it reproduces the original text exactly. Anything
+ * else goes in the variable section, so decode(encode(message)) preserves every value.
+ */
+class FixBinaryCodec
+{
+public:
+    static constexpr uint8_t Magic = 0xFB;
+    static constexpr uint8_t Version = 2;
+
+    static constexpr std::size_t HeaderLength = 8;
+    static constexpr std::size_t BlockLength = 112;
+
+    /* Returns true if the message starts with a binary frame header */
+    [[nodiscard]] static inline bool isBinary(std::string_view message)
+    {
+        return (!message.empty() && static_cast<uint8_t>(message[0]) == Magic);
+    }
+
+    /* Frame length from a header (at least HeaderLength bytes) */
+    [[nodiscard]] static uint32_t frameLength(std::string_view header);
+
+    /* MsgType from a header (at least HeaderLength bytes) */
+    [[nodiscard]] static FixMsgType msgType(std::string_view header);
+
+    /* Encode a text message. Throws std::length_error if a tag/value cannot be represented */
+    [[nodiscard]] static std::string encode(const FixMessageView &message);
+
+    /* Returns true if a complete frame's checksum matches its contents */
+    [[nodiscard]] static bool verify(std::string_view frame);
+
+    /* Index a binary frame without converting it to text. The frame must outlive the view. Throws
+     * std::runtime_error if malformed */
+    [[nodiscard]] static FixMessageView parse(std::string_view frame);
+
+    /* Decode a binary frame into a complete text message. Throws std::runtime_error if malformed */
+    [[nodiscard]] static std::string decode(std::string_view frame);
+
+    /* Value of ClOrdID or a variable-section field without decoding. Empty if not present or malformed */
+    [[nodiscard]] static std::string_view findValue(std::string_view frame, int tag);
+};
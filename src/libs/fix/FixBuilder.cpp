@@ -0,0 +1,218 @@
+/**
+ * @file FixBuilder.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FixBuilder.hpp"
+#include "FixKernels.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace
+{
+constexpr std::string_view BeginString{"8=FIX.4.4;9="};
+} // namespace
+
+
+FixBuilder::FixBuilder(char *buffer, std::size_t capacity) : _buffer(buffer), _capacity(capacity)
+{
+    if (capacity < HeaderReserve + TrailerLength)
+    {
+        throw std::length_error("FIX builder buffer too small");
+    }
+}
+
+
+FixBuilder::FixBuilder(std::size_t capacity)
+    : _ownedBuffer(std::max(capacity, HeaderReserve + TrailerLength), '\0'), _owned(true), _buffer(_ownedBuffer.data()), _capacity(_ownedBuffer.size())
+{
+}
+
+
+char *FixBuilder::reserve(std::size_t n)
+{
+    if (_end + n + TrailerLength > _capacity)
+    {
+        throw std::length_error("FIX builder buffer exhausted");
+    }
+
+    char *iWrite = _buffer + _end;
+    _end += n;
+    return iWrite;
+}
+
+
+FixBuilder &FixBuilder::append(Tag tag, std::string_view value)
+{
+    char tagBuffer[16];
+    auto tagResult = std::to_chars(tagBuffer, tagBuffer + sizeof(tagBuffer), tag);
+    std::size_t tagLength = tagResult.ptr - tagBuffer;
+
+    char *iWrite = reserve(tagLength + value.size() + 2);
+
+    std::memcpy(iWrite, tagBuffer, tagLength);
+    iWrite[tagLength] = '=';
+    std::memcpy(iWrite + tagLength + 1, value.data(), value.size());
+    iWrite[tagLength + 1 + value.size()] = ';';
+
+    return *this;
+}
+
+
+FixBuilder &FixBuilder::appendTimestamp(Tag tag, Clock::Precision precision)
+{
+    char timestamp[Clock::MaxFormattedLength];
+    return append(tag, std::string_view(timestamp, Clock::formatUTC(timestamp, precision)));
+}
+
+
+FixBuilder &FixBuilder::appendEncoded(std::string_view fields)
+{
+    std::memcpy(reserve(fields.size()), fields.data(), fields.size());
+    return *this;
+}
+
+
+FixBuilder &FixBuilder::appendFieldsOf(const FixMessageView &message, std::initializer_list<Tag> exclude)
+{
+    if (message.isBinary()) /* No raw-FIX runs to copy */
+    {
+        for (std::size_t i = 0; i < message.size(); ++i)
+        {
+            if (std::find(exclude.begin(), exclude.end(), message.tagAt(i)) == exclude.end())
+                append(message.tagAt(i), message.valueAt(i));
+        }
+
+        return *this;
+    }
+
+    std::string_view raw = message.toStringView();
+
+    /* Start/end offsets of the current run of fields to copy */
+    std::size_t runBegin = 0;
+    std::size_t runEnd = 0;
+
+    auto flushRun = [&]()
+    {
+        if (runEnd > runBegin)
+            appendEncoded(raw.substr(runBegin, runEnd - runBegin));
+
+        runBegin = runEnd = 0;
+    };
+
+    for (std::size_t i = 0; i < message.size(); ++i)
+    {
+        Tag tag = message.tagAt(i);
+        std::string_view value = message.valueAt(i);
+
+        /* Field "tag=value;" ends one past the value. Find its start by walking back over the tag */
+        std::size_t fieldEnd = static_cast<std::size_t>(value.data() - raw.data()) + value.size() + 1;
+        std::size_t fieldBegin = static_cast<std::size_t>(value.data() - raw.data()) - 1;
+        while (fieldBegin > 0 && raw[fieldBegin - 1] >= '0' && raw[fieldBegin - 1] <= '9')
+        {
+            --fieldBegin;
+        }
+
+        bool skip = (tag == 8 || tag == 9 || tag == 10 || std::find(exclude.begin(), exclude.end(), tag) != exclude.end());
+
+        if (skip)
+        {
+            flushRun();
+        }
+        else if (runEnd == fieldBegin && runEnd != 0)
+        {
+            runEnd = fieldEnd; /* Extend current run */
+        }
+        else
+        {
+            flushRun();
+            runBegin = fieldBegin;
+            runEnd = fieldEnd;
+        }
+    }
+
+    flushRun();
+    return *this;
+}
+
+
+std::string_view FixBuilder::finish()
+{
+    std::size_t bodyLength = _end - HeaderReserve;
+
+    /* Header: written right-aligned immediately before the body */
+    char lengthBuffer[16];
+    auto lengthResult = std::to_chars(lengthBuffer, lengthBuffer + sizeof(lengthBuffer), bodyLength);
+    std::size_t lengthDigits = lengthResult.ptr - lengthBuffer;
+
+    std::size_t headerLength = BeginString.size() + lengthDigits + 1;
+    if (headerLength > HeaderReserve)
+    {
+        throw std::length_error("FIX body too large");
+    }
+
+    char *header = _buffer + HeaderReserve - headerLength;
+    std::memcpy(header, BeginString.data(), BeginString.size());
+    std::memcpy(header + BeginString.size(), lengthBuffer, lengthDigits);
+    header[headerLength - 1] = ';';
+
+    /* Trailer: 10=xxx; */
+    unsigned int checksum = FixKernels::checksum(header, _buffer + _end);
+
+    char *trailer = _buffer + _end;
+    trailer[0] = '1';
+    trailer[1] = '0';
+    trailer[2] = '=';
+    trailer[3] = static_cast<char>('0' + checksum / 100);
+    trailer[4] = static_cast<char>('0' + (checksum / 10) % 10);
+    trailer[5] = static_cast<char>('0' + checksum % 10);
+    trailer[6] = ';';
+
+    return std::string_view(header, headerLength + bodyLength + TrailerLength);
+}
+
+
+std::string FixBuilder::release()
+{
+    std::string_view message = finish();
+
+    if (!_owned)
+    {
+        return std::string(message);
+    }
+
+    std::size_t offset = static_cast<std::size_t>(message.data() - _buffer);
+    _ownedBuffer.resize(offset + message.size());
+    _ownedBuffer.erase(0, offset);
+
+    _buffer = nullptr;
+    return std::move(_ownedBuffer);
+}
+
+
+void FixBuilder::reset()
+{
+    if (_owned && _buffer == nullptr) /* Released */
+    {
+        _ownedBuffer.assign(_capacity, '\0');
+        _buffer = _ownedBuffer.data();
+    }
+
+    _end = HeaderReserve;
+}
+
+
+FixTemplate::FixTemplate(std::initializer_list<std::pair<Tag, std::string_view>> fixedFields)
+{
+    for (auto &[tag, value] : fixedFields)
+    {
+        _encoded.append(std::to_string(tag)).append("=").append(value).append(";");
+    }
+}
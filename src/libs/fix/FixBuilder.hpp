@@ -0,0 +1,111 @@
+/**
+ * @file FixBuilder.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "FixDictionary.hpp"
+#include "FixMessageView.hpp"
+#include "utilities/Clock.hpp"
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+
+
+/**
+ * Writes tag/value pairs straight into a preallocated or caller-owned buffer.
+ *
+ * Space for the header is reserved at the front of the buffer so finish() can write BodyLength
+ * immediately before the body without moving it. Throws std::length_error if the buffer is full.
+ * A builder-owned buffer can be handed over with release() rather than copied.
+ */
+class FixBuilder
+{
+public:
+    using Tag = int;
+
+    /* 8=FIX.4.4;9=<up to 7 digits>; */
+    static constexpr std::size_t HeaderReserve = 20;
+    static constexpr std::size_t TrailerLength = 7;
+
+    /* Caller-owned buffer */
+    FixBuilder(char *buffer, std::size_t capacity);
+
+    /* Builder-owned buffer. Size it from the input when fields are copied from an inbound message */
+    explicit FixBuilder(std::size_t capacity);
+
+    FixBuilder(const FixBuilder &) = delete;
+    FixBuilder &operator=(const FixBuilder &) = delete;
+
+    /* Append a tag/value pair */
+    FixBuilder &append(Tag tag, std::string_view value);
+
+    /* Append a typed tag/value pair from the FIX dictionary */
+    template <FixTag Tag>
+    FixBuilder &set(typename FixField<Tag>::Type value)
+    {
+        char buffer[FixCodec::MaxEncodedLength];
+        return append(Tag, FixField<Tag>::format(value, buffer));
+    }
+
+    /* Append the current UTC time */
+    FixBuilder &appendTimestamp(Tag tag, Clock::Precision precision = Clock::Milliseconds);
+
+    /* Append pre-encoded "tag=value;..." pairs */
+    FixBuilder &appendEncoded(std::string_view fields);
+
+    /* Copy all body fields of a message except those excluded. Contiguous fields are copied together */
+    FixBuilder &appendFieldsOf(const FixMessageView &message, std::initializer_list<Tag> exclude = {});
+
+    /* Writes header and trailer. Returns the complete message (valid until builder is reset/destroyed) */
+    std::string_view finish();
+
+    /* finish() and return the message. A builder-owned buffer is moved out (the header shifts to
+     * the front in place): reset() allocates a new one. Caller-owned buffers are copied */
+    std::string release();
+
+    /* Discard body to reuse the buffer */
+    void reset();
+
+    /* Body encoded so far */
+    [[nodiscard]] inline std::string_view body() const { return std::string_view(_buffer + HeaderReserve, _end - HeaderReserve); }
+
+private:
+    /* Reserve n bytes at end of body. Returns write position */
+    char *reserve(std::size_t n);
+
+    std::string _ownedBuffer; /* Empty if caller-owned or released */
+    bool _owned{false};
+    char *_buffer;
+    std::size_t _capacity;
+    std::size_t _end{HeaderReserve};
+};
+
+
+/**
+ * Precompiled message template: fixed fields are encoded once. Variable slots are appended per send.
+ *
+ * FixTemplate newOrder({{FixTag::MsgType, "D"}, {FixTag::Currency, "GBP"}});
+ * newOrder.apply(builder).append(FixTag::ClOrdID, clOrdID).appendTimestamp(FixTag::TransactTime);
+ */
+class FixTemplate
+{
+public:
+    using Tag = int;
+
+    FixTemplate(std::initializer_list<std::pair<Tag, std::string_view>> fixedFields);
+
+    /* Writes the fixed fields */
+    inline FixBuilder &apply(FixBuilder &builder) const { return builder.appendEncoded(_encoded); }
+
+    [[nodiscard]] inline std::string_view encoded() const { return _encoded; }
+
+private:
+    std::string _encoded;
+};
@@ -0,0 +1,290 @@
+/**
+ * @file FixDictionary.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "FixTag.hpp"
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+
+
+/* MsgType (35). One or two characters packed into an integer for switch statements */
+enum class FixMsgType : uint16_t
+{
+    Unknown = 0,
+    ExecutionReport = '8',
+    NewOrderSingle = 'D',
+    Logon = 'A',
+    ResendRequest = '2',
+    SequenceReset = '4',
+    AdminRequest = ('Q' << 8) | 'R' /* QR: netadmin command/response */
+};
+
+/* Side (54) */
+enum class FixSide : char
+{
+    Unknown = '\0',
+    Buy = '1',
+    Sell = '2'
+};
+
+/* OrdStatus (39) */
+enum class FixOrdStatus : char
+{
+    Unknown = '\0',
+    New = '0',
+    PartiallyFilled = '1',
+    Filled = '2',
+    Cancelled = '4',
+    Rejected = '8'
+};
+
+/* ExecType (150) */
+enum class FixExecType : char
+{
+    Unknown = '\0',
+    New = '0',
+    PartialFill = '1',
+    Fill = '2',
+    Cancelled = '4',
+    Rejected = '8'
+};
+
+/* ExecTransType (20) */
+enum class FixExecTransType : char
+{
+    Unknown = '\0',
+    New = '0',
+    Cancel = '1',
+    Correct = '2',
+    Status = '3'
+};
+
+/* Quantities are whole numbers of shares */
+using FixQty = int64_t;
+
+
+/* Fixed-point price with 8 decimal places */
+struct FixPrice
+{
+    static constexpr int Decimals = 8;
+    static constexpr int64_t Scale = 100000000;
+
+    int64_t mantissa{0};
+
+    static constexpr FixPrice fromDouble(double value) { return FixPrice{static_cast<int64_t>(value * Scale + (value < 0 ? -0.5 : 0.5))}; }
+
+    constexpr double toDouble() const { return static_cast<double>(mantissa) / Scale; }
+
+    constexpr bool operator==(FixPrice other) const { return mantissa == other.mantissa; }
+    constexpr bool operator!=(FixPrice other) const { return mantissa != other.mantissa; }
+    constexpr bool operator<(FixPrice other) const { return mantissa < other.mantissa; }
+};
+
+
+namespace FixCodec
+{
+
+/* Maximum encoded length of any typed value (excluding strings) */
+constexpr std::size_t MaxEncodedLength = 32;
+
+constexpr FixMsgType parseMsgType(std::string_view value)
+{
+    switch (value.size())
+    {
+        case 1:
+            return static_cast<FixMsgType>(static_cast<unsigned char>(value[0]));
+        case 2:
+            return static_cast<FixMsgType>((static_cast<unsigned char>(value[0]) << 8) | static_cast<unsigned char>(value[1]));
+        default:
+            return FixMsgType::Unknown;
+    }
+}
+
+inline std::string_view formatMsgType(FixMsgType msgType, char *buffer)
+{
+    auto code = static_cast<uint16_t>(msgType);
+
+    if (code > 0xFF)
+    {
+        buffer[0] = static_cast<char>(code >> 8);
+        buffer[1] = static_cast<char>(code & 0xFF);
+        return std::string_view(buffer, 2);
+    }
+
+    buffer[0] = static_cast<char>(code);
+    return std::string_view(buffer, 1);
+}
+
+template <typename Enum>
+constexpr Enum parseChar(std::string_view value)
+{
+    return (value.size() == 1 ? static_cast<Enum>(value[0]) : Enum::Unknown);
+}
+
+template <typename Enum>
+inline std::string_view formatChar(Enum value, char *buffer)
+{
+    buffer[0] = static_cast<char>(value);
+    return std::string_view(buffer, 1);
+}
+
+/* Returns 0 if not a valid integer */
+inline int64_t parseInt(std::string_view value)
+{
+    int64_t result = 0;
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+    return (ec == std::errc() && ptr == value.data() + value.size()) ? result : 0;
+}
+
+inline std::string_view formatInt(int64_t value, char *buffer)
+{
+    auto [ptr, ec] = std::to_chars(buffer, buffer + MaxEncodedLength, value);
+    return std::string_view(buffer, ptr - buffer);
+}
+
+/* Parses [-]digits[.digits]. Digits beyond 8 decimal places are truncated. Returns 0 if invalid or
+ * too large for the scaled mantissa */
+inline FixPrice parsePrice(std::string_view value)
+{
+    const char *iCurr = value.data();
+    const char *end = iCurr + value.size();
+
+    bool negative = (iCurr != end && *iCurr == '-');
+    if (negative)
+        ++iCurr;
+
+    int64_t mantissa = 0;
+    int decimals = -1; /* Number of digits after decimal point (-1 => no point) */
+
+    for (; iCurr != end; ++iCurr)
+    {
+        if (*iCurr == '.' && decimals < 0)
+        {
+            decimals = 0;
+        }
+        else if (*iCurr >= '0' && *iCurr <= '9')
+        {
+            if (decimals == FixPrice::Decimals)
+                continue;
+
+            if (__builtin_mul_overflow(mantissa, 10, &mantissa) || __builtin_add_overflow(mantissa, *iCurr - '0', &mantissa))
+                return FixPrice{};
+
+            if (decimals >= 0)
+                ++decimals;
+        }
+        else
+        {
+            return FixPrice{};
+        }
+    }
+
+    for (int i = (decimals < 0 ? 0 : decimals); i < FixPrice::Decimals; ++i)
+    {
+        if (__builtin_mul_overflow(mantissa, 10, &mantissa))
+            return FixPrice{};
+    }
+
+    return FixPrice{negative ? -mantissa : mantissa};
+}
+
+/* Formats with at least 2 decimal places and no trailing zeros beyond that */
+inline std::string_view formatPrice(FixPrice price, char *buffer)
+{
+    char *iCurr = buffer;
+    uint64_t mantissa = static_cast<uint64_t>(price.mantissa);
+
+    if (price.mantissa < 0)
+    {
+        *iCurr++ = '-';
+        mantissa = 0 - mantissa;
+    }
+
+    iCurr = std::to_chars(iCurr, buffer + MaxEncodedLength, mantissa / FixPrice::Scale).ptr;
+    *iCurr++ = '.';
+
+    uint64_t fraction = mantissa % FixPrice::Scale;
+    uint64_t divisor = FixPrice::Scale / 10;
+
+    for (int i = 0; i < FixPrice::Decimals && (i < 2 || fraction != 0); ++i)
+    {
+        *iCurr++ = static_cast<char>('0' + fraction / divisor);
+        fraction %= divisor;
+        divisor /= 10;
+    }
+
+    return std::string_view(buffer, iCurr - buffer);
+}
+
+} // namespace FixCodec
+
+
+/**
+ * Compile-time FIX dictionary: maps each FixTag to its value type.
+ *
+ * Using a tag without a dictionary entry in msg.get<Tag>() is a compile error.
+ */
+template <FixTag Tag>
+struct FixField
+{
+    static_assert(Tag != Tag, "FixTag has no typed entry in the FIX dictionary");
+};
+
+
+#define TALOS_FIX_STRING_FIELD(TAG)                                                                         \
+    template <>                                                                                             \
+    struct FixField<TAG>                                                                                    \
+    {                                                                                                       \
+        using Type = std::string_view;                                                                      \
+        static constexpr Type parse(std::string_view value) { return value; }                               \
+        static std::string_view format(Type value, char *) { return value; }                                \
+    };
+
+#define TALOS_FIX_TYPED_FIELD(TAG, TYPE, PARSE, FORMAT)                                                     \
+    template <>                                                                                             \
+    struct FixField<TAG>                                                                                    \
+    {                                                                                                       \
+        using Type = TYPE;                                                                                  \
+        static Type parse(std::string_view value) { return PARSE(value); }                                  \
+        static std::string_view format(Type value, char *buffer) { return FORMAT(value, buffer); }          \
+    };
+
+TALOS_FIX_STRING_FIELD(FixTag::ClOrdID)
+TALOS_FIX_STRING_FIELD(FixTag::Currency)
+TALOS_FIX_STRING_FIELD(FixTag::ExecID)
+TALOS_FIX_STRING_FIELD(FixTag::OrigClOrdID)
+TALOS_FIX_STRING_FIELD(FixTag::IDSource)
+TALOS_FIX_STRING_FIELD(FixTag::SecurityID)
+TALOS_FIX_STRING_FIELD(FixTag::SendingTime)
+TALOS_FIX_STRING_FIELD(FixTag::TransactTime)
+TALOS_FIX_STRING_FIELD(FixTag::SenderCompID)
+TALOS_FIX_STRING_FIELD(FixTag::SenderSubID)
+TALOS_FIX_STRING_FIELD(FixTag::AdminCommand)
+TALOS_FIX_STRING_FIELD(FixTag::AdminResponse)
+TALOS_FIX_STRING_FIELD(FixTag::WireEncoding)
+TALOS_FIX_STRING_FIELD(FixTag::Trace)
+TALOS_FIX_STRING_FIELD(FixTag::GapFillFlag)
+TALOS_FIX_STRING_FIELD(FixTag::PossDupFlag)
+TALOS_FIX_STRING_FIELD(FixTag::OrigSendingTime)
+
+TALOS_FIX_TYPED_FIELD(FixTag::MsgType, FixMsgType, FixCodec::parseMsgType, FixCodec::formatMsgType)
+TALOS_FIX_TYPED_FIELD(FixTag::MsgSeqNo, int64_t, FixCodec::parseInt, FixCodec::formatInt)
+TALOS_FIX_TYPED_FIELD(FixTag::BeginSeqNo, int64_t, FixCodec::parseInt, FixCodec::formatInt)
+TALOS_FIX_TYPED_FIELD(FixTag::EndSeqNo, int64_t, FixCodec::parseInt, FixCodec::formatInt)
+TALOS_FIX_TYPED_FIELD(FixTag::NewSeqNo, int64_t, FixCodec::parseInt, FixCodec::formatInt)
+TALOS_FIX_TYPED_FIELD(FixTag::OrderQty, FixQty, FixCodec::parseInt, FixCodec::formatInt)
+TALOS_FIX_TYPED_FIELD(FixTag::Price, FixPrice, FixCodec::parsePrice, FixCodec::formatPrice)
+TALOS_FIX_TYPED_FIELD(FixTag::Side, FixSide, FixCodec::parseChar<FixSide>, FixCodec::formatChar<FixSide>)
+TALOS_FIX_TYPED_FIELD(FixTag::OrdStatus, FixOrdStatus, FixCodec::parseChar<FixOrdStatus>, FixCodec::formatChar<FixOrdStatus>)
+TALOS_FIX_TYPED_FIELD(FixTag::ExecType, FixExecType, FixCodec::parseChar<FixExecType>, FixCodec::formatChar<FixExecType>)
+TALOS_FIX_TYPED_FIELD(FixTag::ExecTransType, FixExecTransType, FixCodec::parseChar<FixExecTransType>, FixCodec::formatChar<FixExecTransType>)
+
+#undef TALOS_FIX_STRING_FIELD
+#undef TALOS_FIX_TYPED_FIELD
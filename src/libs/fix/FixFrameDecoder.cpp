@@ -0,0 +1,145 @@
+/**
+ * @file FixFrameDecoder.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FixFrameDecoder.hpp"
+#include "FixBinaryCodec.hpp"
+#include "FixKernels.hpp"
+#include <algorithm>
+
+
+namespace
+{
+constexpr std::string_view BeginString{"8=FIX.4.4;9="};
+constexpr std::string_view CheckSumTag{"10="};
+constexpr std::size_t TrailerLength = 7; /* 10=xxx; */
+} // namespace
+
+
+FixFrameDecoder::Result FixFrameDecoder::decode(std::string_view buffer)
+{
+    if (FixBinaryCodec::isBinary(buffer))
+    {
+        return decodeBinary(buffer);
+    }
+
+    /* Header: 8=FIX.4.4;9= */
+    std::size_t nCompare = std::min(buffer.size(), BeginString.size());
+
+    if (buffer.compare(0, nCompare, BeginString, 0, nCompare) != 0)
+    {
+        return Result{Corrupt, resync(buffer)};
+    }
+    else if (nCompare < BeginString.size())
+    {
+        return Result{Incomplete, 0};
+    }
+
+    /* BodyLength: digits up to ';' */
+    std::size_t bodyLength = 0;
+    std::size_t iCurr = BeginString.size();
+
+    for (; iCurr < buffer.size() && buffer[iCurr] != ';'; ++iCurr)
+    {
+        char c = buffer[iCurr];
+
+        if (c < '0' || c > '9' || bodyLength > MaxBodyLength)
+        {
+            return Result{Corrupt, resync(buffer)};
+        }
+
+        bodyLength = (bodyLength * 10) + (c - '0');
+    }
+
+    if (iCurr == buffer.size())
+    {
+        return Result{Incomplete, 0};
+    }
+    else if (iCurr == BeginString.size() || bodyLength > MaxBodyLength)
+    {
+        return Result{Corrupt, resync(buffer)};
+    }
+
+    /* Body + trailer: 10=xxx; */
+    std::size_t iTrailer = iCurr + 1 + bodyLength;
+    std::size_t frameLength = iTrailer + TrailerLength;
+
+    if (buffer.size() < frameLength)
+    {
+        return Result{Incomplete, 0};
+    }
+
+    if (buffer.compare(iTrailer, CheckSumTag.size(), CheckSumTag) != 0 || buffer[frameLength - 1] != ';')
+    {
+        return Result{Corrupt, resync(buffer)};
+    }
+
+    /* CheckSum: 3 digits; sum of all bytes prior to the trailer */
+    unsigned int expected = 0;
+
+    for (std::size_t i = iTrailer + CheckSumTag.size(); i < frameLength - 1; ++i)
+    {
+        char c = buffer[i];
+
+        if (c < '0' || c > '9')
+        {
+            return Result{Invalid, frameLength};
+        }
+
+        expected = (expected * 10) + (c - '0');
+    }
+
+    if (FixKernels::checksum(buffer.data(), buffer.data() + iTrailer) != expected)
+    {
+        return Result{Invalid, frameLength};
+    }
+
+    return Result{Complete, frameLength};
+}
+
+
+FixFrameDecoder::Result FixFrameDecoder::decodeBinary(std::string_view buffer)
+{
+    if (buffer.size() < FixBinaryCodec::HeaderLength)
+    {
+        return Result{Incomplete, 0};
+    }
+
+    std::size_t frameLength = FixBinaryCodec::frameLength(buffer);
+
+    if (static_cast<uint8_t>(buffer[1]) != FixBinaryCodec::Version || frameLength < FixBinaryCodec::BlockLength || frameLength > MaxBodyLength)
+    {
+        return Result{Corrupt, resync(buffer)};
+    }
+    else if (buffer.size() < frameLength)
+    {
+        return Result{Incomplete, 0};
+    }
+
+    if (!FixBinaryCodec::verify(buffer.substr(0, frameLength)))
+    {
+        return Result{Invalid, frameLength};
+    }
+
+    return Result{Complete, frameLength};
+}
+
+
+std::size_t FixFrameDecoder::resync(std::string_view buffer)
+{
+    std::size_t iNext = std::min(buffer.find(BeginString.substr(0, 2), 1), /* Next "8=" or binary header */
+                                 buffer.find(static_cast<char>(FixBinaryCodec::Magic), 1));
+
+    if (iNext != std::string_view::npos)
+    {
+        return iNext;
+    }
+
+    /* Keep a trailing '8' which may be the start of the next frame */
+    return (buffer.size() > 1 && buffer.back() == '8') ? (buffer.size() - 1) : buffer.size();
+}
@@ -0,0 +1,50 @@
+/**
+ * @file FixFrameDecoder.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+
+/**
+ * Splits a byte-stream into complete raw-FIX messages.
+ *
+ * A frame is "8=FIX.4.4;9=<BodyLength>;<body>10=<CheckSum>;" where BodyLength counts the bytes
+ * between the BodyLength delimiter and the CheckSum tag. Binary frames (see FixBinaryCodec) are
+ * recognised by their header and carry their own length.
+ */
+class FixFrameDecoder
+{
+public:
+    enum Status
+    {
+        Complete = 0,   /* Frame of length bytes at start of buffer */
+        Incomplete = 1, /* Need more bytes */
+        Corrupt = 2,    /* Skip length bytes to resynchronize */
+        Invalid = 3     /* Frame of length bytes failed CheckSum validation */
+    };
+
+    struct Result
+    {
+        Status status;
+        std::size_t length;
+    };
+
+    /* Upper bound on BodyLength. Anything larger is treated as corrupt */
+    static constexpr std::size_t MaxBodyLength = (1 << 20);
+
+    /* Decode the first frame in buffer */
+    [[nodiscard]] static Result decode(std::string_view buffer);
+
+private:
+    static Result decodeBinary(std::string_view buffer);
+
+    /* Returns offset of next possible frame start after the first byte (or buffer size) */
+    static std::size_t resync(std::string_view buffer);
+};
@@ -0,0 +1,246 @@
+/**
+ * @file FixJournal.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FixJournal.hpp"
+#include "logger/Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/* Start of the file. Fields are read and written with __atomic builtins so stats can be taken from
+ * other threads */
+struct FixJournal::Header
+{
+    uint64_t magic;
+    uint64_t version;
+    uint64_t writeOffset; /* End of the last complete record */
+    uint64_t nextOutgoingSeqNo;
+    uint64_t expectedIncomingSeqNo;
+};
+
+
+/* Precedes each message. Records are 8-byte aligned */
+struct FixJournal::RecordHeader
+{
+    uint64_t seqNo;
+    uint64_t length;
+};
+
+
+namespace
+{
+constexpr uint64_t Magic = 0x4C4E524A58494654; /* "TFIXJRNL" */
+constexpr uint64_t Version = 1;
+
+/* Header padded to a page so records stay aligned */
+constexpr std::size_t HeaderSize = 4096;
+
+constexpr std::size_t alignRecord(std::size_t length)
+{
+    return (length + 7) & ~std::size_t(7);
+}
+
+inline uint64_t load(const uint64_t &field)
+{
+    return __atomic_load_n(&field, __ATOMIC_ACQUIRE);
+}
+
+inline void store(uint64_t &field, uint64_t value)
+{
+    __atomic_store_n(&field, value, __ATOMIC_RELEASE);
+}
+} // namespace
+
+
+FixJournal::FixJournal(const std::string &path, std::size_t capacity) : _path(path)
+{
+    static_assert(sizeof(Header) <= HeaderSize);
+
+    _fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+    struct stat status{};
+
+    if (_fd == (-1) || fstat(_fd, &status) == (-1))
+    {
+        std::string error = std::strerror(errno);
+        if (_fd != (-1))
+            ::close(_fd);
+
+        throw std::runtime_error("Failed to open journal " + path + ": " + error);
+    }
+
+    bool created = (status.st_size == 0);
+
+    /* An existing journal keeps its size */
+    _capacity = (created ? std::max(capacity, 2 * HeaderSize) : static_cast<std::size_t>(status.st_size));
+
+    if (created && ftruncate(_fd, static_cast<off_t>(_capacity)) == (-1))
+    {
+        std::string error = std::strerror(errno);
+        ::close(_fd);
+        throw std::runtime_error("Failed to size journal " + path + ": " + error);
+    }
+
+    void *mapping = mmap(nullptr, _capacity, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+
+    if (mapping == MAP_FAILED)
+    {
+        std::string error = std::strerror(errno);
+        ::close(_fd);
+        throw std::runtime_error("Failed to map journal " + path + ": " + error);
+    }
+
+    _mapping = static_cast<char *>(mapping);
+
+    if (created)
+    {
+        Header &init = header();
+        init.version = Version;
+        init.writeOffset = HeaderSize;
+        init.nextOutgoingSeqNo = 1;
+        init.expectedIncomingSeqNo = 1;
+        store(init.magic, Magic); /* Last: marks the header as complete */
+        return;
+    }
+
+    if (load(header().magic) != Magic || header().version != Version || header().writeOffset < HeaderSize || header().writeOffset > _capacity)
+    {
+        munmap(_mapping, _capacity);
+        ::close(_fd);
+        throw std::runtime_error("Not a FIX journal: " + path);
+    }
+
+    recover();
+}
+
+
+FixJournal::~FixJournal()
+{
+    munmap(_mapping, _capacity); /* MAP_SHARED: the kernel writes back dirty pages */
+    ::close(_fd);
+}
+
+
+void FixJournal::recover()
+{
+    const uint64_t end = load(header().writeOffset);
+
+    for (uint64_t offset = HeaderSize; offset + sizeof(RecordHeader) <= end;)
+    {
+        const auto &record = *reinterpret_cast<const RecordHeader *>(_mapping + offset);
+
+        if (record.seqNo == 0 || offset + sizeof(RecordHeader) + record.length > end)
+        {
+            Logger::instance().error("Truncating corrupt journal " + _path + " at offset " + std::to_string(offset));
+            store(header().writeOffset, offset);
+            break;
+        }
+
+        if (record.seqNo > _offsets.size())
+        {
+            _offsets.resize(record.seqNo, 0);
+        }
+
+        _offsets[record.seqNo - 1] = offset;
+        _nRecords.fetch_add(1, std::memory_order_relaxed);
+
+        offset += sizeof(RecordHeader) + alignRecord(record.length);
+    }
+
+    /* Numbers used while full were never journaled */
+    if (_offsets.size() < nextOutgoingSeqNo() - 1)
+    {
+        _offsets.resize(nextOutgoingSeqNo() - 1, 0);
+    }
+
+    Logger::instance().info("Recovered journal " + _path + " (records: " + std::to_string(_nRecords.load()) + ", next outgoing: " + std::to_string(nextOutgoingSeqNo()) +
+                            ", expected incoming: " + std::to_string(expectedIncomingSeqNo()) + ")");
+}
+
+
+uint64_t FixJournal::nextOutgoingSeqNo() const
+{
+    return load(header().nextOutgoingSeqNo);
+}
+
+
+bool FixJournal::append(std::string_view message)
+{
+    Header &state = header();
+
+    const uint64_t seqNo = state.nextOutgoingSeqNo;
+    const uint64_t offset = state.writeOffset;
+    const std::size_t recordSize = sizeof(RecordHeader) + alignRecord(message.size());
+
+    store(state.nextOutgoingSeqNo, seqNo + 1);
+
+    if (offset + recordSize > _capacity)
+    {
+        if (_offsets.size() < seqNo)
+            _offsets.resize(seqNo, 0);
+
+        Logger::instance().error("Journal full, cannot resend MsgSeqNo " + std::to_string(seqNo) + ": " + _path);
+        return false;
+    }
+
+    auto &record = *reinterpret_cast<RecordHeader *>(_mapping + offset);
+    record.seqNo = seqNo;
+    record.length = message.size();
+    std::memcpy(_mapping + offset + sizeof(RecordHeader), message.data(), message.size());
+
+    store(state.writeOffset, offset + recordSize); /* Publish only complete records */
+
+    _offsets.push_back(offset);
+    _nRecords.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+
+std::string_view FixJournal::find(uint64_t seqNo) const
+{
+    if (seqNo == 0 || seqNo > _offsets.size() || _offsets[seqNo - 1] == 0)
+    {
+        return std::string_view();
+    }
+
+    const uint64_t offset = _offsets[seqNo - 1];
+    const auto &record = *reinterpret_cast<const RecordHeader *>(_mapping + offset);
+
+    return std::string_view(_mapping + offset + sizeof(RecordHeader), record.length);
+}
+
+
+uint64_t FixJournal::expectedIncomingSeqNo() const
+{
+    return load(header().expectedIncomingSeqNo);
+}
+
+
+void FixJournal::setExpectedIncomingSeqNo(uint64_t seqNo)
+{
+    store(header().expectedIncomingSeqNo, seqNo);
+}
+
+
+FixJournal::Stats FixJournal::stats() const
+{
+    Stats result;
+    result.nextOutgoingSeqNo = nextOutgoingSeqNo();
+    result.expectedIncomingSeqNo = expectedIncomingSeqNo();
+    result.records = _nRecords.load(std::memory_order_relaxed);
+    result.bytesUsed = load(header().writeOffset);
+    result.capacity = _capacity;
+    return result;
+}
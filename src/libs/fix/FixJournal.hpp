@@ -0,0 +1,86 @@
+/**
+ * @file FixJournal.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+/**
+ * Append-only journal of a FIX session's outbound messages in a memory-mapped file.
+ *
+ * Each record holds the exact bytes sent with MsgSeqNo (34), so a ResendRequest is served from the
+ * mapping (the sender adds PossDupFlag and OrigSendingTime). The header also persists the next
+ * outbound and expected inbound sequence numbers: reopening the file after a restart only walks
+ * the record headers.
+ *
+ * Not thread-safe: callers serialise appends and lookups per session. The sequence number
+ * accessors may be read from any thread.
+ */
+class FixJournal
+{
+public:
+    static constexpr std::size_t DefaultCapacity = 64 << 20;
+
+    /* Opens (recovering sequence numbers) or creates the journal at path. Throws std::runtime_error
+     * on failure or if the file is not a journal */
+    explicit FixJournal(const std::string &path, std::size_t capacity = DefaultCapacity);
+    ~FixJournal();
+
+    FixJournal(const FixJournal &) = delete;
+    FixJournal &operator=(const FixJournal &) = delete;
+
+    /* Number for the next outbound message (first is 1) */
+    [[nodiscard]] uint64_t nextOutgoingSeqNo() const;
+
+    /* Record message sent as nextOutgoingSeqNo() and advance it. When the file is full the number is
+     * still used but the message cannot be resent (returns false) */
+    bool append(std::string_view message);
+
+    /* Sent bytes for seqNo, valid until the journal is destroyed. Empty if never journaled */
+    [[nodiscard]] std::string_view find(uint64_t seqNo) const;
+
+    /* Number the peer's next message should carry (first is 1) */
+    [[nodiscard]] uint64_t expectedIncomingSeqNo() const;
+    void setExpectedIncomingSeqNo(uint64_t seqNo);
+
+    [[nodiscard]] inline const std::string &path() const { return _path; }
+
+    struct Stats
+    {
+        uint64_t nextOutgoingSeqNo{0};
+        uint64_t expectedIncomingSeqNo{0};
+        std::size_t records{0};
+        std::size_t bytesUsed{0};
+        std::size_t capacity{0};
+    };
+
+    [[nodiscard]] Stats stats() const;
+
+private:
+    struct Header;
+    struct RecordHeader;
+
+    /* Walk records written by a previous run and rebuild the index */
+    void recover();
+
+    [[nodiscard]] inline Header &header() const { return *reinterpret_cast<Header *>(_mapping); }
+
+    std::string _path;
+    int _fd{-1};
+    char *_mapping{nullptr};
+    std::size_t _capacity{0};
+
+    std::vector<uint64_t> _offsets; /* Record offset of seqNo (index seqNo - 1). 0 => not journaled */
+    std::atomic<std::size_t> _nRecords{0};
+};
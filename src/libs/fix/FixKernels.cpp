@@ -0,0 +1,185 @@
+/**
+ * @file FixKernels.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FixKernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TALOS_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+
+const char *findScalar(const char *begin, const char *end, char c)
+{
+    for (; begin != end; ++begin)
+    {
+        if (*begin == c)
+            return begin;
+    }
+
+    return end;
+}
+
+
+uint32_t sumScalar(const char *begin, const char *end)
+{
+    uint32_t total = 0;
+
+    for (; begin != end; ++begin)
+    {
+        total += static_cast<unsigned char>(*begin);
+    }
+
+    return total;
+}
+
+
+#ifdef TALOS_X86_KERNELS
+
+__attribute__((target("sse4.2"))) const char *findSSE42(const char *begin, const char *end, char c)
+{
+    const __m128i needle = _mm_set1_epi8(c);
+
+    for (; (end - begin) >= 16; begin += 16)
+    {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+
+        if (mask != 0)
+            return begin + __builtin_ctz(mask);
+    }
+
+    return findScalar(begin, end, c);
+}
+
+
+__attribute__((target("sse4.2"))) uint32_t sumSSE42(const char *begin, const char *end)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i total = zero; /* 2 x 64-bit partial sums */
+
+    for (; (end - begin) >= 16; begin += 16)
+    {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        total = _mm_add_epi64(total, _mm_sad_epu8(chunk, zero));
+    }
+
+    uint32_t result = static_cast<uint32_t>(_mm_cvtsi128_si32(total)) + static_cast<uint32_t>(_mm_extract_epi32(total, 2));
+
+    return result + sumScalar(begin, end);
+}
+
+
+__attribute__((target("avx2"))) const char *findAVX2(const char *begin, const char *end, char c)
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+
+    for (; (end - begin) >= 32; begin += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+        unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+
+        if (mask != 0)
+            return begin + __builtin_ctz(mask);
+    }
+
+    return findSSE42(begin, end, c);
+}
+
+
+__attribute__((target("avx2"))) uint32_t sumAVX2(const char *begin, const char *end)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i total = zero; /* 4 x 64-bit partial sums */
+
+    for (; (end - begin) >= 32; begin += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(chunk, zero));
+    }
+
+    __m128i half = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    uint32_t result = static_cast<uint32_t>(_mm_cvtsi128_si32(half)) + static_cast<uint32_t>(_mm_extract_epi32(half, 2));
+
+    return result + sumSSE42(begin, end);
+}
+
+#endif
+
+} // namespace
+
+
+/* Constant-initialized so kernels are usable during static initialization; upgraded once CPU is detected */
+FixKernels::Kernels FixKernels::_kernels{Scalar, findScalar, sumScalar};
+
+const bool FixKernels::_selected = FixKernels::setIsa(FixKernels::bestSupportedIsa());
+
+
+bool FixKernels::isSupported(Isa isa)
+{
+    switch (isa)
+    {
+        case Scalar:
+            return true;
+#ifdef TALOS_X86_KERNELS
+        case SSE42:
+            return __builtin_cpu_supports("sse4.2");
+        case AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+
+bool FixKernels::setIsa(Isa isa)
+{
+    if (!isSupported(isa))
+    {
+        return false;
+    }
+
+    _kernels = kernelsFor(isa);
+    return true;
+}
+
+
+FixKernels::Isa FixKernels::bestSupportedIsa()
+{
+#ifdef TALOS_X86_KERNELS
+    __builtin_cpu_init(); /* May run before constructors which initialize CPU detection */
+#endif
+
+    if (isSupported(AVX2))
+        return AVX2;
+    else if (isSupported(SSE42))
+        return SSE42;
+
+    return Scalar;
+}
+
+
+FixKernels::Kernels FixKernels::kernelsFor(Isa isa)
+{
+    switch (isa)
+    {
+#ifdef TALOS_X86_KERNELS
+        case AVX2:
+            return Kernels{AVX2, findAVX2, sumAVX2};
+        case SSE42:
+            return Kernels{SSE42, findSSE42, sumSSE42};
+#endif
+        default:
+            return Kernels{Scalar, findScalar, sumScalar};
+    }
+}
@@ -0,0 +1,64 @@
+/**
+ * @file FixKernels.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <cstdint>
+
+
+/**
+ * Vectorized byte-scanning kernels for FIX encode/decode.
+ *
+ * The widest instruction set supported by the CPU is selected once at startup. All kernels have a
+ * scalar fallback which is used on other architectures.
+ */
+class FixKernels
+{
+public:
+    enum Isa
+    {
+        Scalar = 0,
+        SSE42 = 1,
+        AVX2 = 2
+    };
+
+    /* Instruction set currently in use */
+    [[nodiscard]] static inline Isa isa() { return _kernels.isa; }
+
+    /* Returns true if the CPU supports the instruction set */
+    [[nodiscard]] static bool isSupported(Isa isa);
+
+    /* Override the instruction set (testing/benchmarking). Returns false if unsupported. Not thread-safe */
+    static bool setIsa(Isa isa);
+
+    /* Returns pointer to first occurrence of c in [begin, end) or end if not found */
+    [[nodiscard]] static inline const char *find(const char *begin, const char *end, char c) { return _kernels.find(begin, end, c); }
+
+    /* Sum of all bytes in [begin, end) modulo 2^32 */
+    [[nodiscard]] static inline uint32_t sum(const char *begin, const char *end) { return _kernels.sum(begin, end); }
+
+    /* FIX CheckSum (10) of [begin, end) */
+    [[nodiscard]] static inline unsigned int checksum(const char *begin, const char *end) { return (sum(begin, end) % 256); }
+
+private:
+    using FindFn = const char *(*)(const char *, const char *, char);
+    using SumFn = uint32_t (*)(const char *, const char *);
+
+    struct Kernels
+    {
+        Isa isa;
+        FindFn find;
+        SumFn sum;
+    };
+
+    static Kernels kernelsFor(Isa isa);
+    static Isa bestSupportedIsa();
+
+    static Kernels _kernels;
+    static const bool _selected;
+};
@@ -8,37 +8,121 @@
  */
 
 #include "FixMessage.hpp"
+#include "FixKernels.hpp"
 #include "FixTag.hpp"
-#include <iomanip>
-#include <iostream>
-#include <sstream>
+#include <charconv>
 
 
-FixMessage::FixMessage(const std::string &message)
+namespace
 {
-    _message = message; /* Already constructed */
+constexpr std::string_view BeginString{"8=FIX.4.4;9="};
+constexpr std::size_t TrailerLength = 7; /* 10=xxx; */
+} // namespace
 
-    std::size_t iCurr = 0;
-    std::size_t iNext = 0;
-    while ((iNext = message.find(";", iCurr)) != std::string::npos)
+
+FixMessage::FixMessage()
+{
+    _message.append(BeginString);
+    _message.append("0;10=000;");
+
+    _bodyOffset = BeginString.size() + 2;
+    updateHeaderAndTrailer();
+}
+
+
+FixMessage::FixMessage(const std::string &message) : FixMessage(FixMessageView(message))
+{
+}
+
+
+FixMessage::FixMessage(const FixMessageView &view) : FixMessage()
+{
+    if (copyFramed(view))
+    {
+        return;
+    }
+
+    for (std::size_t i = 0; i < view.size(); ++i)
     {
-        auto substring = message.substr(iCurr, iNext - iCurr);
+        setTag(view.tagAt(i), view.valueAt(i));
+    }
+}
+
+
+FixMessage::FixMessage(const FixMessage &other)
+    : _message(other._message, &FixMessagePool::local()), _bodyOffset(other._bodyOffset), _bodyLength(other._bodyLength), _bodySum(other._bodySum),
+      _fields(other._fields, &FixMessagePool::local())
+{
+}
 
-        TagValue tagValue = extractTagValuePair(substring);
-        setTag(tagValue.first, tagValue.second);
 
-        iCurr = iNext + 1;
+bool FixMessage::copyFramed(const FixMessageView &view)
+{
+    std::string_view raw = view.toStringView();
+    std::size_t nFields = view.size();
+
+    if (nFields < 3 || view.tagAt(0) != 8 || view.tagAt(1) != 9 || view.tagAt(nFields - 1) != 10 ||
+        view.valueAt(nFields - 1).size() != TrailerLength - 4 || raw.compare(0, BeginString.size(), BeginString) != 0) /* Trailer: exactly 10=xxx; */
+    {
+        return false;
     }
+
+    auto offsetOf = [&raw](std::string_view value)
+    {
+        return static_cast<std::size_t>(value.data() - raw.data());
+    };
+
+    std::size_t bodyOffset = offsetOf(view.valueAt(1)) + view.valueAt(1).size() + 1;
+    std::size_t trailerOffset = offsetOf(view.valueAt(nFields - 1)) - 3; /* 10= */
+
+    /* Index the body */
+    _fields.reserve(nFields);
+
+    for (std::size_t i = 2; i < nFields - 1; ++i)
+    {
+        Tag tag = view.tagAt(i);
+        if (findField(tag) != (-1)) /* Duplicate tag => rebuild */
+        {
+            _fields.clear();
+            return false;
+        }
+
+        auto value = view.valueAt(i);
+        _fields.push_back(Field{tag, static_cast<uint32_t>(offsetOf(value) - bodyOffset), static_cast<uint32_t>(value.size())});
+    }
+
+    /* Copy the encoded message once */
+    _message.reserve(trailerOffset + TrailerLength + 32); /* Room for enrichment */
+    _message.assign(raw.data(), trailerOffset + TrailerLength);
+
+    _bodyOffset = bodyOffset;
+    _bodyLength = trailerOffset - bodyOffset;
+    _bodySum = FixKernels::sum(raw.data() + bodyOffset, raw.data() + trailerOffset);
+
+    updateHeaderAndTrailer(); /* Ensures BodyLength/CheckSum are consistent */
+    return true;
+}
+
+
+int FixMessage::findField(Tag tag) const
+{
+    for (std::size_t i = 0; i < _fields.size(); ++i)
+    {
+        if (_fields[i].tag == tag)
+            return static_cast<int>(i);
+    }
+
+    return (-1);
 }
 
 
 bool FixMessage::hasTag(Tag tag) const
 {
-    return (_valueForTag.find(tag) != _valueForTag.end());
+    return (findField(tag) != (-1));
 }
 
 
-void FixMessage::setTag(Tag tag, Value value)
+void FixMessage::setTag(Tag tag, std::string_view value)
 {
     switch (tag)
     {
@@ -47,86 +131,124 @@ void FixMessage::setTag(Tag tag, Value value)
         case 10:
             break;
         default:
-            _valueForTag[tag] = std::move(value);
-            _message.clear(); /* Needs to be recomputed */
+        {
+            int i = findField(tag);
+
+            if (i == (-1))
+            {
+                appendField(tag, value);
+            }
+            else
+            {
+                Field &field = _fields[i];
+                replaceBody(field.offset, field.length, value, i + 1);
+                field.length = static_cast<uint32_t>(value.size());
+            }
+
+            updateHeaderAndTrailer();
             break;
+        }
     }
 }
 
 
 void FixMessage::eraseTag(Tag tag)
 {
-    auto iter = _valueForTag.find(tag);
-    if (iter == _valueForTag.end())
+    int i = findField(tag);
+    if (i == (-1))
     {
         return;
     }
 
-    _valueForTag.erase(iter);
-    _message.clear(); /* Needs to be recomputed */
+    /* Erase "tag=value;" */
+    char tagBuffer[16];
+    auto tagResult = std::to_chars(tagBuffer, tagBuffer + sizeof(tagBuffer), tag);
+    std::size_t tagLength = (tagResult.ptr - tagBuffer) + 1; /* Including '=' */
+
+    Field field = _fields[i];
+    replaceBody(field.offset - tagLength, tagLength + field.length + 1, std::string_view(), i + 1);
+
+    _fields.erase(_fields.begin() + i);
+    updateHeaderAndTrailer();
 }
 
 
 FixMessage::Value FixMessage::getValue(Tag tag) const
 {
-    auto iter = _valueForTag.find(tag);
-    return (iter != _valueForTag.end() ? iter->second : "");
+    return Value(valueOf(tag));
 }
 
 
-FixMessage::TagValue FixMessage::extractTagValuePair(const std::string &tagValue) const
+std::string_view FixMessage::valueOf(Tag tag) const
 {
-    std::size_t iSeparator = tagValue.find("=");
+    int i = findField(tag);
+    return (i != (-1) ? std::string_view(_message).substr(_bodyOffset + _fields[i].offset, _fields[i].length) : std::string_view());
+}
 
-    if (iSeparator == std::string::npos)
-    {
-        throw std::runtime_error("missing expected separator '='");
-    }
 
-    std::string tag = tagValue.substr(0, iSeparator);
-    std::string value = tagValue.substr(iSeparator + 1);
+void FixMessage::appendField(Tag tag, std::string_view value)
+{
+    char tagBuffer[16];
+    auto tagResult = std::to_chars(tagBuffer, tagBuffer + sizeof(tagBuffer) - 1, tag);
+    *tagResult.ptr = '=';
 
-    return TagValue(std::stoi(tag), value);
-}
+    std::string_view tagPrefix(tagBuffer, tagResult.ptr - tagBuffer + 1);
+    std::size_t iInsert = _bodyOffset + _bodyLength; /* Start of trailer */
 
+    /* Single insert then overwrite: shifts the trailer once */
+    _message.insert(iInsert, tagPrefix.size() + value.size() + 1, ';');
+    _message.replace(iInsert, tagPrefix.size(), tagPrefix);
+    _message.replace(iInsert + tagPrefix.size(), value.size(), value);
 
-std::string FixMessage::constructTagValuePair(Tag tag, Value value) const
-{
-    return (std::to_string(tag) + "=" + std::move(value) + ";");
+    _fields.push_back(Field{tag, static_cast<uint32_t>(_bodyLength + tagPrefix.size()), static_cast<uint32_t>(value.size())});
+
+    _bodyLength += tagPrefix.size() + value.size() + 1;
+    _bodySum += FixKernels::sum(tagPrefix.data(), tagPrefix.data() + tagPrefix.size()) +
+                FixKernels::sum(value.data(), value.data() + value.size()) + static_cast<unsigned char>(';');
 }
 
 
-const std::string &FixMessage::toString() const
+void FixMessage::replaceBody(std::size_t offset, std::size_t length, std::string_view replacement, std::size_t iNextField)
 {
-    if (!_message.empty())
-    {
-        return _message;
-    }
+    const char *iOld = _message.data() + _bodyOffset + offset;
 
-    /* Body */
-    std::string messageBody;
-    for (auto &[tag, value] : _valueForTag)
-    {
-        messageBody += constructTagValuePair(tag, value);
-    }
+    _bodySum -= FixKernels::sum(iOld, iOld + length);
+    _bodySum += FixKernels::sum(replacement.data(), replacement.data() + replacement.size());
 
-    /* Header */
-    _message += constructTagValuePair(8, "FIX.4.4");
-    _message += constructTagValuePair(9, std::to_string(messageBody.size()));
-    _message += messageBody;
+    _message.replace(_bodyOffset + offset, length, replacement);
+    _bodyLength = _bodyLength - length + replacement.size();
 
-    /* CheckSum: sum of all ASII characters except 10=xxx; tag */
-    unsigned int count = 0;
+    /* Shift all following fields */
+    long delta = static_cast<long>(replacement.size()) - static_cast<long>(length);
 
-    for (char c : _message)
+    if (delta != 0)
     {
-        count += static_cast<unsigned char>(c);
+        for (std::size_t i = iNextField; i < _fields.size(); ++i)
+        {
+            _fields[i].offset = static_cast<uint32_t>(_fields[i].offset + delta);
+        }
     }
+}
+
+
+void FixMessage::updateHeaderAndTrailer()
+{
+    /* BodyLength: the message only shifts if the number of digits has changed */
+    char lengthBuffer[16];
+    auto lengthResult = std::to_chars(lengthBuffer, lengthBuffer + sizeof(lengthBuffer), _bodyLength);
+    std::string_view bodyLength(lengthBuffer, lengthResult.ptr - lengthBuffer);
+
+    std::size_t currentDigits = _bodyOffset - BeginString.size() - 1;
 
-    std::stringstream checksumStream;
-    checksumStream << std::setw(3) << std::setfill('0') << std::to_string(count % 256);
+    _message.replace(BeginString.size(), currentDigits, bodyLength);
+    _bodyOffset = BeginString.size() + bodyLength.size() + 1;
 
-    _message += constructTagValuePair(10, checksumStream.str());
+    /* CheckSum: sum of header + body. Patch the 3 digits in-place */
+    const char *header = _message.data();
+    unsigned int checksum = (FixKernels::sum(header, header + _bodyOffset) + _bodySum) % 256;
 
-    return _message;
+    char *digits = _message.data() + _bodyOffset + _bodyLength + 3;
+    digits[0] = static_cast<char>('0' + checksum / 100);
+    digits[1] = static_cast<char>('0' + (checksum / 10) % 10);
+    digits[2] = static_cast<char>('0' + checksum % 10);
 }
@@ -1,5 +1,5 @@
 /**
- * @file FixTag.hpp
+ * @file FixMessage.hpp
  * @author Edward Palmer
  * @date 2025-07-27
  *
@@ -8,11 +8,23 @@
  */
 
 #pragma once
+#include "FixDictionary.hpp"
+#include "FixMessagePool.hpp"
+#include "FixMessageView.hpp"
 #include "FixTag.hpp"
+#include <cstdint>
+#include <memory_resource>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
 
+/**
+ * Mutable FIX message. Storage comes from the calling thread's FixMessagePool (including copies) so
+ * building and copying messages does no global malloc/free once the pool has warmed up. Modifying a
+ * message off the thread that created (or copied) it is safe but falls back to the global heap; it
+ * may be destroyed on any thread.
+ */
 class FixMessage
 {
 public:
@@ -20,13 +32,31 @@ public:
     using Value = std::string;
     using TagValue = std::pair<Tag, Value>;
 
-    FixMessage() = default;
+    FixMessage();
 
     /* Construct from a raw-FIX string */
     FixMessage(const std::string &message);
 
-    /* Update value for a specific tag */
-    void setTag(Tag tag, Value value);
+    /* Construct from a parsed raw-FIX message (copies all values) */
+    explicit FixMessage(const FixMessageView &view);
+
+    /* Copies allocate from the calling thread's pool */
+    FixMessage(const FixMessage &other);
+    FixMessage &operator=(const FixMessage &other) = default;
+
+    FixMessage(FixMessage &&other) = default;
+    FixMessage &operator=(FixMessage &&other) = default;
+
+    /* Update value for a specific tag. Patches the encoded message in-place */
+    void setTag(Tag tag, std::string_view value);
+
+    /* Update value for a tag in the FIX dictionary */
+    template <FixTag Tag>
+    void set(typename FixField<Tag>::Type value)
+    {
+        char buffer[FixCodec::MaxEncodedLength];
+        setTag(Tag, FixField<Tag>::format(value, buffer));
+    }
 
     /* Remove a tag from a FIX message */
     void eraseTag(Tag tag);
@@ -37,16 +67,48 @@ public:
     /* Returns the value for a tag or an empty string if not present */
     [[nodiscard]] Value getValue(Tag tag) const;
 
-    /* Converts to a std::string */
-    [[nodiscard]] const std::string &toString() const;
+    /* Typed value for a tag in the FIX dictionary. Parsed on each call */
+    template <FixTag Tag>
+    [[nodiscard]] typename FixField<Tag>::Type get() const { return FixField<Tag>::parse(valueOf(Tag)); }
 
-protected:
-    std::string constructTagValuePair(Tag tag, Value value) const;
+    /* Returns the encoded message. Always up-to-date so no encoding is required */
+    [[nodiscard]] inline std::string_view toStringView() const { return _message; }
 
-    TagValue extractTagValuePair(const std::string &tagValue) const;
+    [[nodiscard]] inline std::string toString() const { return std::string(_message); }
 
 private:
-    /* Stores constructed message */
-    mutable std::string _message;
-    std::unordered_map<Tag, Value> _valueForTag;
+    struct Field
+    {
+        Tag tag;
+        uint32_t offset; /* Offset of value from start of body */
+        uint32_t length; /* Length of value */
+    };
+
+    /* Copy an already-framed message without re-encoding. Returns false if not possible */
+    bool copyFramed(const FixMessageView &view);
+
+    /* Returns index of field or (-1) if not present */
+    int findField(Tag tag) const;
+
+    /* Returns the value for a tag or an empty view if not present. Invalidated by any update */
+    std::string_view valueOf(Tag tag) const;
+
+    /* Append a new tag/value pair to end of body */
+    void appendField(Tag tag, std::string_view value);
+
+    /* Replace bytes [offset, offset + length) of the body and shift all following fields */
+    void replaceBody(std::size_t offset, std::size_t length, std::string_view replacement, std::size_t iNextField);
+
+    /* Rewrite BodyLength (9) and CheckSum (10) after body has changed */
+    void updateHeaderAndTrailer();
+
+    /* Encoded message: 8=FIX.4.4;9=<BodyLength>;<body>10=<CheckSum>; */
+    std::pmr::string _message{&FixMessagePool::local()};
+
+    std::size_t _bodyOffset{0}; /* Offset of body within _message */
+    std::size_t _bodyLength{0};
+    uint32_t _bodySum{0}; /* Sum of bytes in body (for CheckSum) */
+
+    /* Fields in body order */
+    std::pmr::vector<Field> _fields{&FixMessagePool::local()};
 };
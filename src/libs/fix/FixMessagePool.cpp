@@ -0,0 +1,216 @@
+/**
+ * @file FixMessagePool.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FixMessagePool.hpp"
+#include <new>
+
+
+namespace
+{
+/* All pools ever created. Never destroyed */
+std::mutex registryMutex;
+std::vector<FixMessagePool *> registry;
+
+/* Pool leased by this thread (null before first use and after thread exit) */
+thread_local FixMessagePool *ownedPool = nullptr;
+} // namespace
+
+
+/* Thread's claim on a pool */
+struct FixMessagePoolLease
+{
+    FixMessagePoolLease()
+    {
+        std::lock_guard lock(registryMutex);
+
+        for (FixMessagePool *candidate : registry)
+        {
+            if (!candidate->_attached)
+            {
+                pool = candidate;
+                break;
+            }
+        }
+
+        if (!pool)
+        {
+            pool = new FixMessagePool(); /* Leaked deliberately: may outlive this thread's messages */
+            registry.push_back(pool);
+        }
+
+        pool->_attached = true;
+        ownedPool = pool;
+    }
+
+    ~FixMessagePoolLease()
+    {
+        ownedPool = nullptr; /* Later frees on this thread go to the return list */
+
+        std::lock_guard lock(registryMutex);
+        pool->_attached = false;
+    }
+
+    FixMessagePool *pool{nullptr};
+};
+
+
+FixMessagePool::FixMessagePool() : _pool(&_upstream)
+{
+}
+
+
+FixMessagePool &FixMessagePool::local()
+{
+    thread_local FixMessagePoolLease lease;
+    return *lease.pool;
+}
+
+
+std::vector<FixMessagePool::Stats> FixMessagePool::allStats()
+{
+    std::lock_guard lock(registryMutex);
+
+    std::vector<Stats> result;
+    result.reserve(registry.size());
+
+    for (FixMessagePool *pool : registry)
+    {
+        result.push_back(pool->stats());
+    }
+
+    return result;
+}
+
+
+FixMessagePool::Stats FixMessagePool::stats() const
+{
+    Stats result;
+    result.allocations = _allocations.load(std::memory_order_relaxed);
+    result.bytesInUse = _bytesInUse.load(std::memory_order_relaxed);
+    result.peakBytesInUse = _peakBytesInUse.load(std::memory_order_relaxed);
+    result.upstreamAllocations = _upstream.allocations.load(std::memory_order_relaxed);
+    result.bytesReserved = _upstream.bytesReserved.load(std::memory_order_relaxed);
+    result.offThreadAllocations = _offThreadAllocations.load(std::memory_order_relaxed);
+    result.threadAttached = _attached.load(std::memory_order_relaxed);
+    return result;
+}
+
+
+void *FixMessagePool::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (ownedPool != this)
+    {
+        /* The pool is not ours to touch: go to the heap and remember the block for the free */
+        void *p = _upstream.allocate(bytes, alignment);
+
+        {
+            std::lock_guard lock(_foreignMutex);
+            _foreignBlocks.insert(p);
+        }
+
+        _foreignCount.fetch_add(1, std::memory_order_release);
+        _offThreadAllocations.fetch_add(1, std::memory_order_relaxed);
+        return p;
+    }
+
+    if (_returned.load(std::memory_order_relaxed))
+    {
+        drainReturned();
+    }
+
+    bytes = blockSize(bytes);
+    void *p = _pool.allocate(bytes, blockAlignment(alignment));
+
+    _allocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t inUse = _bytesInUse.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    std::size_t peak = _peakBytesInUse.load(std::memory_order_relaxed);
+    while (inUse > peak && !_peakBytesInUse.compare_exchange_weak(peak, inUse, std::memory_order_relaxed))
+    {
+    }
+
+    return p;
+}
+
+
+void FixMessagePool::do_deallocate(void *p, std::size_t bytes, std::size_t alignment)
+{
+    if (_foreignCount.load(std::memory_order_acquire) != 0 && releaseForeign(p, bytes, alignment))
+    {
+        return;
+    }
+
+    if (ownedPool == this)
+    {
+        release(p, blockSize(bytes), blockAlignment(alignment));
+        return;
+    }
+
+    /* Another thread: hand the block back to the owner */
+    auto *block = ::new (p) ReturnedBlock{nullptr, blockSize(bytes), blockAlignment(alignment)};
+
+    block->next = _returned.load(std::memory_order_relaxed);
+    while (!_returned.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+}
+
+
+void FixMessagePool::drainReturned()
+{
+    ReturnedBlock *block = _returned.exchange(nullptr, std::memory_order_acquire);
+
+    while (block)
+    {
+        ReturnedBlock returned = *block;
+        release(block, returned.bytes, returned.alignment);
+        block = returned.next;
+    }
+}
+
+
+void FixMessagePool::release(void *p, std::size_t bytes, std::size_t alignment)
+{
+    _pool.deallocate(p, bytes, alignment);
+    _bytesInUse.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+
+bool FixMessagePool::releaseForeign(void *p, std::size_t bytes, std::size_t alignment)
+{
+    {
+        std::lock_guard lock(_foreignMutex);
+
+        if (_foreignBlocks.erase(p) == 0)
+        {
+            return false;
+        }
+    }
+
+    _upstream.deallocate(p, bytes, alignment);
+    _foreignCount.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+
+void *FixMessagePool::UpstreamResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    void *p = ::operator new(bytes, std::align_val_t(alignment));
+
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytesReserved.fetch_add(bytes, std::memory_order_relaxed);
+    return p;
+}
+
+
+void FixMessagePool::UpstreamResource::do_deallocate(void *p, std::size_t bytes, std::size_t alignment)
+{
+    ::operator delete(p, bytes, std::align_val_t(alignment));
+    bytesReserved.fetch_sub(bytes, std::memory_order_relaxed);
+}
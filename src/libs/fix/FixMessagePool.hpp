@@ -0,0 +1,112 @@
+/**
+ * @file FixMessagePool.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+
+/**
+ * Per-thread memory pool for FixMessage storage.
+ *
+ * Each thread takes a pool from a global registry on first use and returns it on exit, so a
+ * replacement thread recycles the same memory. Only the owning thread touches the underlying
+ * (unsynchronized) pool: a message freed on another thread, or after the owner exits, is pushed onto
+ * a lock-free return list that the owner drains on its next allocation. Pools are never destroyed,
+ * which keeps those late frees safe. Once the pool has grown to cover peak load, steady-state
+ * message traffic takes no locks and does no global malloc/free.
+ *
+ * Allocating from another thread's pool (modifying a message off its owner) is served from the
+ * global heap under a lock and counted in Stats::offThreadAllocations.
+ */
+class FixMessagePool final : public std::pmr::memory_resource
+{
+public:
+    struct Stats
+    {
+        std::size_t allocations{0};         /* Total allocations served */
+        std::size_t bytesInUse{0};          /* Bytes currently allocated to messages */
+        std::size_t peakBytesInUse{0};      /* High-water mark of bytesInUse */
+        std::size_t upstreamAllocations{0}; /* Chunks requested from the global heap */
+        std::size_t bytesReserved{0};       /* Bytes held from the global heap */
+        std::size_t offThreadAllocations{0}; /* Allocations by a thread that does not own the pool */
+        bool threadAttached{false};         /* Pool currently owned by a thread */
+    };
+
+    /* Pool for the calling thread */
+    static FixMessagePool &local();
+
+    /* Stats for every pool created so far */
+    static std::vector<Stats> allStats();
+
+    [[nodiscard]] Stats stats() const;
+
+private:
+    FixMessagePool();
+
+    /* Counts requests to the global heap */
+    class UpstreamResource final : public std::pmr::memory_resource
+    {
+    public:
+        std::atomic<std::size_t> allocations{0};
+        std::atomic<std::size_t> bytesReserved{0};
+
+    private:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+    };
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    /* Block freed by a thread other than the owner. Written over the block itself */
+    struct ReturnedBlock
+    {
+        ReturnedBlock *next;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    /* Every block can hold a ReturnedBlock */
+    static constexpr std::size_t blockSize(std::size_t bytes) { return (bytes < sizeof(ReturnedBlock) ? sizeof(ReturnedBlock) : bytes); }
+    static constexpr std::size_t blockAlignment(std::size_t alignment) { return (alignment < alignof(ReturnedBlock) ? alignof(ReturnedBlock) : alignment); }
+
+    /* Owner only: free blocks returned by other threads */
+    void drainReturned();
+
+    /* Owner only */
+    void release(void *p, std::size_t bytes, std::size_t alignment);
+
+    /* Frees p if it was allocated off-thread. Returns false for pooled blocks */
+    bool releaseForeign(void *p, std::size_t bytes, std::size_t alignment);
+
+    /* Releases pool back to the registry on thread exit */
+    friend struct FixMessagePoolLease;
+
+    UpstreamResource _upstream;
+    std::pmr::unsynchronized_pool_resource _pool; /* Owning thread only */
+    std::atomic<ReturnedBlock *> _returned{nullptr};
+
+    /* Blocks allocated off-thread, taken straight from _upstream */
+    std::mutex _foreignMutex;
+    std::unordered_set<void *> _foreignBlocks;
+    std::atomic<std::size_t> _foreignCount{0}; /* Outstanding foreign blocks; skips the lock when zero */
+    std::atomic<std::size_t> _offThreadAllocations{0};
+
+    std::atomic<std::size_t> _allocations{0};
+    std::atomic<std::size_t> _bytesInUse{0};
+    std::atomic<std::size_t> _peakBytesInUse{0};
+    std::atomic<bool> _attached{false};
+};
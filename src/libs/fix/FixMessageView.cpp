@@ -0,0 +1,138 @@
+/**
+ * @file FixMessageView.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FixMessageView.hpp"
+#include "FixKernels.hpp"
+#include <stdexcept>
+
+
+FixMessageView::FixMessageView(std::string_view message) : _message(message)
+{
+    const char *begin = message.data();
+    const char *end = begin + message.size();
+    const char *iCurr = begin;
+
+    while (iCurr != end)
+    {
+        /* Tag: parse digits up to the '=' separator */
+        Tag tag = 0;
+        const char *iTag = iCurr;
+
+        for (; iCurr != end && *iCurr != '='; ++iCurr)
+        {
+            if (*iCurr < '0' || *iCurr > '9')
+            {
+                if (*iCurr == ';')
+                    throw std::runtime_error("missing expected separator '='");
+
+                throw std::runtime_error("invalid character in tag");
+            }
+
+            tag = (tag * 10) + (*iCurr - '0');
+        }
+
+        if (iCurr == end)
+        {
+            break; /* Incomplete trailing field => ignore */
+        }
+        else if (iCurr == iTag)
+        {
+            throw std::runtime_error("missing tag");
+        }
+
+        /* Value: everything up to the ';' delimiter */
+        const char *iValue = ++iCurr;
+
+        iCurr = FixKernels::find(iCurr, end, ';');
+
+        if (iCurr == end)
+        {
+            break; /* Incomplete trailing field => ignore */
+        }
+
+        addField(Field{tag, static_cast<uint32_t>(iValue - begin), static_cast<uint32_t>(iCurr - iValue)});
+        ++iCurr;
+    }
+}
+
+
+FixMessageView::Value FixMessageView::findValue(std::string_view message, Tag tag)
+{
+    const char *begin = message.data();
+    const char *end = begin + message.size();
+    Value result;
+
+    for (const char *iCurr = begin; iCurr != end;)
+    {
+        Tag fieldTag = 0;
+
+        for (; iCurr != end && *iCurr >= '0' && *iCurr <= '9'; ++iCurr)
+        {
+            fieldTag = (fieldTag * 10) + (*iCurr - '0');
+        }
+
+        if (iCurr == end || *iCurr != '=')
+        {
+            break;
+        }
+
+        const char *iValue = ++iCurr;
+        iCurr = FixKernels::find(iCurr, end, ';');
+
+        if (iCurr == end)
+        {
+            break;
+        }
+
+        if (fieldTag == tag) /* Keep scanning: a repeated tag reads as its last value */
+        {
+            result = Value(iValue, static_cast<std::size_t>(iCurr - iValue));
+        }
+
+        ++iCurr;
+    }
+
+    return result;
+}
+
+
+void FixMessageView::addField(const Field &field)
+{
+    if (_nFields < InlineFields)
+        _fields[_nFields] = field;
+    else
+        _overflowFields.push_back(field);
+
+    ++_nFields;
+}
+
+
+int FixMessageView::findField(Tag tag) const
+{
+    for (std::size_t i = _nFields; i-- > 0;)
+    {
+        if (field(i).tag == tag)
+            return static_cast<int>(i);
+    }
+
+    return (-1);
+}
+
+
+bool FixMessageView::hasTag(Tag tag) const
+{
+    return (findField(tag) != (-1));
+}
+
+
+FixMessageView::Value FixMessageView::getValue(Tag tag) const
+{
+    int i = findField(tag);
+    return (i != (-1) ? valueAt(i) : Value());
+}
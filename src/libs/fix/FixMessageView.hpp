@@ -0,0 +1,103 @@
+/**
+ * @file FixMessageView.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "FixDictionary.hpp"
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+
+/**
+ * Read-only view over a raw-FIX message.
+ *
+ * Parses the message in a single pass into a flat tag/offset index. No values are copied so the
+ * underlying buffer must outlive the view. A repeated tag reads as its last value.
+ *
+ * FixBinaryCodec::parse() indexes a binary frame the same way: numeric fixed-block values are
+ * formatted into a small inline buffer, everything else points into the frame.
+ */
+class FixMessageView
+{
+public:
+    using Tag = int;
+    using Value = std::string_view;
+
+    /* Tag/value pairs indexed without allocating. Longer messages continue on the heap */
+    static constexpr std::size_t InlineFields = 64;
+
+    FixMessageView() = default;
+
+    /* Parse a raw-FIX message. Throws on a malformed message */
+    explicit FixMessageView(std::string_view message);
+
+    /* Returns true if tag is present in FIX message */
+    [[nodiscard]] bool hasTag(Tag tag) const;
+
+    /* Returns the value for a tag or an empty view if not present */
+    [[nodiscard]] Value getValue(Tag tag) const;
+
+    /* Typed value for a tag in the FIX dictionary. Parsed on each call */
+    template <FixTag Tag>
+    [[nodiscard]] typename FixField<Tag>::Type get() const { return FixField<Tag>::parse(getValue(Tag)); }
+
+    /* Number of tag/value pairs (including header/trailer tags) */
+    [[nodiscard]] inline std::size_t size() const { return _nFields; }
+
+    /* Tag and value of the i-th field in message order */
+    [[nodiscard]] inline Tag tagAt(std::size_t i) const { return field(i).tag; }
+    [[nodiscard]] inline Value valueAt(std::size_t i) const { return value(field(i)); }
+
+    /* Value for a tag found by scanning a raw-FIX message without building a view. Last value if
+     * repeated. Empty if not present or malformed */
+    [[nodiscard]] static Value findValue(std::string_view message, Tag tag);
+
+    /* The underlying raw-FIX message (or binary frame) */
+    [[nodiscard]] inline std::string_view toStringView() const { return _message; }
+
+    /* True if indexed from a binary frame: values are not laid out as raw-FIX text */
+    [[nodiscard]] inline bool isBinary() const { return _binary; }
+
+    /* Upper bound on the length of the fields encoded as raw-FIX */
+    [[nodiscard]] inline std::size_t textLength() const { return (_binary ? (2 * _message.size() + 256) : _message.size()); }
+
+private:
+    friend class FixBinaryCodec;
+
+    struct Field
+    {
+        Tag tag;
+        uint32_t offset; /* Offset of value from start of message (or of _scratch if ScratchBit set) */
+        uint32_t length; /* Length of value */
+    };
+
+    static constexpr uint32_t ScratchBit = (1u << 31);
+
+    [[nodiscard]] inline const Field &field(std::size_t i) const { return (i < InlineFields ? _fields[i] : _overflowFields[i - InlineFields]); }
+
+    [[nodiscard]] inline Value value(const Field &field) const
+    {
+        return ((field.offset & ScratchBit) ? Value(_scratch.data() + (field.offset & ~ScratchBit), field.length) : _message.substr(field.offset, field.length));
+    }
+
+    void addField(const Field &field);
+
+    /* Returns index of the last field with tag or (-1) if not present */
+    int findField(Tag tag) const;
+
+    std::string_view _message;
+    bool _binary{false};
+
+    std::size_t _nFields{0};
+    std::array<Field, InlineFields> _fields;
+    std::vector<Field> _overflowFields; /* Fields beyond InlineFields */
+
+    std::array<char, 3 * FixCodec::MaxEncodedLength> _scratch; /* Formatted binary values: MsgType, OrderQty, Price */
+};
@@ -12,16 +12,21 @@
 
 enum FixTag
 {
+    BeginSeqNo = 7, /* ResendRequest: first message to resend */
     ClOrdID = 11,
     Currency = 15,
+    EndSeqNo = 16, /* ResendRequest: last message to resend (0 => all) */
     ExecID = 17,
     ExecTransType = 20,
     ExecType = 150,
     IDSource = 22,
     MsgSeqNo = 34,
     MsgType = 35,
+    NewSeqNo = 36, /* SequenceReset: next MsgSeqNo the sender will use */
     OrderQty = 38,
     OrdStatus = 39,
+    OrigClOrdID = 41, /* Order being cancelled/replaced */
+    PossDupFlag = 43, /* Y => resent: may already have been received */
     Price = 44,
     SecurityID = 48,
     SendingTime = 52, /* Message transmission time UTC */
@@ -29,10 +34,13 @@ enum FixTag
     TransactTime = 60,
     SenderCompID = 49, /* Firm sending message */
     SenderSubID = 50,  /* Specific message originator (trader, desk, ...)*/
+    OrigSendingTime = 122, /* Resent message: SendingTime of the original transmission */
+    GapFillFlag = 123,     /* SequenceReset: Y => replaces messages that are not resent */
 
     /* User tags */
     AdminCommand = 9001,
     AdminResponse = 9002,
+    WireEncoding = 9003, /* Logon: requested/accepted encoding for the session */
     Trace = 10000,
 
 };
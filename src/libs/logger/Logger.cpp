@@ -8,8 +8,9 @@
  */
 
 #include "Logger.hpp"
-#include <chrono>
-#include <iomanip>
+#include "utilities/Clock.hpp"
+#include "utilities/Doorbell.hpp"
+#include "utilities/ThreadTuning.hpp"
 #include <iostream>
 
 
@@ -56,6 +57,20 @@ void Logger::setLevel(Level level)
 }
 
 
+void Logger::setThreadTuning(int cpu, int fifoPriority, bool busySpin)
+{
+    if (_running)
+    {
+        log("Logger thread tuning must be set before start() => Ignoring.", Error);
+        return;
+    }
+
+    _cpu = cpu;
+    _fifoPriority = fifoPriority;
+    _busySpin = busySpin;
+}
+
+
 void Logger::start()
 {
     if (_running)
@@ -89,55 +104,64 @@ void Logger::log(std::string message, Level level)
         return;
 
     /* Construct our output message */
-    std::ostringstream os;
-    os << nowUTC() << " " << logLevelName(level) << ": " << std::move(message);
+    char timestamp[Clock::MaxFormattedLength];
+    std::size_t timestampLength = Clock::formatUTC(timestamp, Clock::Seconds);
+
+    const std::string &levelName = logLevelName(level);
+
+    std::string line;
+    line.reserve(timestampLength + levelName.size() + message.size() + 3);
+    line.append(timestamp, timestampLength).append(" ").append(levelName).append(": ").append(message);
 
     {
         std::unique_lock lock(_loggerMutex);
-        _loggerQueue.push(os.str());
+        _loggerQueue.push(std::move(line));
+        _nPending.store(_loggerQueue.size(), std::memory_order_release);
     } /* End of lock scope. Call notify after unlocking to avoid waking-up waiting thread only to block again */
 
-    _loggerCV.notify_one();
+    if (!_busySpin)
+        _loggerCV.notify_one();
 }
 
 
 void Logger::loggerLoop()
 {
+    if (_cpu >= 0 || _fifoPriority > 0)
+        ThreadTuning::apply(_cpu, _fifoPriority);
+
     while (true)
     {
-        std::unique_lock lock(_loggerMutex);
-        _loggerCV.wait(lock, [this]()
+        if (_busySpin) /* Poll without sleeping. Only lock once there is work */
         {
-            return (!_loggerQueue.empty() || !_running);
-        });
-
-        if (!_running) /* Terminate */
-        {
-            while (!_loggerQueue.empty()) /* Empty queue */
+            while (_nPending.load(std::memory_order_acquire) == 0 && _running)
             {
-                std::cout << _loggerQueue.front() << std::endl;
-                _loggerQueue.pop();
+                Doorbell::cpuRelax();
             }
-
-            std::cout << std::flush; /* Flush anything remaining to stdout */
-            return;
         }
 
-        std::cout << _loggerQueue.front() << std::endl;
-        _loggerQueue.pop();
-    }
-}
+        std::queue<std::string> lines;
 
+        {
+            std::unique_lock lock(_loggerMutex);
 
-std::string Logger::nowUTC() const
-{
-    auto now = std::chrono::system_clock::now();
-    std::time_t currentTime = std::chrono::system_clock::to_time_t(now);
+            _loggerCV.wait(lock, [this]()
+            {
+                return (!_loggerQueue.empty() || !_running);
+            });
 
-    std::ostringstream os;
+            lines.swap(_loggerQueue); /* Take everything queued => write without holding the lock */
+            _nPending.store(0, std::memory_order_relaxed);
+        }
 
-    struct tm currentGMTime; /* gmtime_r is a thread-safe verison */
-    os << std::put_time(gmtime_r(&currentTime, &currentGMTime), "%Y%m%d-%H:%M:%S");
+        for (; !lines.empty(); lines.pop())
+        {
+            std::cout << lines.front() << std::endl;
+        }
 
-    return os.str();
+        if (!_running) /* Terminate */
+        {
+            std::cout << std::flush; /* Flush anything remaining to stdout */
+            return;
+        }
+    }
 }
@@ -44,6 +44,10 @@ public:
 
     void setLevel(Level level);
 
+    /* Logger thread placement (cpu -1 => unpinned; fifoPriority 0 => default scheduler). With busySpin
+     * the thread polls its queue instead of sleeping. Call before start() */
+    void setThreadTuning(int cpu, int fifoPriority, bool busySpin);
+
     inline void debug(std::string message);
     inline void info(std::string message);
     inline void warn(std::string message);
@@ -58,8 +62,6 @@ protected:
 
     const std::string &logLevelName(Level level) const;
 
-    std::string nowUTC() const;
-
     void loggerLoop();
 
 private:
@@ -67,8 +69,13 @@ private:
     std::thread _loggerThread;
     std::condition_variable _loggerCV;
     std::queue<std::string> _loggerQueue;
+    std::atomic<std::size_t> _nPending{0}; /* Size of _loggerQueue: polled by a busy-spinning logger thread without locking */
     std::unordered_map<Level, std::string> _nameForLogLevel;
 
+    int _cpu{-1};
+    int _fifoPriority{0};
+    bool _busySpin{false};
+
     std::atomic<bool> _running{false};
     std::atomic<Level> _logLevel{Level::Info};
 };
@@ -28,11 +28,7 @@ void NetAdmin::sendAdminCommand(std::string command, std::size_t timeoutSeconds)
         return;
     }
 
-    auto adminFix = buildAdminCommand(command);
-    for (auto socket : sockets)
-    {
-        sendFixMessage(adminFix, socket);
-    }
+    broadcastFixMessage(buildAdminCommand(command), sockets);
 
     /* wait timeoutSeconds or until we get a response */
     std::unique_lock lock(_responseMutex);
@@ -54,7 +50,7 @@ void NetAdmin::onShutdown()
 FixMessage NetAdmin::buildAdminCommand(const std::string &command) const
 {
     FixMessage fix;
-    fix.setTag(FixTag::MsgType, "QR");
+    fix.set<FixTag::MsgType>(FixMsgType::AdminRequest);
     fix.setTag(FixTag::ExecID, UUID::instance().generate());
     fix.setTag(FixTag::AdminCommand, command);
 
@@ -62,12 +58,12 @@ FixMessage NetAdmin::buildAdminCommand(const std::string &command) const
 }
 
 
-void NetAdmin::handleFixMessage(FixMessage message, SocketFD socket)
+void NetAdmin::handleFixMessage(const FixMessageView &message, SocketFD socket)
 {
     std::string thePort = std::to_string(_portSocketMappings.getPort(socket));
-    std::string theMsgType = message.getValue(FixTag::MsgType);
+    std::string theMsgType(message.getValue(FixTag::MsgType));
 
-    if (message.getValue(FixTag::MsgType) == "QR") /* Received admin response */
+    if (message.get<FixTag::MsgType>() == FixMsgType::AdminRequest) /* Received admin response */
     {
         std::cout << message.getValue(FixTag::AdminResponse) << std::endl;
     }
@@ -24,7 +24,7 @@ public:
     void sendAdminCommand(std::string command, std::size_t timeoutSeconds = 2);
 
 protected:
-    void handleFixMessage(FixMessage message, SocketFD socket) final;
+    void handleFixMessage(const FixMessageView &message, SocketFD socket) final;
 
     void onShutdown() override;
 
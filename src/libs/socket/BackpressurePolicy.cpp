@@ -0,0 +1,95 @@
+/**
+ * @file BackpressurePolicy.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "BackpressurePolicy.hpp"
+#include <charconv>
+#include <optional>
+#include <stdexcept>
+
+
+namespace
+{
+constexpr std::string_view ActionNames[] = {"block", "drop", "disconnect"};
+
+
+std::size_t parseSize(std::string_view text, std::string_view spec)
+{
+    std::size_t value = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+
+    if (error != std::errc() || end != text.data() + text.size())
+    {
+        throw std::runtime_error("Invalid backpressure policy: " + std::string(spec));
+    }
+
+    return value;
+}
+} // namespace
+
+
+std::string BackpressurePolicy::describe() const
+{
+    return "policy=" + std::string(ActionNames[static_cast<std::size_t>(action)]) + ",high=" + std::to_string(highWater) + ",low=" + std::to_string(lowWater) + ",timeout=" + std::to_string(blockTimeoutMS);
+}
+
+
+BackpressurePolicy BackpressurePolicy::parse(std::string_view spec)
+{
+    BackpressurePolicy policy;
+    std::optional<std::size_t> lowWater;
+
+    for (std::string_view remaining = spec; !remaining.empty();)
+    {
+        std::size_t comma = remaining.find(',');
+        std::string_view item = remaining.substr(0, comma);
+        remaining = (comma == std::string_view::npos ? std::string_view() : remaining.substr(comma + 1));
+
+        std::size_t equals = item.find('=');
+        if (equals == std::string_view::npos)
+        {
+            throw std::runtime_error("Invalid backpressure policy: " + std::string(spec));
+        }
+
+        std::string_view key = item.substr(0, equals);
+        std::string_view value = item.substr(equals + 1);
+
+        if (key == "policy")
+        {
+            std::size_t i = 0;
+            while (i < std::size(ActionNames) && ActionNames[i] != value)
+                ++i;
+
+            if (i == std::size(ActionNames))
+            {
+                throw std::runtime_error("Unknown backpressure policy: " + std::string(value));
+            }
+
+            policy.action = static_cast<Action>(i);
+        }
+        else if (key == "high")
+            policy.highWater = parseSize(value, spec);
+        else if (key == "low")
+            lowWater = parseSize(value, spec);
+        else if (key == "timeout")
+            policy.blockTimeoutMS = parseSize(value, spec);
+        else
+        {
+            throw std::runtime_error("Unknown backpressure option: " + std::string(key));
+        }
+    }
+
+    policy.lowWater = lowWater.value_or(policy.highWater * 3 / 4);
+
+    if (policy.highWater == 0 || policy.lowWater >= policy.highWater)
+    {
+        throw std::runtime_error("Backpressure low-water mark must be below high-water mark: " + std::string(spec));
+    }
+
+    return policy;
+}
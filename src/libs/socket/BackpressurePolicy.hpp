@@ -0,0 +1,44 @@
+/**
+ * @file BackpressurePolicy.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+
+/**
+ * What a session does when its peer stops reading and outgoing messages back up.
+ *
+ * Once highWater messages are queued the session is congested and action applies to every send
+ * until the queue drains to lowWater. A sender blocked for longer than timeout milliseconds
+ * disconnects the session instead. Written as comma-separated key=value pairs, e.g.
+ * "policy=drop,high=4096,low=1024,timeout=5000". low defaults to 3/4 of high.
+ */
+struct BackpressurePolicy
+{
+    enum class Action : uint8_t
+    {
+        Block = 0,     /* Sender waits until the queue drains to lowWater (at most blockTimeoutMS) */
+        Drop = 1,      /* Discard (and count) messages until the queue drains to lowWater */
+        Disconnect = 2 /* Close the session: slow consumer */
+    };
+
+    Action action{Action::Block};
+    std::size_t highWater{1024}; /* Queued messages (also the queue's capacity) */
+    std::size_t lowWater{768};
+    std::size_t blockTimeoutMS{5000}; /* Block: longest wait before the peer counts as a slow consumer */
+
+    /* Same format as parse() */
+    [[nodiscard]] std::string describe() const;
+
+    /* Policy from defaults overridden by spec. Throws std::runtime_error if malformed */
+    static BackpressurePolicy parse(std::string_view spec);
+};
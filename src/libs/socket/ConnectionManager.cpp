@@ -8,9 +8,17 @@
  */
 
 #include "ConnectionManager.hpp"
+#include "IoUring.hpp"
+#include "fix/FixFrameDecoder.hpp"
 #include "logger/Logger.hpp"
+#include "utilities/ThreadTuning.hpp"
+#include <algorithm>
 #include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
 #include <cstring>
+#include <deque>
+#include <fcntl.h>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -19,14 +27,34 @@
 #include <poll.h>
 #include <signal.h>
 #include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <thread>
 #include <unistd.h>
 
 
+ConnectionManager::ConnectionManager()
+    : _shutdownFD(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), _sessionEventFD(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    if (_shutdownFD == (-1) || _sessionEventFD == (-1))
+    {
+        if (_shutdownFD != (-1))
+            close(_shutdownFD);
+        if (_sessionEventFD != (-1))
+            close(_sessionEventFD);
+
+        throw std::runtime_error("Failed to create eventfd: " + std::string(std::strerror(errno)));
+    }
+}
+
+
 ConnectionManager::~ConnectionManager()
 {
     stop();
     wait(); /* Ensure logger has shutdown */
+
+    close(_shutdownFD);
+    close(_sessionEventFD);
 }
 
 
@@ -39,12 +67,32 @@ void ConnectionManager::start()
 
     _active = true;
 
+    uint64_t count;
+    while (read(_shutdownFD, &count, sizeof(count)) > 0) /* Reset from any previous stop() */
+    {
+    }
+
     /* Startup logger */
     Logger::instance().start();
     Logger::instance().info("Starting-up server...");
 
-    /* Create thread for processing received messages */
-    _handleMessageLoopThread = std::thread(&ConnectionManager::handleMessageLoop, this);
+    /* Create threads for processing received messages */
+    _handlerShards.clear();
+    for (std::size_t i = 0; i < std::max<std::size_t>(_nHandlerThreads, 1); ++i)
+    {
+        _handlerShards.push_back(std::make_unique<HandlerShard>(_lowLatency.busySpin ? Doorbell::WaitStrategy::Spin : _ingressWaitStrategy, i));
+    }
+
+    for (auto &shard : _handlerShards)
+    {
+        shard->thread = std::thread(&ConnectionManager::handleMessageLoop, this, std::ref(*shard));
+    }
+
+    /* Create event-loops before any sessions are added */
+    if (_nReactorThreads > 0)
+    {
+        startReactors();
+    }
 
     /* Create thread for cleaning up inactive connections */
     _cleanupInactiveSessionsThread = std::thread(&ConnectionManager::cleanupInactiveSessionsLoop, this);
@@ -58,11 +106,16 @@ void ConnectionManager::start()
 
 void ConnectionManager::wait()
 {
-    if (_handleMessageLoopThread.joinable())
-        _handleMessageLoopThread.join();
+    for (auto &shard : _handlerShards) /* NB: may be called from a handler (e.g. netadmin shutdown) */
+    {
+        if (shard->thread.joinable() && std::this_thread::get_id() != shard->thread.get_id())
+            shard->thread.join();
+    }
     if (_cleanupInactiveSessionsThread.joinable())
         _cleanupInactiveSessionsThread.join();
 
+    waitReactors();
+
     onWait(); /* Wait hook for subclasses */
 
     Logger::instance().wait();
@@ -78,12 +131,18 @@ void ConnectionManager::stop()
 
     Logger::instance().info("Shutting-down server...");
 
-    _active = false;                  /* Listening, cleanup loops poll regularly => shutdown on _active=false */
-    _incomingMsgQueueCV.notify_all(); /* Trigger handleMessageLoop shutdown */
+    _active = false;
+    notifyEventFD(_shutdownFD);        /* Wakes listening loop */
+    for (auto &shard : _handlerShards) /* Trigger handleMessageLoop shutdown */
+    {
+        shard->doorbell.ring();
+    }
+    stopReactors();
 
     /* Cleanup all sessions now marked as inactive */
     markAllSessionsAsInactive();
     cleanupInactiveSessions();
+    notifyEventFD(_sessionEventFD); /* Cleanup thread exits */
 
     onShutdown(); /* Shutdown hook (note: prior to logger shutdown) */
 
@@ -93,47 +152,69 @@ void ConnectionManager::stop()
 }
 
 
-bool ConnectionManager::connectToServer(Port serverPort)
+bool ConnectionManager::connectToServer(const SocketAddress &serverAddress)
 {
     /* Address of server we would like to connect to */
-    SocketFD serverSocket = socket(AF_INET, SOCK_STREAM, 0);
+    SocketFD serverSocket = serverAddress.openSocket();
     if (serverSocket == (-1))
     {
-        Logger::instance().log("Failed to create socket for port " + std::to_string(serverPort), Logger::Error);
+        Logger::instance().log("Failed to create socket for " + serverAddress.toString(), Logger::Error);
         return false;
     }
 
-    sockaddr_in serverAddress;
+    /* Before connect() so buffer sizes apply to the handshake (window scaling) */
+    auto iter = _outboundSocketOptions.find(serverAddress.toString());
+    (iter != _outboundSocketOptions.end() ? iter->second : _socketOptions).apply(serverSocket);
 
-    serverAddress.sin_family = AF_INET;                     /* IPV4 */
-    serverAddress.sin_port = htons(serverPort);             /* Port */
-    serverAddress.sin_addr.s_addr = inet_addr("127.0.0.1"); /* Connect to localhost */
+    sockaddr_storage address;
+    socklen_t addressLength = serverAddress.toSockaddr(address, true); /* Connect to localhost */
 
-    if (connect(serverSocket, (const struct sockaddr *)&serverAddress, sizeof(serverAddress)) == (-1))
+    if (connect(serverSocket, reinterpret_cast<const struct sockaddr *>(&address), addressLength) == (-1))
     {
-        Logger::instance().log("Failed to establish connection to server (socket: " + std::to_string(serverSocket) + ")", Logger::Error);
+        Logger::instance().log("Failed to establish connection to server " + serverAddress.toString() + " (socket: " + std::to_string(serverSocket) + ")", Logger::Error);
+        close(serverSocket);
         return false;
     }
 
+    std::unique_ptr<ShmChannel> channel;
+
+    if (serverAddress.isSharedMemory())
+    {
+        try
+        {
+            channel = ShmChannel::accept(serverSocket); /* Server sends the rings on accept */
+        }
+        catch (const std::exception &e)
+        {
+            Logger::instance().log("Failed to open shared-memory channel to server " + serverAddress.toString() + ": " + e.what(), Logger::Error);
+            close(serverSocket);
+            return false;
+        }
+    }
+
     /* Register */
-    _portSocketMappings.update(serverPort, serverSocket);
+    _portSocketMappings.update(serverAddress, serverSocket);
 
-    Logger::instance().log("Established connection to server (socket: " + std::to_string(serverSocket) + ")");
-    addClientSession(serverSocket);
+    Logger::instance().log("Established connection to server " + serverAddress.toString() + " (socket: " + std::to_string(serverSocket) + ")");
+    auto policy = _outboundBackpressure.find(serverAddress.toString());
+    addClientSession(serverSocket, std::move(channel), policy != _outboundBackpressure.end() ? std::make_optional(policy->second) : std::nullopt);
     return true;
 }
 
 
-void ConnectionManager::handleMessageLoop()
+void ConnectionManager::handleMessageLoop(HandlerShard &shard)
 {
     Logger::instance().info("Starting handleMessageLoop");
+    tuneThread(_lowLatency.handlerCpus, shard.index);
+
+    std::vector<ClientMessage> batch; /* Reused between wake-ups */
+    batch.reserve(MaxHandleBatch);
 
     while (true) /* Run for server lifetime */
     {
-        std::unique_lock lock(_incomingMsgQueueMutex); /* Wait until we have messages in the queue */
-        _incomingMsgQueueCV.wait(lock, [this]()
+        shard.doorbell.wait([this, &shard]()
         {
-            return (!_active || !_incomingMsgQueue.empty());
+            return (!_active || !shard.queue.empty());
         });
 
         if (!_active)
@@ -141,17 +222,58 @@ void ConnectionManager::handleMessageLoop()
             break;
         }
 
-        auto clientMessage = _incomingMsgQueue.front();
-        _incomingMsgQueue.pop();
+        shard.queue.popBatch(batch, MaxHandleBatch);
+
+        for (auto &clientMessage : batch) /* Queue is not locked while handling */
+        {
+            handleMessage(std::move(clientMessage.first), clientMessage.second);
+        }
 
-        handleMessage(std::move(clientMessage.first), clientMessage.second);
+        shard.messagesHandled.fetch_add(batch.size(), std::memory_order_relaxed);
+        shard.wakeups.fetch_add(1, std::memory_order_relaxed);
+        batch.clear();
     }
 
     Logger::instance().info("Shutting-down handleMessageLoop");
 }
 
 
-void ConnectionManager::addClientSession(SocketFD clientSocket)
+std::size_t ConnectionManager::shardKey(const Message &, SocketFD fromSocket) const
+{
+    return static_cast<std::size_t>(fromSocket);
+}
+
+
+void ConnectionManager::setHandlerThreads(std::size_t nThreads)
+{
+    if (_active)
+    {
+        Logger::instance().error("Handler threads must be set before start() => Ignoring.");
+        return;
+    }
+
+    _nHandlerThreads = std::max<std::size_t>(nThreads, 1);
+}
+
+
+std::vector<ConnectionManager::HandlerShardStats> ConnectionManager::handlerShardStats() const
+{
+    std::vector<HandlerShardStats> result;
+    result.reserve(_handlerShards.size());
+
+    for (const auto &shard : _handlerShards)
+    {
+        HandlerShardStats stats;
+        stats.messages = shard->messagesHandled.load(std::memory_order_relaxed);
+        stats.wakeups = shard->wakeups.load(std::memory_order_relaxed);
+        result.push_back(stats);
+    }
+
+    return result;
+}
+
+
+void ConnectionManager::addClientSession(SocketFD clientSocket, std::unique_ptr<ShmChannel> channel, std::optional<BackpressurePolicy> backpressure)
 {
     if (clientSocket == (-1))
     {
@@ -159,9 +281,49 @@ void ConnectionManager::addClientSession(SocketFD clientSocket)
         return;
     }
 
-    auto session = std::make_unique<ClientSession>(clientSocket);
+    auto session = std::make_shared<ClientSession>(clientSocket, backpressure.value_or(_backpressure));
+    session->index = _nSessionsCreated.fetch_add(1, std::memory_order_relaxed);
+
+    int socketType = 0;
+    socklen_t length = sizeof(socketType);
+    session->seqPacket = (getsockopt(clientSocket, SOL_SOCKET, SO_TYPE, &socketType, &length) == 0 && socketType == SOCK_SEQPACKET);
     session->active = true;
 
+    if (_lowLatency.busySpin)
+    {
+        session->outgoingDoorbell.setStrategy(Doorbell::WaitStrategy::Spin);
+    }
+
+    if (channel) /* Own receive thread in every mode: there is nothing for a reactor to wait on */
+    {
+        session->shm = std::move(channel);
+        ClientSession &sessionRef = *session;
+
+        std::unique_lock lock(_clientSessionMutex); /* NB: insert first => replies to the first message find the session */
+        _clientSessionMap[clientSocket] = std::move(session);
+        sessionRef.connectionThread = std::thread(&ConnectionManager::shmReceiveLoop, this, std::ref(sessionRef));
+        return;
+    }
+
+    if (!_reactors.empty())
+    {
+        ClientSession &sessionRef = *session;
+
+        {
+            std::unique_lock lock(_clientSessionMutex);
+            _clientSessionMap[clientSocket] = std::move(session);
+        }
+
+        registerWithReactor(sessionRef); /* NB: after insertion so events can find the session */
+        return;
+    }
+
+    session->sendWakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (session->sendWakeFD == (-1))
+    {
+        Logger::instance().error("Failed to create sender wake-up eventfd: closing waits poll (socket: " + std::to_string(clientSocket) + ")");
+    }
+
     session->connectionThread = std::thread(&ConnectionManager::connectionLoop, this, std::ref(*session));
     session->senderThread = std::thread(&ConnectionManager::senderLoop, this, std::ref(*session));
 
@@ -174,10 +336,19 @@ void ConnectionManager::addClientSession(SocketFD clientSocket)
 
 void ConnectionManager::markSessionAsInactive(ClientSession &session)
 {
-    if (session.active)
+    if (session.active.exchange(false))
     {
-        session.active = false;
-        session.outgoingCV.notify_all(); /* Notify all loops which will shutdown */
+        session.outgoingDoorbell.ring();           /* Wake sender loop which will shutdown */
+        if (session.sendWakeFD != (-1))
+            notifyEventFD(session.sendWakeFD);     /* Sender waiting on a peer that stopped reading */
+        shutdown(session.clientSocket, SHUT_RD);   /* Wake connection loop (recv() returns 0). Peer is told on close */
+
+        if (session.shm)
+            session.shm->close(); /* Tell peer and wake receive loop */
+
+        notifyDrained(session); /* Release blocked producers */
+
+        notifyEventFD(_sessionEventFD); /* Cleanup now rather than on a timer */
     }
 }
 
@@ -194,30 +365,43 @@ void ConnectionManager::markAllSessionsAsInactive()
 
 void ConnectionManager::cleanupInactiveSessions()
 {
-    std::unique_lock lock(_clientSessionMutex);
+    std::vector<std::shared_ptr<ClientSession>> inactiveSessions;
 
-    for (auto iter = _clientSessionMap.begin(); iter != _clientSessionMap.end();)
     {
-        auto &session = iter->second;
+        std::unique_lock lock(_clientSessionMutex); /* Only while unlinking: no new references after this */
 
-        if (!session->active)
+        for (auto iter = _clientSessionMap.begin(); iter != _clientSessionMap.end();)
         {
-            Logger::instance().info("Cleaning-up session (socket: " + std::to_string(session->clientSocket) + ")");
-            if (session->connectionThread.joinable() && std::this_thread::get_id() != session->connectionThread.get_id())
-                session->connectionThread.join();
-            if (session->senderThread.joinable() && std::this_thread::get_id() != session->senderThread.get_id())
-                session->senderThread.join();
+            if (!iter->second->active)
+            {
+                inactiveSessions.push_back(std::move(iter->second));
+                iter = _clientSessionMap.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
 
-            closeSocket(session->clientSocket);
+    for (auto &session : inactiveSessions) /* Joins without the lock so sendMessage() callers never stall */
+    {
+        Logger::instance().info("Cleaning-up session (socket: " + std::to_string(session->clientSocket) + ")");
+        if (session->connectionThread.joinable() && std::this_thread::get_id() != session->connectionThread.get_id())
+            session->connectionThread.join();
+        if (session->senderThread.joinable() && std::this_thread::get_id() != session->senderThread.get_id())
+            session->senderThread.join();
 
-            _portSocketMappings.erase(session->clientSocket);
+        if (!_reactors.empty() && !session->shm)
+            unregisterFromReactor(*session);
 
-            iter = _clientSessionMap.erase(iter);
-        }
-        else
-        {
-            ++iter;
-        }
+        onSessionClosed(session->clientSocket);
+
+        closeSocket(session->clientSocket); /* NB: after unlinking so a reused descriptor cannot match this session */
+        if (session->sendWakeFD != (-1))
+            close(session->sendWakeFD);
+
+        _portSocketMappings.erase(session->clientSocket);
     }
 }
 
@@ -226,9 +410,23 @@ void ConnectionManager::cleanupInactiveSessionsLoop()
 {
     Logger::instance().info("Starting cleanup inactive sessions loop");
 
+    struct pollfd fds;
+    fds.fd = _sessionEventFD;
+    fds.events = POLLIN;
+
     while (_active)
     {
-        std::this_thread::sleep_for(std::chrono::seconds(5));
+        if (poll(&fds, 1, -1) == (-1) && errno != EINTR)
+        {
+            Logger::instance().error("A polling error occurred (eventfd: " + std::to_string(_sessionEventFD) + ")");
+            break;
+        }
+
+        uint64_t count;
+        while (read(_sessionEventFD, &count, sizeof(count)) > 0) /* Drain: one sweep covers every posted session */
+        {
+        }
+
         cleanupInactiveSessions();
     }
 
@@ -236,14 +434,26 @@ void ConnectionManager::cleanupInactiveSessionsLoop()
 }
 
 
-// TODO: - extend with 2 threads for handleFixMsg() -> need to both be able to routed corrections/cancellations
+void ConnectionManager::notifyEventFD(int eventFD)
+{
+    uint64_t one = 1;
+    if (write(eventFD, &one, sizeof(one)) == (-1) && errno != EAGAIN)
+    {
+        Logger::instance().error("Failed to signal eventfd " + std::to_string(eventFD) + ": " + std::strerror(errno));
+    }
+}
+
+
 // TODO: - netadmin should be able to send shutdown
 
 void ConnectionManager::connectionLoop(ClientSession &session)
 {
     Logger::instance().info("Starting connection loop (socket: " + std::to_string(session.clientSocket) + ")");
+    tuneThread(_lowLatency.receiveCpus, session.index);
+
+    const int pollTimeout = (_lowLatency.busySpin ? 0 : (-1)); /* Busy-spin or block: markSessionAsInactive() wakes us */
 
-    char messageBuffer[2048];
+    std::vector<ClientMessage> batch; /* Reused between reads */
 
     struct pollfd fds;
     fds.fd = session.clientSocket;
@@ -251,7 +461,7 @@ void ConnectionManager::connectionLoop(ClientSession &session)
 
     while (session.active) /* Run for session lifetime */
     {
-        int pollResult = poll(&fds, 1, 1000); /* polls once per second */
+        int pollResult = poll(&fds, 1, pollTimeout);
 
         if (pollResult == 0) /* No new data */
         {
@@ -263,17 +473,21 @@ void ConnectionManager::connectionLoop(ClientSession &session)
             continue;
         }
 
-        /* Wipe buffer */
-        memset(messageBuffer, 0, 2048);
+        session.receiveBuffer.reserve(session.seqPacket ? MaxRecordSize : MinReceiveSize); /* Whole record or it is truncated */
 
-        long nBytesRead = recv(session.clientSocket, messageBuffer, 2047, 0);
+        long nBytesRead = recv(session.clientSocket, session.receiveBuffer.writePtr(), session.receiveBuffer.writable(), session.seqPacket ? MSG_TRUNC : 0);
 
-        if (nBytesRead == 0)
+        if (nBytesRead > static_cast<long>(session.receiveBuffer.writable())) /* MSG_TRUNC: record larger than MaxRecordSize */
+        {
+            Logger::instance().error("Closing session: " + std::to_string(nBytesRead) + "-byte record truncated (socket: " + std::to_string(session.clientSocket) + ")");
+            markSessionAsInactive(session);
+            break;
+        }
+        else if (nBytesRead == 0)
         {
             /* Orderly shutdown: -> need to send signal to senderThread and erase session from map */
             Logger::instance().info("Client connection has closed (socket: " + std::to_string(session.clientSocket) + ")");
-            session.active = false;          /* Mark as inactive to initiate shutdown of sender loop */
-            session.outgoingCV.notify_all(); /* Notify all loops */
+            markSessionAsInactive(session); /* Initiate shutdown of sender loop */
             break;
         }
         else if (nBytesRead == (-1))
@@ -283,14 +497,9 @@ void ConnectionManager::connectionLoop(ClientSession &session)
         }
         else if (nBytesRead > 0)
         {
-            auto clientMessage = std::pair(std::string(messageBuffer, nBytesRead), session.clientSocket);
-
-            {
-                std::unique_lock incomingMsgQueueLock(_incomingMsgQueueMutex);
-                _incomingMsgQueue.push(std::move(clientMessage));
-            } /* Unlock */
-
-            _incomingMsgQueueCV.notify_one(); /* Notify the message queue loop to handle the received message */
+            session.receiveBuffer.commit(nBytesRead);
+            extractReceivedFrames(session, batch);
+            queueBatch(batch);
         }
     }
 
@@ -298,136 +507,1720 @@ void ConnectionManager::connectionLoop(ClientSession &session)
 }
 
 
-void ConnectionManager::senderLoop(ClientSession &session)
+void ConnectionManager::shmReceiveLoop(ClientSession &session)
 {
-    Logger::instance().info("Starting sender loop (socket: " + std::to_string(session.clientSocket) + ")");
+    Logger::instance().info("Starting shared-memory receive loop (socket: " + std::to_string(session.clientSocket) + ")");
+    tuneThread(_lowLatency.receiveCpus, session.index);
 
-    while (session.active)
+    const auto strategy = (_lowLatency.busySpin ? Doorbell::WaitStrategy::Spin : Doorbell::defaultStrategy());
+
+    ShmChannel &channel = *session.shm;
+    std::vector<ClientMessage> batch; /* Reused between reads */
+
+    while (session.active) /* Run for session lifetime */
     {
-        std::unique_lock lock(session.outgoingMutex);
-        session.outgoingCV.wait(lock, [this, &session]()
+        if (!channel.waitReadable(session.clientSocket, strategy))
         {
-            return (!session.active || !session.outgoingMsgQueue.empty()); /* No longer active or messages to send */
-        });
+            if (channel.corrupted())
+                Logger::instance().error("Shared-memory ring positions corrupted: closing (socket: " + std::to_string(session.clientSocket) + ")");
+            else
+                Logger::instance().info("Shared-memory peer has closed (socket: " + std::to_string(session.clientSocket) + ")");
+            markSessionAsInactive(session);
+            break;
+        }
 
-        if (!session.active)
+        std::size_t nReadable = channel.readable();
+        if (nReadable == 0) /* Woken for shutdown */
         {
-            break;
+            continue;
         }
 
-        auto message = session.outgoingMsgQueue.front();
+        session.receiveBuffer.reserve(std::max(nReadable, MinReceiveSize));
+        session.receiveBuffer.commit(channel.read(session.receiveBuffer.writePtr(), session.receiveBuffer.writable()));
 
-        long nBytesSent = send(session.clientSocket, message.c_str(), message.size(), 0);
+        extractReceivedFrames(session, batch);
+        queueBatch(batch);
+    }
+
+    Logger::instance().info("Shutting-down shared-memory receive loop (socket: " + std::to_string(session.clientSocket) + ")");
+}
+
+
+void ConnectionManager::sendOverSharedMemory(ClientSession &session, const Message &message)
+{
+    ShmChannel &channel = *session.shm;
+
+    if (message.size() > ShmChannel::RingCapacity)
+    {
+        Logger::instance().log("Message too large for shared-memory channel (socket: " + std::to_string(session.clientSocket) + ")", Logger::Error);
+        return;
+    }
+
+    std::lock_guard lock(channel.writeMutex()); /* Other producers sleep on this while we wait */
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(session.backpressure.blockTimeoutMS);
+
+    for (unsigned attempt = 0; !channel.tryWrite(message.data(), message.size()); ++attempt) /* Full => apply policy (watermarks do not apply to the ring) */
+    {
+        if (session.backpressure.action != BackpressurePolicy::Action::Block)
+        {
+            session.messagesDropped.fetch_add(1, std::memory_order_relaxed);
+
+            if (session.backpressure.action == BackpressurePolicy::Action::Disconnect && session.active)
+            {
+                Logger::instance().error("Disconnecting slow consumer (socket: " + std::to_string(session.clientSocket) + ")");
+                markSessionAsInactive(session);
+            }
+            return;
+        }
 
-        if (nBytesSent == (-1) || nBytesSent < static_cast<long>(message.size()))
+        if (!session.active || channel.peerClosed())
         {
-            Logger::instance().log("Failed to send message (destination: " + std::to_string(session.clientSocket) + "): " + message, Logger::Error);
+            Logger::instance().log("Shared-memory session closed with full ring (socket: " + std::to_string(session.clientSocket) + ")", Logger::Error);
+            return;
         }
-        else /* Sent successfully! */
+
+        if (std::chrono::steady_clock::now() >= deadline)
         {
-            session.outgoingMsgQueue.pop();
+            session.messagesDropped.fetch_add(1, std::memory_order_relaxed);
+            Logger::instance().error("Disconnecting slow consumer: shared-memory ring full for " + std::to_string(session.backpressure.blockTimeoutMS) +
+                                     "ms (socket: " + std::to_string(session.clientSocket) + ")");
+            markSessionAsInactive(session);
+            return;
         }
+
+        /* The peer's reader never signals us: back off (1us doubling to 1ms) rather than spin */
+        channel.notifyPeer();
+        std::this_thread::sleep_for(std::chrono::microseconds(1u << std::min(attempt, 10u)));
     }
 
-    Logger::instance().info("Shutting-down sender loop (socket: " + std::to_string(session.clientSocket) + ")");
+    channel.notifyPeer();
+
+    /* No syscall: sendSyscalls is left unchanged */
+    session.messagesSent.fetch_add(1, std::memory_order_relaxed);
+    session.bytesSent.fetch_add(message.size(), std::memory_order_relaxed);
 }
 
 
-void ConnectionManager::sendMessage(Message message, SocketFD clientSocket)
+void ConnectionManager::extractReceivedFrames(ClientSession &session, std::vector<ClientMessage> &batch)
 {
-    std::shared_lock lock(_clientSessionMutex);
-    auto iter = _clientSessionMap.find(clientSocket);
-    if (iter == _clientSessionMap.end())
+    ReceiveBuffer &buffer = session.receiveBuffer;
+
+    while (buffer.readable().size() > 0)
     {
-        Logger::instance().log("No registered client socket " + std::to_string(clientSocket), Logger::Error);
-        return;
+        auto [status, length] = FixFrameDecoder::decode(buffer.readable());
+
+        if (status == FixFrameDecoder::Incomplete)
+        {
+            break;
+        }
+        else if (status == FixFrameDecoder::Corrupt)
+        {
+            Logger::instance().error("Discarding " + std::to_string(length) + " unframed bytes (socket: " + std::to_string(session.clientSocket) + ")");
+        }
+        else if (status == FixFrameDecoder::Invalid)
+        {
+            Logger::instance().error("Discarding message with invalid CheckSum (socket: " + std::to_string(session.clientSocket) + "): " + std::string(buffer.readable().substr(0, length)));
+        }
+        else
+        {
+            batch.emplace_back(Message(buffer.readable().substr(0, length)), session.clientSocket);
+        }
+
+        buffer.consume(length);
     }
+}
 
-    if (!iter->second->active)
+
+void ConnectionManager::queueBatch(std::vector<ClientMessage> &batch)
+{
+    if (batch.empty())
     {
-        Logger::instance().log("Client session is inactive (socket: " + std::to_string(clientSocket) + ")", Logger::Error);
         return;
     }
 
+    for (auto &clientMessage : batch)
     {
-        std::lock_guard queueLock(iter->second->outgoingMutex); /* Acquire lock and push onto outgoing queue */
-        iter->second->outgoingMsgQueue.push(std::move(message));
+        if (admitIncoming(clientMessage.first, clientMessage.second) && !pushIncoming(clientMessage))
+            break; /* Handlers stopping: the rest of the batch would never be taken */
     }
 
-    iter->second->outgoingCV.notify_one();
+    batch.clear();
+
+    if (_handlerShards.size() == 1)
+        _handlerShards[0]->doorbell.ring(); /* Notify the message queue loop to handle the received messages */
 }
 
 
-void ConnectionManager::closeSocket(SocketFD socket)
+void ConnectionManager::queueIncoming(Message message, SocketFD fromSocket)
 {
-    if (close(socket) == (-1))
+    ClientMessage clientMessage(std::move(message), fromSocket);
+
+    if (pushIncoming(clientMessage) && _handlerShards.size() == 1)
+        _handlerShards[0]->doorbell.ring();
+}
+
+
+bool ConnectionManager::pushIncoming(ClientMessage &clientMessage)
+{
+    const std::size_t nShards = _handlerShards.size();
+    HandlerShard &shard = *_handlerShards[nShards == 1 ? 0 : shardKey(clientMessage.first, clientMessage.second) % nShards];
+
+    while (!shard.queue.tryPush(std::move(clientMessage))) /* Full => wait for handleMessageLoop */
     {
-        Logger::instance().error("Failed to close socket: " + std::to_string(socket));
+        if (!_active)
+            return false;
+
+        shard.doorbell.ring();
+        std::this_thread::yield();
     }
-    else
+
+    if (nShards > 1)
+        shard.doorbell.ring();
+
+    return true;
+}
+
+
+void ConnectionManager::setIngressWaitStrategy(Doorbell::WaitStrategy strategy)
+{
+    if (_active)
     {
-        Logger::instance().info("Closed socket: " + std::to_string(socket));
+        Logger::instance().error("Ingress wait strategy must be set before start() => Ignoring.");
+        return;
     }
+
+    _ingressWaitStrategy = strategy;
 }
 
 
-void ConnectionManager::PortSocketMappings::clear()
+void ConnectionManager::setLowLatencyConfig(LowLatencyConfig config)
 {
-    std::unique_lock lock(_portSocketMutex);
-    _portToSocket.clear();
-    _socketToPort.clear();
+    if (_active)
+    {
+        Logger::instance().error("Low-latency config must be set before start() => Ignoring.");
+        return;
+    }
+
+    _lowLatency = std::move(config);
 }
 
 
-void ConnectionManager::PortSocketMappings::update(Port port, SocketFD socket)
+void ConnectionManager::setSocketOptions(SocketOptions options)
 {
-    std::unique_lock lock(_portSocketMutex);
-    _portToSocket[port] = socket;
-    _socketToPort[socket] = port;
+    if (_active)
+    {
+        Logger::instance().error("Socket options must be set before start() => Ignoring.");
+        return;
+    }
+
+    _socketOptions = options;
 }
 
 
-ConnectionManager::Port ConnectionManager::PortSocketMappings::getPort(SocketFD socket) const
+void ConnectionManager::setSocketOptions(const SocketAddress &serverAddress, SocketOptions options)
 {
-    std::shared_lock lock(_portSocketMutex);
+    _outboundSocketOptions[serverAddress.toString()] = options;
+}
+
+
+void ConnectionManager::setBackpressurePolicy(BackpressurePolicy policy)
+{
+    if (_active)
+    {
+        Logger::instance().error("Backpressure policy must be set before start() => Ignoring.");
+        return;
+    }
+
+    _backpressure = policy;
+}
 
-    auto iter = _socketToPort.find(socket);
 
-    return (iter != _socketToPort.end()) ? iter->second : 0;
+void ConnectionManager::setBackpressurePolicy(const SocketAddress &serverAddress, BackpressurePolicy policy)
+{
+    _outboundBackpressure[serverAddress.toString()] = policy;
 }
 
 
-ConnectionManager::SocketFD ConnectionManager::PortSocketMappings::getSocket(Port port) const
+std::vector<std::pair<ConnectionManager::SocketFD, ConnectionManager::OutgoingQueueStats>> ConnectionManager::outgoingQueueStats()
 {
-    std::shared_lock lock(_portSocketMutex);
+    std::vector<std::pair<SocketFD, OutgoingQueueStats>> result;
+
+    {
+        std::shared_lock lock(_clientSessionMutex);
+        result.reserve(_clientSessionMap.size());
 
-    auto iter = _portToSocket.find(port);
+        for (const auto &[socket, session] : _clientSessionMap)
+        {
+            OutgoingQueueStats stats;
+            stats.depth = session->outgoingDepth.load(std::memory_order_relaxed);
+            stats.dropped = session->messagesDropped.load(std::memory_order_relaxed);
+            stats.congestionEvents = session->congestionEvents.load(std::memory_order_relaxed);
+            stats.congested = session->congested.load(std::memory_order_relaxed);
+            stats.policy = session->backpressure;
+            result.emplace_back(socket, stats);
+        }
+    }
 
-    return (iter != _portToSocket.end()) ? iter->second : (-1);
+    std::sort(result.begin(), result.end(), [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    return result;
 }
 
 
-std::vector<ConnectionManager::SocketFD> ConnectionManager::PortSocketMappings::getSockets() const
+std::vector<std::pair<ConnectionManager::SocketFD, std::string>> ConnectionManager::socketOptionsReport()
 {
-    std::shared_lock lock(_portSocketMutex);
-
-    std::vector<SocketFD> sockets;
-    sockets.reserve(_socketToPort.size());
+    std::vector<std::pair<SocketFD, std::string>> result;
 
-    for (auto iter = _socketToPort.begin(); iter != _socketToPort.end(); ++iter)
     {
-        sockets.push_back(iter->first);
+        std::shared_lock lock(_clientSessionMutex);
+        result.reserve(_clientSessionMap.size());
+
+        for (const auto &[socket, session] : _clientSessionMap)
+        {
+            result.emplace_back(socket, SocketOptions::describe(socket));
+        }
     }
 
-    return sockets;
+    std::sort(result.begin(), result.end(), [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    return result;
 }
 
 
-void ConnectionManager::PortSocketMappings::erase(SocketFD socket)
+void ConnectionManager::tuneThread(const std::vector<int> &cpus, std::size_t index) const
+{
+    int cpu = ThreadTuning::select(cpus, index);
+
+    if (cpu >= 0) /* SCHED_FIFO only on pinned threads so a spinning thread cannot starve arbitrary cores */
+    {
+        ThreadTuning::apply(cpu, _lowLatency.fifoPriority);
+    }
+}
+
+
+void ConnectionManager::senderLoop(ClientSession &session)
 {
-    Port port = getPort(socket);
+    Logger::instance().info("Starting sender loop (socket: " + std::to_string(session.clientSocket) + ")");
+    tuneThread(_lowLatency.senderCpus, session.index);
+
+    std::vector<OutgoingMessage> batch; /* Reused between wake-ups */
+    std::vector<struct iovec> iov;
+
+    while (session.active)
+    {
+        session.outgoingDoorbell.wait([&session]()
+        {
+            return (!session.active || !session.outgoingQueue.empty()); /* No longer active or messages to send */
+        });
+
+        if (!session.active)
+        {
+            break;
+        }
+
+        /* Take everything queued (up to one sendmsg) so producers can refill while we send */
+        releaseOutgoing(session, session.outgoingQueue.popBatch(batch, MaxSendIovecs));
+
+        if (!sendBatch(session, batch, iov))
+        {
+            Logger::instance().log("Failed to send " + std::to_string(batch.size()) + " message(s) (destination: " + std::to_string(session.clientSocket) + ")", Logger::Error);
+            markSessionAsInactive(session);
+        }
+
+        batch.clear();
+    }
+
+    /* Best effort: replies queued just before closing (e.g. to netadmin shutdown) without blocking teardown */
+    std::size_t nRemaining = session.outgoingQueue.popBatch(batch, MaxSendIovecs);
+    releaseOutgoing(session, nRemaining);
+
+    if (nRemaining > 0)
+    {
+        sendBatch(session, batch, iov, MSG_DONTWAIT);
+    }
+
+    Logger::instance().info("Shutting-down sender loop (socket: " + std::to_string(session.clientSocket) + ")");
+}
+
+
+template <typename Messages>
+std::size_t ConnectionManager::gatherIovecs(const ClientSession &session, const Messages &messages, std::size_t first, std::size_t offset, struct iovec *iov)
+{
+    std::size_t nIovecs = 0;
+    std::size_t nBytes = 0;
+
+    for (std::size_t i = first; i < messages.size() && nIovecs < MaxSendIovecs; ++i, ++nIovecs)
+    {
+        std::size_t skip = (i == first ? offset : 0);
+        std::size_t length = messages[i].size() - skip;
+
+        if (session.seqPacket)
+        {
+            if (nIovecs > 0 && nBytes + length > MaxRecordSize) /* Record full */
+                break;
+
+            length = std::min(length, MaxRecordSize); /* Larger message spans records: the receiver reassembles it */
+        }
+
+        iov[nIovecs].iov_base = const_cast<char *>(messages[i].data()) + skip;
+        iov[nIovecs].iov_len = length;
+        nBytes += length;
+    }
+
+    return nIovecs;
+}
+
+
+template <typename Messages>
+std::size_t ConnectionManager::advanceSent(const Messages &messages, std::size_t &first, std::size_t &offset, std::size_t nBytes)
+{
+    std::size_t nMessagesSent = 0;
+
+    for (std::size_t remaining = nBytes; remaining > 0;)
+    {
+        std::size_t left = messages[first].size() - offset;
+
+        if (remaining < left)
+        {
+            offset += remaining;
+            break;
+        }
+
+        remaining -= left;
+        offset = 0;
+        ++first;
+        ++nMessagesSent;
+    }
+
+    return nMessagesSent;
+}
+
+
+bool ConnectionManager::sendBatch(ClientSession &session, const std::vector<OutgoingMessage> &batch, std::vector<struct iovec> &iov, int flags)
+{
+    std::size_t first = 0;  /* First message not fully sent */
+    std::size_t offset = 0; /* Bytes of batch[first] already sent */
+
+    iov.resize(MaxSendIovecs);
+
+    while (first < batch.size())
+    {
+        struct msghdr msg{};
+        msg.msg_iov = iov.data();
+        msg.msg_iovlen = gatherIovecs(session, batch, first, offset, iov.data());
+
+        long nBytesSent = sendmsg(session.clientSocket, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+        if (nBytesSent == (-1))
+        {
+            if (errno == EINTR)
+                continue;
+
+            if ((errno == EAGAIN || errno == EWOULDBLOCK) && !(flags & MSG_DONTWAIT) && waitWritable(session)) /* Never blocks in sendmsg() past close */
+                continue;
+
+            return false;
+        }
+
+        /* Short write => resume from the first unsent byte */
+        std::size_t nMessagesSent = advanceSent(batch, first, offset, static_cast<std::size_t>(nBytesSent));
+        recordSend(session, static_cast<std::size_t>(nBytesSent), nMessagesSent);
+    }
+
+    return true;
+}
+
+
+bool ConnectionManager::waitWritable(ClientSession &session)
+{
+    /* Without a wake-up eventfd (creation failed) fall back to rechecking the session periodically */
+    constexpr int RecheckMS = 100;
+
+    struct pollfd fds[2] = {{session.clientSocket, POLLOUT, 0}, {session.sendWakeFD, POLLIN, 0}}; /* NB: poll() ignores fd -1 */
+
+    while (session.active)
+    {
+        int nReady = poll(fds, 2, session.sendWakeFD == (-1) ? RecheckMS : -1);
+
+        if (nReady == (-1) && errno != EINTR)
+            return false;
+
+        if (nReady > 0 && fds[0].revents != 0) /* Writable, or an error for sendmsg() to report */
+            return true;
+    }
+
+    return false;
+}
+
+
+void ConnectionManager::recordSend(ClientSession &session, std::size_t nBytes, std::size_t nMessages)
+{
+    session.sendSyscalls.fetch_add(1, std::memory_order_relaxed);
+    session.messagesSent.fetch_add(nMessages, std::memory_order_relaxed);
+    session.bytesSent.fetch_add(nBytes, std::memory_order_relaxed);
+}
+
+
+std::vector<std::pair<ConnectionManager::SocketFD, ConnectionManager::SendStats>> ConnectionManager::sendStats()
+{
+    std::vector<std::pair<SocketFD, SendStats>> result;
+
+    {
+        std::shared_lock lock(_clientSessionMutex);
+        result.reserve(_clientSessionMap.size());
+
+        for (const auto &[socket, session] : _clientSessionMap)
+        {
+            SendStats stats;
+            stats.syscalls = session->sendSyscalls.load(std::memory_order_relaxed);
+            stats.messages = session->messagesSent.load(std::memory_order_relaxed);
+            stats.bytes = session->bytesSent.load(std::memory_order_relaxed);
+            result.emplace_back(socket, stats);
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    return result;
+}
+
+
+void ConnectionManager::sendMessage(Message message, SocketFD clientSocket)
+{
+    std::shared_ptr<ClientSession> session;
+
+    {
+        std::shared_lock lock(_clientSessionMutex);
+        auto iter = _clientSessionMap.find(clientSocket);
+        if (iter == _clientSessionMap.end())
+        {
+            Logger::instance().log("No registered client socket " + std::to_string(clientSocket), Logger::Error);
+            return;
+        }
+
+        session = iter->second;
+    }
+
+    if (!session->active)
+    {
+        Logger::instance().log("Client session is inactive (socket: " + std::to_string(clientSocket) + ")", Logger::Error);
+        return;
+    }
+
+    queueOutgoing(*session, std::move(message)); /* NB: without the lock => may block (see waitForDrain()) */
+}
+
+
+void ConnectionManager::broadcast(SharedMessage message)
+{
+    OutgoingMessage outgoing(std::move(message));
+    std::vector<std::shared_ptr<ClientSession>> sessions;
+
+    {
+        std::shared_lock lock(_clientSessionMutex);
+        sessions.reserve(_clientSessionMap.size());
+
+        for (const auto &[socket, session] : _clientSessionMap)
+        {
+            if (session->active)
+                sessions.push_back(session);
+        }
+    }
+
+    for (const auto &session : sessions) /* NB: without the lock => may block (see waitForDrain()) */
+    {
+        queueOutgoing(*session, outgoing); /* Copies the pointer, not the buffer */
+    }
+}
+
+
+void ConnectionManager::broadcast(SharedMessage message, const std::vector<SocketFD> &sockets)
+{
+    OutgoingMessage outgoing(std::move(message));
+    std::vector<std::shared_ptr<ClientSession>> sessions;
+    sessions.reserve(sockets.size());
+
+    {
+        std::shared_lock lock(_clientSessionMutex);
+
+        for (SocketFD clientSocket : sockets)
+        {
+            auto iter = _clientSessionMap.find(clientSocket);
+            if (iter == _clientSessionMap.end())
+            {
+                Logger::instance().log("No registered client socket " + std::to_string(clientSocket), Logger::Error);
+                continue;
+            }
+
+            if (!iter->second->active)
+            {
+                Logger::instance().log("Client session is inactive (socket: " + std::to_string(clientSocket) + ")", Logger::Error);
+                continue;
+            }
+
+            sessions.push_back(iter->second);
+        }
+    }
+
+    for (const auto &session : sessions) /* NB: without the lock => may block (see waitForDrain()) */
+    {
+        queueOutgoing(*session, outgoing);
+    }
+}
+
+
+void ConnectionManager::queueOutgoing(ClientSession &session, OutgoingMessage message)
+{
+    if (session.shm)
+    {
+        sendOverSharedMemory(session, message.str());
+        return;
+    }
+
+    if (!admitOutgoing(session))
+    {
+        return;
+    }
+
+    session.outgoingDepth.fetch_add(1, std::memory_order_relaxed); /* NB: before push so the sender never releases more than was reserved */
+
+    while (!session.outgoingQueue.tryPush(std::move(message))) /* Full (concurrent producers) => wait for sender */
+    {
+        if (session.backpressure.action != BackpressurePolicy::Action::Block || !waitForDrain(session))
+        {
+            session.outgoingDepth.fetch_sub(1, std::memory_order_relaxed);
+            session.messagesDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    wakeSender(session);
+}
+
+
+bool ConnectionManager::admitOutgoing(ClientSession &session)
+{
+    const BackpressurePolicy &policy = session.backpressure;
+    std::size_t depth = session.outgoingDepth.load(std::memory_order_relaxed);
+
+    if (!session.congested.load(std::memory_order_relaxed))
+    {
+        if (depth < policy.highWater)
+        {
+            return true;
+        }
+
+        if (!session.congested.exchange(true))
+        {
+            session.congestionEvents.fetch_add(1, std::memory_order_relaxed);
+            Logger::instance().error("Outgoing queue reached high-water mark (socket: " + std::to_string(session.clientSocket) + ", " + policy.describe() + ")");
+        }
+    }
+    else if (depth <= policy.lowWater)
+    {
+        session.congested = false;
+        return true;
+    }
+
+    switch (policy.action)
+    {
+        case BackpressurePolicy::Action::Drop:
+            session.messagesDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        case BackpressurePolicy::Action::Disconnect:
+            session.messagesDropped.fetch_add(1, std::memory_order_relaxed);
+            if (session.active)
+            {
+                Logger::instance().error("Disconnecting slow consumer (socket: " + std::to_string(session.clientSocket) + ")");
+                markSessionAsInactive(session);
+            }
+            return false;
+        default: /* Block until drained to the low-water mark */
+            if (!waitForDrain(session))
+            {
+                session.messagesDropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            session.congested = false;
+            return true;
+    }
+}
+
+
+void ConnectionManager::releaseOutgoing(ClientSession &session, std::size_t n)
+{
+    /* NB: seq_cst pairs with waitForDrain(): either it sees the new depth or we see the waiter */
+    std::size_t depth = session.outgoingDepth.fetch_sub(n) - n;
+
+    if (depth <= session.backpressure.lowWater && session.blockedProducers.load() != 0)
+    {
+        notifyDrained(session);
+    }
+}
+
+
+bool ConnectionManager::waitForDrain(ClientSession &session)
+{
+    const BackpressurePolicy &policy = session.backpressure;
+    auto drainedOrClosed = [&session, &policy] { return session.outgoingDepth.load() <= policy.lowWater || !session.active; };
+
+    session.blockedProducers.fetch_add(1);
+    wakeSender(session);
+
+    bool drained;
+    {
+        std::unique_lock lock(session.drainMutex);
+        drained = session.drained.wait_for(lock, std::chrono::milliseconds(policy.blockTimeoutMS), drainedOrClosed);
+    }
+
+    session.blockedProducers.fetch_sub(1);
+
+    if (!drained && session.active)
+    {
+        Logger::instance().error("Disconnecting slow consumer: blocked for " + std::to_string(policy.blockTimeoutMS) + "ms (socket: " + std::to_string(session.clientSocket) + ")");
+        markSessionAsInactive(session);
+    }
+
+    return session.active;
+}
+
+
+void ConnectionManager::notifyDrained(ClientSession &session)
+{
+    std::lock_guard lock(session.drainMutex); /* NB: a waiter is either before its predicate check or asleep */
+    session.drained.notify_all();
+}
+
+
+void ConnectionManager::wakeSender(ClientSession &session)
+{
+    if (!_reactors.empty())
+    {
+        requestFlush(session);
+        return;
+    }
+
+    session.outgoingDoorbell.ring();
+}
+
+
+void ConnectionManager::setWireEncoding(SocketFD socket, WireEncoding encoding)
+{
+    std::shared_lock lock(_clientSessionMutex);
+    auto iter = _clientSessionMap.find(socket);
+    if (iter == _clientSessionMap.end())
+    {
+        Logger::instance().log("No registered client socket " + std::to_string(socket), Logger::Error);
+        return;
+    }
+
+    iter->second->wireEncoding = encoding;
+}
+
+
+ConnectionManager::WireEncoding ConnectionManager::wireEncoding(SocketFD socket)
+{
+    std::shared_lock lock(_clientSessionMutex);
+    auto iter = _clientSessionMap.find(socket);
+
+    return (iter != _clientSessionMap.end()) ? iter->second->wireEncoding.load() : WireEncoding::Text;
+}
+
+
+/* Per event-loop io_uring state. Only touched by the loop's thread */
+struct ConnectionManager::UringState
+{
+    static constexpr unsigned RingEntries = 256;
+    static constexpr unsigned MaxSessions = 1024; /* Registered file slots */
+    static constexpr unsigned NumBuffers = 256;   /* Provided receive buffers */
+    static constexpr unsigned BufferSize = 4096;
+    static_assert(BufferSize >= MaxRecordSize, "SOCK_SEQPACKET records must fit in one provided buffer");
+    static constexpr uint16_t BufferGroup = 0;
+    static constexpr std::size_t MaxIovecs = 64; /* Messages per sendmsg() */
+    static constexpr long DrainTimeoutMS = 1000;  /* Shutdown: time allowed for in-flight sends */
+
+    /* user_data: [op:8][generation:24][slot:32] */
+    enum Op : uint64_t
+    {
+        Wake = 1,
+        Recv = 2,
+        Send = 3,
+        Cancel = 4,
+        Timeout = 5
+    };
+
+    struct Slot
+    {
+        SocketFD socket{-1};
+        uint32_t generation{0};
+        bool inUse{false};
+        bool closing{false}; /* Removed: release once no operations are in flight */
+        bool recvArmed{false};
+        bool sendInFlight{false};
+        bool seqPacket{false}; /* Receive with MSG_TRUNC to detect oversized records */
+
+        std::deque<OutgoingMessage> sending; /* Owned until the kernel has sent them */
+        std::size_t sendOffset{0};           /* Bytes of sending.front() already sent */
+        struct iovec iov[MaxIovecs];
+        struct msghdr msg;
+    };
+
+    UringState() : ring(RingEntries), slots(MaxSessions)
+    {
+        ring.registerFiles(MaxSessions);
+        ring.registerBufferRing(BufferGroup, NumBuffers, BufferSize);
+
+        for (unsigned i = MaxSessions; i-- > 0;)
+        {
+            freeSlots.push_back(i);
+        }
+    }
+
+    /* Queue is flushed to the kernel when full, so only fails if the ring is broken */
+    io_uring_sqe *nextSqe()
+    {
+        io_uring_sqe *sqe = ring.getSqe();
+        if (!sqe)
+        {
+            throw std::runtime_error("io_uring submission queue full");
+        }
+
+        return sqe;
+    }
+
+    static uint64_t userData(Op op, uint32_t generation, unsigned slot)
+    {
+        return (static_cast<uint64_t>(op) << 56) | (static_cast<uint64_t>(generation & 0xFFFFFF) << 32) | slot;
+    }
+
+    void armWake(int wakeFD)
+    {
+        io_uring_sqe *sqe = nextSqe();
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = wakeFD;
+        sqe->poll32_events = POLLIN;
+        sqe->len = IORING_POLL_ADD_MULTI;
+        sqe->user_data = userData(Wake, 0, 0);
+    }
+
+    void armRecv(unsigned iSlot)
+    {
+        Slot &slot = slots[iSlot];
+
+        io_uring_sqe *sqe = nextSqe();
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = static_cast<int>(iSlot);
+        sqe->flags = IOSQE_FIXED_FILE | IOSQE_BUFFER_SELECT;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->buf_group = BufferGroup;
+        sqe->msg_flags = (slot.seqPacket ? MSG_TRUNC : 0);
+        sqe->user_data = userData(Recv, slot.generation, iSlot);
+
+        slot.recvArmed = true;
+    }
+
+    /* Cancel slot's recv or send */
+    void cancel(Op op, unsigned iSlot)
+    {
+        io_uring_sqe *sqe = nextSqe();
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->addr = userData(op, slots[iSlot].generation, iSlot);
+        sqe->user_data = userData(Cancel, 0, 0);
+    }
+
+    /* Completes (as Timeout) after timeoutMS. NB: the kernel copies the timespec on submission */
+    void armTimeout(long timeoutMS)
+    {
+        struct __kernel_timespec timeout{};
+        timeout.tv_sec = timeoutMS / 1000;
+        timeout.tv_nsec = (timeoutMS % 1000) * 1000000;
+
+        io_uring_sqe *sqe = nextSqe();
+        sqe->opcode = IORING_OP_TIMEOUT;
+        sqe->addr = reinterpret_cast<uint64_t>(&timeout);
+        sqe->len = 1;
+        sqe->user_data = userData(Timeout, 0, 0);
+
+        ring.submitAndWait(0);
+    }
+
+    /* No recv or send the kernel could still be reading or writing slot memory for */
+    [[nodiscard]] bool idle() const
+    {
+        return std::none_of(slots.begin(), slots.end(), [](const Slot &slot) { return slot.recvArmed || slot.sendInFlight; });
+    }
+
+    /* Return slot once removed and idle. Bumping the generation drops any stale completions */
+    void releaseIfIdle(unsigned iSlot)
+    {
+        Slot &slot = slots[iSlot];
+        if (!slot.closing || slot.recvArmed || slot.sendInFlight)
+        {
+            return;
+        }
+
+        slot.sending.clear();
+        slot.sendOffset = 0;
+        slot.inUse = slot.closing = false;
+        slot.socket = (-1);
+        ++slot.generation;
+
+        freeSlots.push_back(iSlot);
+    }
+
+    IoUring ring;
+    std::vector<Slot> slots; /* Never resized: iovecs/msghdrs must stay put while in flight */
+    std::vector<unsigned> freeSlots;
+    std::unordered_map<SocketFD, unsigned> slotForSocket;
+
+    bool draining{false};     /* Shutting down: no new receives */
+    bool drainTimedOut{false}; /* Shutting down: no new sends */
+};
+
+
+ConnectionManager::Reactor::Reactor() = default;
+ConnectionManager::Reactor::~Reactor() = default;
+
+
+void ConnectionManager::setReactorThreads(std::size_t nThreads, ReactorBackend backend)
+{
+    if (_active)
+    {
+        Logger::instance().error("Reactor threads must be set before start() => Ignoring.");
+        return;
+    }
+
+    _nReactorThreads = nThreads;
+    _reactorBackend = backend;
+}
+
+
+void ConnectionManager::startReactors()
+{
+    if (_reactorBackend == ReactorBackend::IoUring && !IoUring::isSupported())
+    {
+        Logger::instance().error("io_uring not supported by kernel => Falling back to epoll.");
+        _reactorBackend = ReactorBackend::Epoll;
+    }
+
+    for (std::size_t i = 0; i < _nReactorThreads; ++i)
+    {
+        auto reactor = std::make_unique<Reactor>();
+        reactor->index = i;
+
+        if ((reactor->wakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) == (-1))
+        {
+            throw std::runtime_error("Failed to create eventfd");
+        }
+
+        if (_reactorBackend == ReactorBackend::IoUring)
+        {
+            reactor->uring = std::make_unique<UringState>();
+            reactor->uring->armWake(reactor->wakeFD);
+        }
+        else
+        {
+            if ((reactor->epollFD = epoll_create1(EPOLL_CLOEXEC)) == (-1))
+            {
+                throw std::runtime_error("Failed to create epoll instance");
+            }
+
+            struct epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = reactor->wakeFD;
+
+            if (epoll_ctl(reactor->epollFD, EPOLL_CTL_ADD, reactor->wakeFD, &event) == (-1))
+            {
+                throw std::runtime_error("Failed to register eventfd with epoll");
+            }
+        }
+
+        _reactors.push_back(std::move(reactor));
+    }
+
+    for (auto &reactor : _reactors)
+    {
+        auto loop = (reactor->uring ? &ConnectionManager::uringLoop : &ConnectionManager::reactorLoop);
+        reactor->thread = std::thread(loop, this, std::ref(*reactor));
+    }
+
+    Logger::instance().info("Started " + std::to_string(_reactors.size()) + (_reactorBackend == ReactorBackend::IoUring ? " io_uring" : " epoll") + " event-loop(s)");
+}
+
+
+void ConnectionManager::stopReactors()
+{
+    uint64_t one = 1;
+
+    for (auto &reactor : _reactors)
+    {
+        if (write(reactor->wakeFD, &one, sizeof(one)) == (-1))
+        {
+            Logger::instance().error("Failed to wake reactor (eventfd: " + std::to_string(reactor->wakeFD) + ")");
+        }
+    }
+
+    for (auto &reactor : _reactors) /* Loops flush pending sends on the way out => before sessions close */
+    {
+        if (reactor->thread.joinable() && std::this_thread::get_id() != reactor->thread.get_id())
+            reactor->thread.join();
+    }
+}
+
+
+void ConnectionManager::waitReactors()
+{
+    for (auto &reactor : _reactors)
+    {
+        if (reactor->thread.joinable() && std::this_thread::get_id() != reactor->thread.get_id())
+            reactor->thread.join();
+    }
+
+    for (auto &reactor : _reactors)
+    {
+        if (reactor->thread.joinable())
+            return; /* Called from a reactor thread => cannot release yet */
+    }
+
+    for (auto &reactor : _reactors)
+    {
+        closeSocket(reactor->wakeFD);
+        if (reactor->epollFD != (-1))
+            closeSocket(reactor->epollFD);
+    }
+
+    _reactors.clear(); /* Closes io_uring instances */
+}
+
+
+void ConnectionManager::registerWithReactor(ClientSession &session)
+{
+    /* Non-blocking: edge-triggered events require reading/writing until EAGAIN */
+    int flags = fcntl(session.clientSocket, F_GETFL, 0);
+    if (flags == (-1) || fcntl(session.clientSocket, F_SETFL, flags | O_NONBLOCK) == (-1))
+    {
+        Logger::instance().error("Failed to make socket non-blocking (socket: " + std::to_string(session.clientSocket) + ")");
+        markSessionAsInactive(session);
+        return;
+    }
+
+    session.reactor = _nextReactor.fetch_add(1, std::memory_order_relaxed) % _reactors.size();
+    Reactor &reactor = *_reactors[session.reactor];
+
+    if (reactor.uring) /* Ring is owned by the loop's thread */
+    {
+        postCommand(reactor, ReactorCommand::Register, session.clientSocket);
+        return;
+    }
+
+    struct epoll_event event{};
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.fd = session.clientSocket;
+
+    if (epoll_ctl(reactor.epollFD, EPOLL_CTL_ADD, session.clientSocket, &event) == (-1))
+    {
+        Logger::instance().error("Failed to register socket with epoll (socket: " + std::to_string(session.clientSocket) + ")");
+        markSessionAsInactive(session);
+        return;
+    }
+
+    Logger::instance().info("Registered session with reactor " + std::to_string(session.reactor) + " (socket: " + std::to_string(session.clientSocket) + ")");
+}
+
+
+void ConnectionManager::unregisterFromReactor(ClientSession &session)
+{
+    Reactor &reactor = *_reactors[session.reactor];
+
+    if (reactor.uring) /* epoll: closing the socket removes it */
+    {
+        postCommand(reactor, ReactorCommand::Remove, session.clientSocket);
+    }
+}
+
+
+void ConnectionManager::requestFlush(ClientSession &session)
+{
+    if (session.flushPending.exchange(true)) /* Already queued */
+    {
+        return;
+    }
+
+    postCommand(*_reactors[session.reactor], ReactorCommand::Flush, session.clientSocket);
+}
+
+
+void ConnectionManager::postCommand(Reactor &reactor, ReactorCommand command, SocketFD socket)
+{
+    {
+        std::lock_guard lock(reactor.pendingCommandsMutex);
+        reactor.pendingCommands.emplace_back(command, socket);
+    }
+
+    uint64_t one = 1;
+    if (write(reactor.wakeFD, &one, sizeof(one)) == (-1) && errno != EAGAIN)
+    {
+        Logger::instance().error("Failed to wake reactor (eventfd: " + std::to_string(reactor.wakeFD) + ")");
+    }
+}
+
+
+void ConnectionManager::reactorLoop(Reactor &reactor)
+{
+    Logger::instance().info("Starting reactor loop (epoll: " + std::to_string(reactor.epollFD) + ")");
+    tuneThread(_lowLatency.receiveCpus, reactor.index);
+
+    const int waitTimeout = (_lowLatency.busySpin ? 0 : -1); /* Blocking => woken by eventfd on shutdown */
+
+    struct epoll_event events[MaxReactorEvents];
+
+    std::vector<ClientMessage> batch;                               /* Reused between wake-ups */
+    std::vector<std::pair<ReactorCommand, SocketFD>> pendingCommands; /* Swapped with reactor's list */
+
+    while (_active) /* Run for server lifetime */
+    {
+        int nEvents = epoll_wait(reactor.epollFD, events, MaxReactorEvents, waitTimeout);
+
+        if (nEvents == (-1))
+        {
+            if (errno != EINTR)
+                Logger::instance().error("An epoll error occurred (epoll: " + std::to_string(reactor.epollFD) + ")");
+            continue;
+        }
+
+        for (int i = 0; i < nEvents; ++i)
+        {
+            if (events[i].data.fd != reactor.wakeFD)
+            {
+                handleReactorEvent(events[i].data.fd, events[i].events, batch);
+                continue;
+            }
+
+            uint64_t count;
+            while (read(reactor.wakeFD, &count, sizeof(count)) > 0) /* Drain */
+            {
+            }
+
+            {
+                std::lock_guard lock(reactor.pendingCommandsMutex);
+                pendingCommands.swap(reactor.pendingCommands);
+            }
+
+            for (auto [command, socket] : pendingCommands)
+            {
+                if (command == ReactorCommand::Flush)
+                    handleReactorEvent(socket, EPOLLOUT, batch);
+            }
+
+            pendingCommands.clear();
+        }
+
+        queueBatch(batch); /* One push/wake-up pass for all frames */
+    }
+
+    Logger::instance().info("Shutting-down reactor loop (epoll: " + std::to_string(reactor.epollFD) + ")");
+}
+
+
+void ConnectionManager::handleReactorEvent(SocketFD socket, uint32_t events, std::vector<ClientMessage> &batch)
+{
+    std::shared_lock lock(_clientSessionMutex); /* Session cannot be erased while handling */
+
+    auto iter = _clientSessionMap.find(socket);
+    if (iter == _clientSessionMap.end() || !iter->second->active)
+    {
+        return;
+    }
+
+    ClientSession &session = *iter->second;
+
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+    {
+        receiveAvailable(session, batch);
+    }
+
+    if (session.active && (events & EPOLLOUT))
+    {
+        flushOutgoing(session);
+    }
+}
+
+
+void ConnectionManager::receiveAvailable(ClientSession &session, std::vector<ClientMessage> &batch)
+{
+    while (true)
+    {
+        session.receiveBuffer.reserve(session.seqPacket ? MaxRecordSize : MinReceiveSize); /* Whole record or it is truncated */
+
+        long nBytesRead = recv(session.clientSocket, session.receiveBuffer.writePtr(), session.receiveBuffer.writable(), session.seqPacket ? MSG_TRUNC : 0);
+
+        if (nBytesRead > static_cast<long>(session.receiveBuffer.writable())) /* MSG_TRUNC: record larger than MaxRecordSize */
+        {
+            Logger::instance().error("Closing session: " + std::to_string(nBytesRead) + "-byte record truncated (socket: " + std::to_string(session.clientSocket) + ")");
+            markSessionAsInactive(session);
+            break;
+        }
+        else if (nBytesRead > 0)
+        {
+            session.receiveBuffer.commit(nBytesRead);
+            continue;
+        }
+        else if (nBytesRead == 0)
+        {
+            Logger::instance().info("Client connection has closed (socket: " + std::to_string(session.clientSocket) + ")");
+            markSessionAsInactive(session);
+            break;
+        }
+        else if (errno == EINTR)
+        {
+            continue;
+        }
+        else if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            Logger::instance().error("An error occurred in recv() (socket: " + std::to_string(session.clientSocket) + ")");
+            markSessionAsInactive(session);
+        }
+
+        break; /* Drained */
+    }
+
+    extractReceivedFrames(session, batch);
+}
+
+
+void ConnectionManager::flushOutgoing(ClientSession &session)
+{
+    session.flushPending = false; /* Messages queued from now on trigger another flush */
+
+    struct iovec iov[MaxSendIovecs];
+
+    while (true)
+    {
+        if (session.sending.size() < MaxSendIovecs) /* Top up so each sendmsg() carries a full batch */
+        {
+            releaseOutgoing(session, session.outgoingQueue.popBatch(session.sending, MaxSendIovecs - session.sending.size()));
+        }
+
+        if (session.sending.empty())
+        {
+            break;
+        }
+
+        struct msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = gatherIovecs(session, session.sending, 0, session.sendOffset, iov);
+
+        long nBytesSent = sendmsg(session.clientSocket, &msg, MSG_NOSIGNAL);
+
+        if (nBytesSent == (-1))
+        {
+            if (errno == EINTR)
+                continue;
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK) /* EAGAIN => resume on EPOLLOUT */
+            {
+                Logger::instance().error("Failed to send " + std::to_string(session.sending.size()) + " message(s) (destination: " + std::to_string(session.clientSocket) + ")");
+                markSessionAsInactive(session);
+            }
+
+            return;
+        }
+
+        /* Drop fully sent messages; keep offset into a partially sent one */
+        std::size_t first = 0;
+        std::size_t nMessagesSent = advanceSent(session.sending, first, session.sendOffset, static_cast<std::size_t>(nBytesSent));
+        session.sending.erase(session.sending.begin(), session.sending.begin() + static_cast<long>(first));
+
+        recordSend(session, static_cast<std::size_t>(nBytesSent), nMessagesSent);
+    }
+}
+
+
+void ConnectionManager::uringLoop(Reactor &reactor)
+{
+    Logger::instance().info("Starting io_uring loop (eventfd: " + std::to_string(reactor.wakeFD) + ")");
+
+    tuneThread(_lowLatency.receiveCpus, reactor.index);
+
+    IoUring &ring = reactor.uring->ring;
+    std::vector<ClientMessage> batch; /* Reused between wake-ups */
+
+    const unsigned minComplete = (_lowLatency.busySpin ? 0 : 1); /* Busy-spin => reap without blocking */
+
+    while (_active) /* Run for server lifetime */
+    {
+        int result = ring.submitAndWait(minComplete); /* Submits all queued recv/send requests in one syscall */
+
+        if (result < 0 && result != -EINTR && result != -EBUSY)
+        {
+            Logger::instance().error("An io_uring error occurred: " + std::string(std::strerror(-result)));
+        }
+
+        ring.forEachCqe([&](const io_uring_cqe &cqe)
+        {
+            handleUringCompletion(reactor, cqe.user_data, cqe.res, cqe.flags, batch);
+        });
+
+        queueBatch(batch); /* One push/wake-up pass for all frames */
+    }
+
+    /* Slots (iovecs, msghdrs, queued messages) and provided buffers are freed with the ring => stop
+     * receiving, give in-flight sends (e.g. reply to netadmin shutdown) time to finish, then cancel
+     * the rest and reap every completion before returning */
+    UringState &uring = *reactor.uring;
+    uring.draining = true;
+
+    for (unsigned iSlot = 0; iSlot < uring.slots.size(); ++iSlot)
+    {
+        if (uring.slots[iSlot].recvArmed)
+            uring.cancel(UringState::Recv, iSlot);
+    }
+
+    uring.armTimeout(UringState::DrainTimeoutMS);
+    bool sendsCancelled = false;
+
+    while (!uring.idle())
+    {
+        if (uring.drainTimedOut && !sendsCancelled)
+        {
+            Logger::instance().error("Timed out waiting for io_uring sends => Cancelling.");
+
+            for (unsigned iSlot = 0; iSlot < uring.slots.size(); ++iSlot)
+            {
+                if (uring.slots[iSlot].sendInFlight)
+                    uring.cancel(UringState::Send, iSlot);
+            }
+
+            sendsCancelled = true;
+        }
+
+        int result = ring.submitAndWait(1);
+
+        if (result < 0 && result != -EINTR && result != -EBUSY)
+        {
+            Logger::instance().critical("An io_uring error occurred while draining: " + std::string(std::strerror(-result)));
+            break;
+        }
+
+        ring.forEachCqe([&](const io_uring_cqe &cqe)
+        {
+            handleUringCompletion(reactor, cqe.user_data, cqe.res, cqe.flags, batch);
+        });
+    }
+
+    Logger::instance().info("Shutting-down io_uring loop (eventfd: " + std::to_string(reactor.wakeFD) + ")");
+}
+
+
+void ConnectionManager::handleUringCompletion(Reactor &reactor, uint64_t userData, int result, uint32_t flags, std::vector<ClientMessage> &batch)
+{
+    UringState &uring = *reactor.uring;
+
+    auto op = static_cast<UringState::Op>(userData >> 56);
+    auto generation = static_cast<uint32_t>((userData >> 32) & 0xFFFFFF);
+    auto iSlot = static_cast<unsigned>(userData & 0xFFFFFFFF);
+
+    if (op == UringState::Wake)
+    {
+        uint64_t count;
+        while (read(reactor.wakeFD, &count, sizeof(count)) > 0) /* Drain */
+        {
+        }
+
+        std::vector<std::pair<ReactorCommand, SocketFD>> pendingCommands;
+        {
+            std::lock_guard lock(reactor.pendingCommandsMutex);
+            pendingCommands.swap(reactor.pendingCommands);
+        }
+
+        for (auto [command, socket] : pendingCommands) /* In order: a Remove precedes a Register of a reused fd */
+        {
+            handleUringCommand(reactor, command, socket);
+        }
+
+        if (!(flags & IORING_CQE_F_MORE))
+            uring.armWake(reactor.wakeFD);
+        return;
+    }
+    else if (op == UringState::Timeout)
+    {
+        uring.drainTimedOut = true;
+        return;
+    }
+    else if (op == UringState::Cancel || iSlot >= uring.slots.size())
+    {
+        return;
+    }
+
+    UringState::Slot &slot = uring.slots[iSlot];
+
+    if (op == UringState::Recv)
+    {
+        if (flags & IORING_CQE_F_BUFFER)
+        {
+            auto bufferID = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+
+            if (result > 0 && slot.inUse && !slot.closing && !uring.draining && (slot.generation & 0xFFFFFF) == generation)
+            {
+                std::shared_lock lock(_clientSessionMutex);
+                auto iter = _clientSessionMap.find(slot.socket);
+
+                if (iter != _clientSessionMap.end() && iter->second->active && static_cast<unsigned>(result) > UringState::BufferSize) /* MSG_TRUNC */
+                {
+                    Logger::instance().error("Closing session: " + std::to_string(result) + "-byte record truncated (socket: " + std::to_string(slot.socket) + ")");
+                    markSessionAsInactive(*iter->second);
+                }
+                else if (iter != _clientSessionMap.end() && iter->second->active)
+                {
+                    ReceiveBuffer &buffer = iter->second->receiveBuffer;
+                    buffer.reserve(static_cast<std::size_t>(result));
+                    std::memcpy(buffer.writePtr(), uring.ring.buffer(bufferID), static_cast<std::size_t>(result));
+                    buffer.commit(static_cast<std::size_t>(result));
+
+                    extractReceivedFrames(*iter->second, batch);
+                }
+            }
+
+            uring.ring.recycleBuffer(bufferID);
+        }
+
+        if (flags & IORING_CQE_F_MORE)
+        {
+            return; /* Multishot still armed */
+        }
+
+        slot.recvArmed = false;
+
+        if (slot.closing || (slot.generation & 0xFFFFFF) != generation)
+        {
+            uring.releaseIfIdle(iSlot);
+            return;
+        }
+
+        if (uring.draining)
+        {
+            return;
+        }
+
+        if (result > 0 || result == -ENOBUFS) /* Terminated (e.g. buffers exhausted) => re-arm */
+        {
+            uring.armRecv(iSlot);
+            return;
+        }
+
+        if (result == 0)
+            Logger::instance().info("Client connection has closed (socket: " + std::to_string(slot.socket) + ")");
+        else
+            Logger::instance().error("An error occurred in io_uring recv (socket: " + std::to_string(slot.socket) + "): " + std::strerror(-result));
+
+        std::shared_lock lock(_clientSessionMutex);
+        auto iter = _clientSessionMap.find(slot.socket);
+        if (iter != _clientSessionMap.end())
+        {
+            markSessionAsInactive(*iter->second);
+        }
+    }
+    else if (op == UringState::Send)
+    {
+        slot.sendInFlight = false;
+
+        if (slot.closing)
+        {
+            uring.releaseIfIdle(iSlot);
+            return;
+        }
+
+        if (result < 0 && result != -EAGAIN && result != -EINTR)
+        {
+            Logger::instance().error("Failed to send messages (destination: " + std::to_string(slot.socket) + "): " + std::strerror(-result));
+            slot.sending.clear();
+            slot.sendOffset = 0;
+
+            std::shared_lock lock(_clientSessionMutex);
+            auto iter = _clientSessionMap.find(slot.socket);
+            if (iter != _clientSessionMap.end())
+            {
+                markSessionAsInactive(*iter->second);
+            }
+            return;
+        }
+
+        /* Drop fully sent messages; keep offset into a partially sent one */
+        auto nBytesSent = static_cast<std::size_t>(std::max(result, 0));
+        std::size_t nMessagesSent = 0;
+
+        for (std::size_t remaining = nBytesSent; remaining > 0 && !slot.sending.empty();)
+        {
+            std::size_t left = slot.sending.front().size() - slot.sendOffset;
+
+            if (remaining < left)
+            {
+                slot.sendOffset += remaining;
+                break;
+            }
+
+            remaining -= left;
+            slot.sending.pop_front();
+            slot.sendOffset = 0;
+            ++nMessagesSent;
+        }
+
+        if (nBytesSent > 0)
+        {
+            std::shared_lock lock(_clientSessionMutex);
+            auto iter = _clientSessionMap.find(slot.socket);
+            if (iter != _clientSessionMap.end())
+            {
+                recordSend(*iter->second, nBytesSent, nMessagesSent);
+            }
+        }
+
+        startUringSend(reactor, iSlot);
+    }
+}
+
+
+void ConnectionManager::handleUringCommand(Reactor &reactor, ReactorCommand command, SocketFD socket)
+{
+    UringState &uring = *reactor.uring;
+
+    if (command == ReactorCommand::Register)
+    {
+        if (uring.draining)
+        {
+            return;
+        }
+
+        if (uring.freeSlots.empty())
+        {
+            Logger::instance().error("No free io_uring slots (socket: " + std::to_string(socket) + ")");
+            return;
+        }
+
+        unsigned iSlot = uring.freeSlots.back();
+        uring.freeSlots.pop_back();
+
+        try
+        {
+            uring.ring.updateFile(iSlot, socket);
+        }
+        catch (const std::exception &e)
+        {
+            Logger::instance().error(std::string(e.what()) + " (socket: " + std::to_string(socket) + ")");
+            uring.freeSlots.push_back(iSlot);
+            return;
+        }
+
+        UringState::Slot &slot = uring.slots[iSlot];
+        slot.socket = socket;
+        slot.inUse = true;
+
+        {
+            std::shared_lock lock(_clientSessionMutex);
+            auto iter = _clientSessionMap.find(socket);
+            slot.seqPacket = (iter != _clientSessionMap.end() && iter->second->seqPacket);
+        }
+
+        uring.slotForSocket[socket] = iSlot;
+        uring.armRecv(iSlot);
+
+        Logger::instance().info("Registered session with io_uring slot " + std::to_string(iSlot) + " (socket: " + std::to_string(socket) + ")");
+        return;
+    }
+
+    auto iter = uring.slotForSocket.find(socket);
+    if (iter == uring.slotForSocket.end())
+    {
+        return;
+    }
+
+    unsigned iSlot = iter->second;
+
+    if (command == ReactorCommand::Flush)
+    {
+        startUringSend(reactor, iSlot);
+    }
+    else if (command == ReactorCommand::Remove)
+    {
+        UringState::Slot &slot = uring.slots[iSlot];
+        slot.closing = true;
+        uring.slotForSocket.erase(iter);
+
+        if (slot.recvArmed)
+            uring.cancel(UringState::Recv, iSlot);
+
+        try
+        {
+            uring.ring.updateFile(iSlot, -1); /* Kernel keeps its own reference until in-flight requests finish */
+        }
+        catch (const std::exception &e)
+        {
+            Logger::instance().error(e.what());
+        }
+
+        uring.releaseIfIdle(iSlot);
+    }
+}
+
+
+void ConnectionManager::startUringSend(Reactor &reactor, unsigned iSlot)
+{
+    UringState &uring = *reactor.uring;
+    UringState::Slot &slot = uring.slots[iSlot];
+
+    if (slot.sendInFlight || slot.closing || uring.drainTimedOut)
+    {
+        return; /* Completion will pick up newly queued messages */
+    }
+
+    std::size_t maxBytes = SIZE_MAX; /* Per sendmsg() */
+
+    {
+        std::shared_lock lock(_clientSessionMutex);
+        auto iter = _clientSessionMap.find(slot.socket);
+
+        if (iter != _clientSessionMap.end())
+        {
+            ClientSession &session = *iter->second;
+            session.flushPending = false; /* Messages queued from now on trigger another flush */
+
+            releaseOutgoing(session, session.outgoingQueue.popBatch(slot.sending, session.outgoingQueue.capacity()));
+
+            if (session.seqPacket)
+                maxBytes = MaxRecordSize;
+        }
+    }
+
+    if (slot.sending.empty())
+    {
+        return;
+    }
+
+    /* One sendmsg() covering as many queued messages as fit */
+    std::size_t nIovecs = 0;
+    std::size_t nBytes = 0;
+
+    for (auto iter = slot.sending.begin(); iter != slot.sending.end() && nIovecs < UringState::MaxIovecs; ++iter, ++nIovecs)
+    {
+        std::size_t offset = (nIovecs == 0 ? slot.sendOffset : 0);
+        std::size_t length = std::min(iter->size() - offset, maxBytes); /* Larger message spans records */
+
+        if (nIovecs > 0 && nBytes + iter->size() > maxBytes) /* Record full */
+            break;
+
+        slot.iov[nIovecs].iov_base = const_cast<char *>(iter->data()) + offset;
+        slot.iov[nIovecs].iov_len = length;
+        nBytes += length;
+    }
+
+    std::memset(&slot.msg, 0, sizeof(slot.msg));
+    slot.msg.msg_iov = slot.iov;
+    slot.msg.msg_iovlen = nIovecs;
+
+    io_uring_sqe *sqe = uring.ring.getSqe();
+    if (!sqe)
+    {
+        Logger::instance().error("io_uring submission queue full (socket: " + std::to_string(slot.socket) + ")");
+        postCommand(reactor, ReactorCommand::Flush, slot.socket); /* Retry next wake-up */
+        return;
+    }
+
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = static_cast<int>(iSlot);
+    sqe->flags = IOSQE_FIXED_FILE;
+    sqe->addr = reinterpret_cast<uint64_t>(&slot.msg);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = UringState::userData(UringState::Send, slot.generation, iSlot);
+
+    slot.sendInFlight = true;
+}
+
+
+void ConnectionManager::closeSocket(SocketFD socket)
+{
+    if (close(socket) == (-1))
+    {
+        Logger::instance().error("Failed to close socket: " + std::to_string(socket));
+    }
+    else
+    {
+        Logger::instance().info("Closed socket: " + std::to_string(socket));
+    }
+}
+
+
+void ConnectionManager::PortSocketMappings::clear()
+{
+    std::unique_lock lock(_portSocketMutex);
+    _addressToSocket.clear();
+    _socketToAddress.clear();
+}
+
+
+void ConnectionManager::PortSocketMappings::update(const SocketAddress &address, SocketFD socket)
+{
+    std::unique_lock lock(_portSocketMutex);
+    _addressToSocket[address.toString()] = socket;
+    _socketToAddress[socket] = address;
+}
+
+
+ConnectionManager::Port ConnectionManager::PortSocketMappings::getPort(SocketFD socket) const
+{
+    std::shared_lock lock(_portSocketMutex);
+
+    auto iter = _socketToAddress.find(socket);
+
+    return (iter != _socketToAddress.end() && !iter->second.isUnix()) ? iter->second.port : 0;
+}
+
+
+std::string ConnectionManager::PortSocketMappings::getAddress(SocketFD socket) const
+{
+    std::shared_lock lock(_portSocketMutex);
+
+    auto iter = _socketToAddress.find(socket);
+
+    return (iter != _socketToAddress.end()) ? iter->second.toString() : std::string();
+}
+
+
+ConnectionManager::SocketFD ConnectionManager::PortSocketMappings::getSocket(const SocketAddress &address) const
+{
+    std::shared_lock lock(_portSocketMutex);
+
+    auto iter = _addressToSocket.find(address.toString());
+
+    return (iter != _addressToSocket.end()) ? iter->second : (-1);
+}
+
+
+std::vector<ConnectionManager::SocketFD> ConnectionManager::PortSocketMappings::getSockets() const
+{
+    std::shared_lock lock(_portSocketMutex);
+
+    std::vector<SocketFD> sockets;
+    sockets.reserve(_socketToAddress.size());
+
+    for (auto iter = _socketToAddress.begin(); iter != _socketToAddress.end(); ++iter)
+    {
+        sockets.push_back(iter->first);
+    }
+
+    return sockets;
+}
+
+
+void ConnectionManager::PortSocketMappings::erase(SocketFD socket)
+{
+    std::unique_lock lock(_portSocketMutex);
+
+    auto iter = _socketToAddress.find(socket);
+    if (iter == _socketToAddress.end())
+    {
+        return;
+    }
 
-    std::unique_lock lock(_portSocketMutex); /* Careful with lock since getPort has lock */
-    _portToSocket.erase(port);
-    _socketToPort.erase(socket);
+    _addressToSocket.erase(iter->second.toString());
+    _socketToAddress.erase(iter);
 }
\ No newline at end of file
@@ -8,17 +8,29 @@
  */
 
 #pragma once
+#include "BackpressurePolicy.hpp"
+#include "ReceiveBuffer.hpp"
+#include "ShmChannel.hpp"
+#include "SocketAddress.hpp"
+#include "SocketOptions.hpp"
+#include "utilities/Doorbell.hpp"
+#include "utilities/MpscQueue.hpp"
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
-#include <queue>
 #include <shared_mutex>
 #include <string>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <thread>
 #include <unistd.h>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 
@@ -29,15 +41,115 @@ public:
     using SocketFD = int; /* Socket file descriptor (FD) */
     using Message = std::string;
 
+    /* Immutable message queued on many sessions without copying it per destination */
+    using SharedMessage = std::shared_ptr<const Message>;
+
+    /* Encoding of messages sent on a session. Received messages may use either */
+    enum class WireEncoding : uint8_t
+    {
+        Text = 0,
+        BinaryPending = 1, /* Binary requested; still sending text until the peer accepts */
+        Binary = 2
+    };
+
     // TODO: - add retry loop if cannot immediately connect
-    // TODO: - add a broadcast method to send a message to all connections
-    // TODO: - implement MsgSequenceNo for incoming/outgoing connections and use to check
 
     virtual ~ConnectionManager();
 
-    bool connectToServer(Port serverPort);
+    /* Connect to a server over TCP (a bare port) or AF_UNIX ("unix:/path", "unixpacket:/path") */
+    bool connectToServer(const SocketAddress &serverAddress);
     void sendMessage(Message message, SocketFD socket);
 
+    /* Queue the same buffer on every active session, or only on sockets. Sent as-is (the caller
+     * encodes it for the sessions' wire encoding); each session applies its own backpressure policy */
+    void broadcast(SharedMessage message);
+    void broadcast(SharedMessage message, const std::vector<SocketFD> &sockets);
+
+    /* Per-session send encoding. Text for unknown sockets */
+    void setWireEncoding(SocketFD socket, WireEncoding encoding);
+    WireEncoding wireEncoding(SocketFD socket);
+
+    /* Outgoing traffic on a session. messages/syscalls shows how well sends are coalesced */
+    struct SendStats
+    {
+        uint64_t syscalls{0};
+        uint64_t messages{0};
+        uint64_t bytes{0};
+    };
+
+    /* Per-session send statistics, ordered by socket */
+    std::vector<std::pair<SocketFD, SendStats>> sendStats();
+
+    /* How handler threads wait for incoming messages. Call before start() */
+    void setIngressWaitStrategy(Doorbell::WaitStrategy strategy);
+
+    /* Number of handler threads (default 1). Messages with the same shardKey() are handled in order
+     * on the same thread. Call before start() */
+    void setHandlerThreads(std::size_t nThreads);
+
+    /* Work done by each handler thread */
+    struct HandlerShardStats
+    {
+        uint64_t messages{0};
+        uint64_t wakeups{0}; /* Batches drained */
+    };
+
+    std::vector<HandlerShardStats> handlerShardStats() const;
+
+    /* Low-latency run mode: dedicated cores and no sleeping */
+    struct LowLatencyConfig
+    {
+        bool busySpin{false};         /* Spin on queues and sockets instead of blocking */
+        int fifoPriority{0};          /* SCHED_FIFO priority for pinned threads (0 => off) */
+        std::vector<int> receiveCpus; /* Connection loops or event-loops (round-robin) */
+        std::vector<int> handlerCpus; /* Handler shards (round-robin) */
+        std::vector<int> senderCpus;  /* Sender loops; event-loops send in reactor mode (round-robin) */
+    };
+
+    /* Call before start() */
+    void setLowLatencyConfig(LowLatencyConfig config);
+
+    /* Socket profile for accepted sessions and outbound connections without their own profile. Call
+     * before start() */
+    void setSocketOptions(SocketOptions options);
+
+    /* Socket profile for outbound connections to serverAddress. Call before connectToServer() */
+    void setSocketOptions(const SocketAddress &serverAddress, SocketOptions options);
+
+    /* Effective socket options of each session (see SocketOptions::describe()), ordered by socket */
+    std::vector<std::pair<SocketFD, std::string>> socketOptionsReport();
+
+    /* Outgoing queue bound and slow-consumer handling for accepted sessions and outbound connections
+     * without their own policy. Call before start() */
+    void setBackpressurePolicy(BackpressurePolicy policy);
+
+    /* Policy for outbound connections to serverAddress. Call before connectToServer() */
+    void setBackpressurePolicy(const SocketAddress &serverAddress, BackpressurePolicy policy);
+
+    /* Outgoing queue of a session */
+    struct OutgoingQueueStats
+    {
+        std::size_t depth{0};         /* Messages queued but not yet taken by the sender */
+        uint64_t dropped{0};          /* Messages discarded by the policy or on close */
+        uint64_t congestionEvents{0}; /* Times the high-water mark was reached */
+        bool congested{false};
+        BackpressurePolicy policy;
+    };
+
+    /* Per-session outgoing queue statistics, ordered by socket */
+    std::vector<std::pair<SocketFD, OutgoingQueueStats>> outgoingQueueStats();
+
+    /* Event-loop implementation in reactor mode */
+    enum class ReactorBackend : uint8_t
+    {
+        Epoll = 0,
+        IoUring = 1 /* Multishot recv + batched sendmsg. Falls back to Epoll if unsupported */
+    };
+
+    /* Run sessions on nThreads event-loops instead of two threads per connection (0 => thread per
+     * connection). Call before start() */
+    void setReactorThreads(std::size_t nThreads, ReactorBackend backend = ReactorBackend::Epoll);
+
     /* Starts the server; nonblocking */
     void start();
 
@@ -48,7 +160,7 @@ public:
     void wait();
 
 protected:
-    ConnectionManager() = default;
+    ConnectionManager(); /* Throws std::runtime_error if eventfds cannot be created */
     ConnectionManager(const ConnectionManager &) = delete;
     ConnectionManager &operator=(const ConnectionManager &) = delete;
 
@@ -57,88 +169,329 @@ protected:
     virtual void onShutdown() {}
     virtual void onWait() {}
 
+    /* Called once a session has stopped receiving, before its socket is closed */
+    virtual void onSessionClosed(SocketFD) {}
+
     /* Called when we receive a message from a client or server */
     virtual void handleMessage(Message message, SocketFD fromSocket) = 0;
 
-    /* Port <--> Socket mappings */
+    /* Selects the handler thread for a message when there is more than one. Called on receiving
+     * threads. Default keeps each session on one thread */
+    virtual std::size_t shardKey(const Message &message, SocketFD fromSocket) const;
+
+    /* Called on the receiving thread in arrival order, before shardKey(). False => discard */
+    virtual bool admitIncoming(const Message &, SocketFD) { return true; }
+
+    /* Queue message for the handler threads as if received from fromSocket (not passed to
+     * admitIncoming()). Lets admitIncoming() defer work that may block off the receiving thread */
+    void queueIncoming(Message message, SocketFD fromSocket);
+
+    /* Server address (port or unix path) <--> Socket mappings for outbound connections */
     class PortSocketMappings
     {
     public:
         void clear();
-        void update(Port port, SocketFD socket);
+        void update(const SocketAddress &address, SocketFD socket);
         void erase(SocketFD socket);
 
         /* Returns (-1) if not found */
-        SocketFD getSocket(Port port) const;
+        SocketFD getSocket(const SocketAddress &address) const;
 
         /* Returns a set of all active connections */
         std::vector<SocketFD> getSockets() const;
 
-        /* Returns 0 if not found (special port) */
+        /* Returns 0 if not found or not TCP (special port) */
         Port getPort(SocketFD socket) const;
 
+        /* Returns SocketAddress::toString() or empty if not found */
+        std::string getAddress(SocketFD socket) const;
+
     private:
         mutable std::shared_mutex _portSocketMutex;
-        std::unordered_map<Port, SocketFD> _portToSocket;
-        std::unordered_map<SocketFD, Port> _socketToPort;
+        std::unordered_map<std::string, SocketFD> _addressToSocket;
+        std::unordered_map<SocketFD, SocketAddress> _socketToAddress;
+    };
+
+    /* Largest record sent or received on a SOCK_SEQPACKET session (one io_uring provided buffer).
+     * Larger messages are sent as several records; a larger record received closes the session */
+    static constexpr std::size_t MaxRecordSize = 4096;
+
+    /* Queued outgoing message: owned (sendMessage) or shared with other sessions (broadcast) */
+    class OutgoingMessage
+    {
+    public:
+        OutgoingMessage() = default;
+        OutgoingMessage(Message message) : _owned(std::move(message)) {}
+        OutgoingMessage(SharedMessage message) : _shared(std::move(message)) {}
+
+        [[nodiscard]] inline const Message &str() const { return (_shared ? *_shared : _owned); }
+        [[nodiscard]] inline const char *data() const { return str().data(); }
+        [[nodiscard]] inline std::size_t size() const { return str().size(); }
+
+    private:
+        Message _owned;
+        SharedMessage _shared;
     };
 
     struct ClientSession
     {
         ClientSession() = delete;
-        ClientSession(SocketFD clientSocket) : clientSocket(clientSocket) {}
+        ClientSession(SocketFD clientSocket, const BackpressurePolicy &backpressure)
+            : clientSocket(clientSocket), backpressure(backpressure), outgoingQueue(backpressure.highWater)
+        {
+        }
 
         /* Deleted copy constructors */
         ClientSession(const ClientSession &) = delete;
         ClientSession &operator=(const ClientSession &) = delete;
 
         SocketFD clientSocket;
+        bool seqPacket{false}; /* SOCK_SEQPACKET: each send() is one record of at most MaxRecordSize bytes */
+        std::size_t index{0};  /* Order of creation: selects pinned CPUs */
         std::atomic<bool> active{false};
+        std::atomic<WireEncoding> wireEncoding{WireEncoding::Text};
 
-        std::mutex outgoingMutex;
-        std::condition_variable outgoingCV;
-        std::queue<Message> outgoingMsgQueue;
+        ReceiveBuffer receiveBuffer; /* Partial frames carried between reads */
+
+        /* Outgoing messages: any thread => sender thread (or owning event-loop) */
+        BackpressurePolicy backpressure;
+        MpscQueue<OutgoingMessage> outgoingQueue;  /* Capacity: backpressure.highWater */
+        std::atomic<std::size_t> outgoingDepth{0}; /* Reserved before each push, released on pop */
+        std::atomic<bool> congested{false};        /* Reached highWater and not yet drained to lowWater */
+        Doorbell outgoingDoorbell;
+        std::deque<OutgoingMessage> sending; /* epoll: dequeued but not yet fully sent */
+
+        /* Block policy: producers waiting for the queue to drain to lowWater (or the session to close) */
+        std::mutex drainMutex;
+        std::condition_variable drained;
+        std::atomic<uint32_t> blockedProducers{0}; /* Sender notifies only while non-zero */
 
         std::thread connectionThread;
         std::thread senderThread;
+        int sendWakeFD{-1}; /* Thread mode: eventfd signalled on close. Wakes a sender waiting for socket space */
+
+        /* Send statistics */
+        std::atomic<uint64_t> sendSyscalls{0};
+        std::atomic<uint64_t> messagesSent{0};
+        std::atomic<uint64_t> bytesSent{0};
+        std::atomic<uint64_t> messagesDropped{0};
+        std::atomic<uint64_t> congestionEvents{0};
+
+        /* Reactor mode */
+        std::size_t reactor{0};                /* Index of owning event-loop */
+        std::size_t sendOffset{0};             /* Bytes of sending.front() already sent */
+        std::atomic<bool> flushPending{false}; /* Queued on reactor for flushing */
+
+        /* Shared-memory session: messages bypass the socket, outgoingQueue and sender thread */
+        std::unique_ptr<ShmChannel> shm;
     };
 
-    void addClientSession(SocketFD clientSocket);
+    /* channel => shared-memory session set up over clientSocket. No backpressure => default policy */
+    void addClientSession(SocketFD clientSocket, std::unique_ptr<ShmChannel> channel = nullptr, std::optional<BackpressurePolicy> backpressure = std::nullopt);
     void closeSocket(SocketFD socket);
 
+    /* Wakes the session's threads and posts it for cleanup. Idempotent */
     void markSessionAsInactive(ClientSession &session);
     void markAllSessionsAsInactive();
     void cleanupInactiveSessions();
 
+    [[nodiscard]] inline const SocketOptions &socketOptions() const { return _socketOptions; }
+
+    /* Sessions run on event-loops (setReactorThreads()) */
+    [[nodiscard]] inline bool reactorMode() const { return _nReactorThreads > 0; }
+
+    /* eventfd: readable from stop() until the next start(). Poll alongside blocking waits to exit promptly */
+    [[nodiscard]] inline int shutdownFD() const { return _shutdownFD; }
+
     PortSocketMappings _portSocketMappings;
     std::atomic<bool> _active{false};
 
 private:
     using ClientMessage = std::pair<Message, SocketFD>;
 
+    /* Minimum free space in the receive buffer before each recv() */
+    static constexpr std::size_t MinReceiveSize = 2048;
+
+    /* Incoming queue slots per handler shard. Receivers wait while full */
+    static constexpr std::size_t IncomingQueueCapacity = 65536;
+
+    /* Maximum messages handled per incoming queue wake-up */
+    static constexpr std::size_t MaxHandleBatch = 256;
+
+    /* Maximum messages gathered into one sendmsg() */
+    static constexpr std::size_t MaxSendIovecs = 256;
+
+    /* Maximum events returned per epoll_wait() */
+    static constexpr int MaxReactorEvents = 64;
+
+    /* Requests from other threads to an event-loop */
+    enum class ReactorCommand : uint8_t
+    {
+        Flush,    /* Session has newly queued messages */
+        Register, /* io_uring: add session */
+        Remove    /* io_uring: session is being closed */
+    };
+
+    /* io_uring state for one event-loop (defined in ConnectionManager.cpp) */
+    struct UringState;
+
+    /* Event-loop serving a subset of sessions */
+    struct Reactor
+    {
+        Reactor();
+        ~Reactor();
+
+        int epollFD{-1};
+        int wakeFD{-1}; /* eventfd: commands and shutdown */
+
+        std::mutex pendingCommandsMutex;
+        std::vector<std::pair<ReactorCommand, SocketFD>> pendingCommands;
+
+        std::unique_ptr<UringState> uring; /* Null => epoll */
+
+        std::size_t index{0};
+        std::thread thread;
+    };
+
+    /* Extract all complete frames in session's receive buffer into batch */
+    void extractReceivedFrames(ClientSession &session, std::vector<ClientMessage> &batch);
+
+    /* Push batch onto handler shard queues and wake each handler */
+    void queueBatch(std::vector<ClientMessage> &batch);
+
+    /* Push onto its handler shard, waiting while the shard is full. False (message dropped) once stopping */
+    bool pushIncoming(ClientMessage &clientMessage);
+
+    /* Reactor mode */
+    void startReactors();
+    void stopReactors(); /* Wakes and joins event-loops */
+    void waitReactors();
+    void registerWithReactor(ClientSession &session);
+    void unregisterFromReactor(ClientSession &session);
+    void requestFlush(ClientSession &session);
+    void postCommand(Reactor &reactor, ReactorCommand command, SocketFD socket);
+    void reactorLoop(Reactor &reactor);
+    void handleReactorEvent(SocketFD socket, uint32_t events, std::vector<ClientMessage> &batch);
+
+    /* io_uring event-loop */
+    void uringLoop(Reactor &reactor);
+    void handleUringCompletion(Reactor &reactor, uint64_t userData, int result, uint32_t flags, std::vector<ClientMessage> &batch);
+    void handleUringCommand(Reactor &reactor, ReactorCommand command, SocketFD socket);
+    void startUringSend(Reactor &reactor, unsigned slot);
+
+    /* Read until EAGAIN (edge-triggered) */
+    void receiveAvailable(ClientSession &session, std::vector<ClientMessage> &batch);
+
+    /* Apply session's backpressure policy before queueing a message. False => discard it */
+    bool admitOutgoing(ClientSession &session);
+
+    /* Sender has taken n messages off session's outgoing queue. Wakes blocked producers once the
+     * queue is down to the low-water mark */
+    static void releaseOutgoing(ClientSession &session, std::size_t n);
+
+    /* Block policy: sleep until session drains to its low-water mark. Disconnects the session if
+     * that takes longer than its policy's timeout. False => session closed. Never call with
+     * _clientSessionMutex held: cleanup needs it exclusively */
+    bool waitForDrain(ClientSession &session);
+
+    /* Wake producers blocked in waitForDrain() */
+    static void notifyDrained(ClientSession &session);
+
+    /* Notify whichever thread sends for session */
+    void wakeSender(ClientSession &session);
+
+    /* Send queued messages until EAGAIN */
+    void flushOutgoing(ClientSession &session);
+
     void cleanupInactiveSessionsLoop();
 
+    /* Increment eventFD (logged on failure) */
+    static void notifyEventFD(int eventFD);
+
     /* Receive from client. One per connection */
     void connectionLoop(ClientSession &clientSocket);
 
     /* Send to client. One per connection */
     void senderLoop(ClientSession &clientSocket);
 
-    /* Process incoming messages. One per server */
-    void handleMessageLoop();
+    /* Receive from shared-memory peer. One per shared-memory session (all modes) */
+    void shmReceiveLoop(ClientSession &session);
+
+    /* Apply the session's policy and queue message for its sender (or copy it into the shm ring) */
+    void queueOutgoing(ClientSession &session, OutgoingMessage message);
+
+    /* Copy message into the peer's ring, waiting while it is full (disconnects after the policy's
+     * timeout) */
+    void sendOverSharedMemory(ClientSession &session, const Message &message);
+
+    /* Send all of batch with as few sendmsg() calls as possible (extra sendmsg() flags). Waits for
+     * socket space unless flags has MSG_DONTWAIT. False on socket error or once the session closes */
+    bool sendBatch(ClientSession &session, const std::vector<OutgoingMessage> &batch, std::vector<struct iovec> &iov, int flags = 0);
+
+    /* Wait until the session's socket is writable. False once the session closes */
+    static bool waitWritable(ClientSession &session);
+
+    /* Point iov (MaxSendIovecs entries) at messages from first on, skipping offset bytes of
+     * messages[first] already sent. Seqpacket sessions stop at one record. Returns number used */
+    template <typename Messages>
+    static std::size_t gatherIovecs(const ClientSession &session, const Messages &messages, std::size_t first, std::size_t offset, struct iovec *iov);
+
+    /* Advance first/offset past nBytes sent (short writes leave offset inside a message). Returns
+     * the number of messages completed */
+    template <typename Messages>
+    static std::size_t advanceSent(const Messages &messages, std::size_t &first, std::size_t &offset, std::size_t nBytes);
+
+    /* Update session's send statistics */
+    static void recordSend(ClientSession &session, std::size_t nBytes, std::size_t nMessages);
+
+    /* Pin calling thread to the index'th CPU of cpus (if any) */
+    void tuneThread(const std::vector<int> &cpus, std::size_t index) const;
+
+    /* Handler thread with its own queue of incoming messages */
+    struct HandlerShard
+    {
+        HandlerShard(Doorbell::WaitStrategy strategy, std::size_t index) : doorbell(strategy), index(index) {}
+
+        MpscQueue<ClientMessage> queue{IncomingQueueCapacity};
+        Doorbell doorbell;
+        std::size_t index;
+        std::thread thread;
+
+        std::atomic<uint64_t> messagesHandled{0};
+        std::atomic<uint64_t> wakeups{0};
+    };
+
+    /* Process incoming messages. One per handler shard */
+    void handleMessageLoop(HandlerShard &shard);
 
     /* Outgoing message queues */
     std::shared_mutex _clientSessionMutex; /* NB: note the shared mutex */
-    std::unordered_map<SocketFD, std::unique_ptr<ClientSession>> _clientSessionMap;
+    std::unordered_map<SocketFD, std::shared_ptr<ClientSession>> _clientSessionMap; /* Shared: senders pin sessions and drop the lock */
+    std::atomic<std::size_t> _nSessionsCreated{0};
+
+    LowLatencyConfig _lowLatency;
 
-    /* Single incoming message queue */
-    std::condition_variable _incomingMsgQueueCV;
-    std::mutex _incomingMsgQueueMutex;
-    std::queue<ClientMessage> _incomingMsgQueue;
+    /* Socket tuning: default and per outbound server address */
+    SocketOptions _socketOptions;
+    std::unordered_map<std::string, SocketOptions> _outboundSocketOptions; /* By SocketAddress::toString() */
 
-    /* Server threads */
-    std::thread _handleMessageLoopThread;
+    BackpressurePolicy _backpressure;
+    std::unordered_map<std::string, BackpressurePolicy> _outboundBackpressure; /* By SocketAddress::toString() */
+
+    /* Incoming message queues (many receivers => one handler thread each) */
+    std::size_t _nHandlerThreads{1};
+    Doorbell::WaitStrategy _ingressWaitStrategy{Doorbell::defaultStrategy()};
+    std::vector<std::unique_ptr<HandlerShard>> _handlerShards;
+
+    /* Reactor mode: event-loops (empty => thread per connection) */
+    std::size_t _nReactorThreads{0};
+    ReactorBackend _reactorBackend{ReactorBackend::Epoll};
+    std::vector<std::unique_ptr<Reactor>> _reactors;
+    std::atomic<std::size_t> _nextReactor{0};
 
     /* Cleanup inactive session */
     std::thread _cleanupInactiveSessionsThread;
+
+    int _shutdownFD{-1};     /* See shutdownFD() */
+    int _sessionEventFD{-1}; /* eventfd: a session was marked inactive (drained by the cleanup thread) */
 };
\ No newline at end of file
@@ -8,15 +8,27 @@
  */
 
 #pragma once
+#include "fix/FixBinaryCodec.hpp"
+#include "fix/FixBuilder.hpp"
 #include "fix/FixMessage.hpp"
+#include "fix/FixMessageView.hpp"
 #include "fix/FixTag.hpp"
 #include "logger/Logger.hpp"
 #include "socket/ConnectionManager.hpp"
-#include <chrono>
-#include <iomanip>
+#include "socket/FixSequencer.hpp"
+#include "utilities/Clock.hpp"
+#include <exception>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
-// TODO: - also set message sequence #
+/* Value of WireEncoding (9003) requesting/accepting FixBinaryCodec frames */
+inline constexpr std::string_view BinaryEncodingName{"SBE"};
 
 
 template <typename Transport>
@@ -25,50 +37,604 @@ class FixEndpoint : public Transport
 public:
     using Transport::Transport;
 
+    /* Number messages with MsgSeqNo (34), detect inbound gaps and journal outbound messages under
+     * journalDirectory so they can be resent. A session is sequenced once a Logon names it (see
+     * logon()); compID (SenderCompID 49) names this endpoint to its peers. Call before start().
+     * Throws std::runtime_error if the directory cannot be created */
+    void enableSequencing(std::string journalDirectory, std::string compID)
+    {
+        _sequencer = std::make_unique<FixSequencer>(std::move(journalDirectory));
+        _compID = std::move(compID);
+    }
+
 protected:
-    virtual void handleFixMessage(FixMessage message, ConnectionManager::SocketFD serverSocket) = 0;
+    /* NB: the view is only valid for the duration of the call */
+    virtual void handleFixMessage(const FixMessageView &message, ConnectionManager::SocketFD serverSocket) = 0;
 
     virtual void enrichFixMessage(FixMessage &message);
+    virtual void enrichFixMessage(FixBuilder &builder);
 
     void sendFixMessage(FixMessage message, ConnectionManager::SocketFD socket)
+    {
+        enrichFixMessage(message); /* Patched in-place */
+
+        if (auto session = sequencedSession(socket))
+        {
+            sendSequenced(std::move(message), socket, *session);
+            return;
+        }
+
+        if (_sequencer)
+        {
+            message.eraseTag(FixTag::MsgSeqNo); /* Copied from a message received on a sequenced session */
+        }
+
+        /* NB: the outgoing queue owns its copy since the message is freed before it is written */
+        std::string encoded(message.toStringView());
+        Logger::instance().info("Sent FixMsg (destination: " + std::to_string(socket) + "): " + encoded);
+        transmit(std::move(encoded), socket);
+    }
+
+    /* Appends enrichment fields and queues the builder's buffer (see FixBuilder::release()). Call
+     * reset() before reusing it */
+    void sendFixMessage(FixBuilder &builder, ConnectionManager::SocketFD socket)
+    {
+        enrichFixMessage(builder);
+
+        if (auto session = sequencedSession(socket))
+        {
+            std::lock_guard lock(session->sendMutex);
+            builder.set<FixTag::MsgSeqNo>(static_cast<int64_t>(session->journal.nextOutgoingSeqNo()));
+
+            std::string encoded = builder.release();
+            Logger::instance().info("Sent FixMsg (destination: " + std::to_string(socket) + "): " + encoded);
+            transmit(std::move(encoded), socket, session.get());
+            return;
+        }
+
+        std::string encoded = builder.release();
+        Logger::instance().info("Sent FixMsg (destination: " + std::to_string(socket) + "): " + encoded);
+        transmit(std::move(encoded), socket);
+    }
+
+    /* Enriches and serializes once, then queues the same buffer on every socket. Binary sessions
+     * share a single encoded copy; sequenced sessions get their own (MsgSeqNo differs) */
+    void broadcastFixMessage(FixMessage message, const std::vector<ConnectionManager::SocketFD> &sockets)
     {
         enrichFixMessage(message);
-        Logger::instance().info("Sent FixMsg (destination: " + std::to_string(socket) + "): " + message.toString());
-        Transport::sendMessage(message.toString(), socket);
+
+        if (_sequencer)
+        {
+            message.eraseTag(FixTag::MsgSeqNo);
+        }
+
+        std::string encoded(message.toStringView());
+        Logger::instance().info("Broadcast FixMsg (destinations: " + std::to_string(sockets.size()) + "): " + encoded);
+        transmit(std::move(encoded), sockets);
+    }
+
+    /* Appends enrichment fields and shares the builder's buffer (see FixBuilder::release()). Call
+     * reset() before reusing it */
+    void broadcastFixMessage(FixBuilder &builder, const std::vector<ConnectionManager::SocketFD> &sockets)
+    {
+        enrichFixMessage(builder);
+
+        std::string encoded = builder.release();
+        Logger::instance().info("Broadcast FixMsg (destinations: " + std::to_string(sockets.size()) + "): " + encoded);
+        transmit(std::move(encoded), sockets);
+    }
+
+    /* Send Logon (35=A) on an outbound link. Starts sequencing the session if enabled (journal named
+     * by the server address) and optionally asks the peer to switch to binary encoding */
+    void logon(ConnectionManager::SocketFD socket, bool requestBinary = false);
+
+    /* Ask the peer to switch the session to binary encoding (internal links only) */
+    inline void requestBinaryEncoding(ConnectionManager::SocketFD socket) { logon(socket, true); }
+
+    [[nodiscard]] inline bool sequencingEnabled() const { return (_sequencer != nullptr); }
+
+    /* Sequenced sessions with their journal state, ordered by socket */
+    std::vector<std::pair<ConnectionManager::SocketFD, std::string>> sequencingReport() const
+    {
+        return (_sequencer ? _sequencer->report() : std::vector<std::pair<ConnectionManager::SocketFD, std::string>>());
+    }
+
+    void onSessionClosed(ConnectionManager::SocketFD socket) override
+    {
+        if (_sequencer)
+            _sequencer->unbind(socket);
     }
 
     std::string nowUTC() const;
 
 private:
+    using Transport::broadcast;
     using Transport::sendMessage;
 
+    /* Send text FIX, binary-encoded if negotiated for the session. Journaled if session is set */
+    void transmit(std::string encoded, ConnectionManager::SocketFD socket, FixSequencer::Session *session = nullptr);
+
+    /* Encode at most once per wire encoding and share each buffer between its sessions. Sequenced
+     * sessions are sent their own copy */
+    void transmit(std::string encoded, const std::vector<ConnectionManager::SocketFD> &sockets);
+
+    /* Null if sequencing is off or the session has not logged on */
+    inline std::shared_ptr<FixSequencer::Session> sequencedSession(ConnectionManager::SocketFD socket) const
+    {
+        return (_sequencer ? _sequencer->find(socket) : nullptr);
+    }
+
+    /* Stamp the session's next MsgSeqNo, then journal and send */
+    void sendSequenced(FixMessage message, ConnectionManager::SocketFD socket, FixSequencer::Session &session);
+
+    /* MsgType of a text or binary message */
+    static FixMsgType msgTypeOf(std::string_view message);
+
+    /* Logon, ResendRequest and SequenceReset: acted on out of order and never resent */
+    static inline bool isSessionLevel(FixMsgType msgType)
+    {
+        return (msgType == FixMsgType::Logon || msgType == FixMsgType::ResendRequest || msgType == FixMsgType::SequenceReset);
+    }
+
+    /* Sequence checks in arrival order. Binds sessions named by a peer's Logon */
+    bool admitIncoming(const std::string &message, ConnectionManager::SocketFD socket) final;
+
+    /* Ask the peer to resend everything from beginSeqNo. Called on the receiving thread: the request
+     * is queued for a handler thread (as an empty message) so a blocked send cannot stall ingress */
+    void requestResend(FixSequencer::Session &session, ConnectionManager::SocketFD socket, uint64_t beginSeqNo);
+
+    /* Handler thread: send the ResendRequest queued by requestResend() */
+    void sendResendRequest(ConnectionManager::SocketFD socket);
+
+    /* 35=A: session encoding negotiation and sequencing */
+    void handleLogon(const FixMessageView &logon, ConnectionManager::SocketFD socket);
+
+    /* 35=2: replay journaled messages (see resendJournaled()). Session-level and unjournaled
+     * messages are replaced by a SequenceReset-GapFill */
+    void handleResendRequest(const FixMessageView &request, ConnectionManager::SocketFD socket);
+
+    /* Send a journal record again with its MsgSeqNo, PossDupFlag (43=Y), its SendingTime moved to
+     * OrigSendingTime (122) and a fresh SendingTime. Not journaled again */
+    void resendJournaled(std::string_view record, ConnectionManager::SocketFD socket);
+
+    /* 35=4;123=Y: tell the peer that seqNo up to newSeqNo - 1 will not be resent. Reuses seqNo so
+     * it is not journaled */
+    void sendGapFill(ConnectionManager::SocketFD socket, uint64_t seqNo, uint64_t newSeqNo);
+
     void handleMessage(std::string message, ConnectionManager::SocketFD socket) final
     {
-        Logger::instance().info("Received FixMsg (source: " + std::to_string(socket) + "): " + message);
-        handleFixMessage(FixMessage(std::move(message)), socket);
+        if (message.empty()) /* Queued by requestResend(): never received */
+        {
+            sendResendRequest(socket);
+            return;
+        }
+
+        FixMessageView view;
+
+        try
+        {
+            if (FixBinaryCodec::isBinary(message)) /* Indexed in place: never converted to text */
+            {
+                view = FixBinaryCodec::parse(message);
+                Logger::instance().info("Received binary FixMsg (source: " + std::to_string(socket) + ", length: " + std::to_string(message.size()) + ")");
+            }
+            else
+            {
+                Logger::instance().info("Received FixMsg (source: " + std::to_string(socket) + "): " + message);
+                view = FixMessageView(message);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            Logger::instance().error("Dropping malformed FixMsg (source: " + std::to_string(socket) + "): " + e.what());
+            return;
+        }
+
+        if (view.get<FixTag::MsgType>() == FixMsgType::Logon)
+        {
+            handleLogon(view, socket);
+            return;
+        }
+
+        if (view.get<FixTag::MsgType>() == FixMsgType::ResendRequest)
+        {
+            handleResendRequest(view, socket);
+            return;
+        }
+
+        /* NB: runs on a handler thread => an escaping exception would terminate the process */
+        try
+        {
+            handleFixMessage(view, socket);
+        }
+        catch (const std::exception &e)
+        {
+            Logger::instance().error("Failed to handle FixMsg (source: " + std::to_string(socket) + "): " + e.what());
+        }
+    }
+
+    /* Keeps each order on one handler thread: OrigClOrdID (cancel/replace) else ClOrdID, otherwise
+     * the session */
+    std::size_t shardKey(const std::string &message, ConnectionManager::SocketFD socket) const final
+    {
+        bool binary = FixBinaryCodec::isBinary(message);
+
+        for (int tag : {FixTag::OrigClOrdID, FixTag::ClOrdID})
+        {
+            std::string_view key = (binary ? FixBinaryCodec::findValue(message, tag) : FixMessageView::findValue(message, tag));
+            if (!key.empty())
+                return std::hash<std::string_view>{}(key);
+        }
+
+        return Transport::shardKey(message, socket);
     }
+
+    std::unique_ptr<FixSequencer> _sequencer; /* Null => sequencing off */
+    std::string _compID;
 };
 
 
 template <typename Transport>
-void FixEndpoint<Transport>::enrichFixMessage(FixMessage &message)
+void FixEndpoint<Transport>::logon(ConnectionManager::SocketFD socket, bool requestBinary)
 {
-    message.setTag(FixTag::SendingTime, nowUTC());
+    FixMessage logon;
+    logon.set<FixTag::MsgType>(FixMsgType::Logon);
+
+    if (std::string address = Transport::_portSocketMappings.getAddress(socket); _sequencer && !address.empty())
+    {
+        if (auto session = _sequencer->bind(socket, address))
+        {
+            session->logonSent = true;
+            logon.set<FixTag::SenderCompID>(_compID);
+        }
+    }
+
+    if (requestBinary)
+    {
+        Transport::setWireEncoding(socket, ConnectionManager::WireEncoding::BinaryPending);
+        logon.set<FixTag::WireEncoding>(BinaryEncodingName);
+    }
+
+    sendFixMessage(std::move(logon), socket);
 }
 
 
 template <typename Transport>
-std::string FixEndpoint<Transport>::nowUTC() const
+void FixEndpoint<Transport>::handleLogon(const FixMessageView &logon, ConnectionManager::SocketFD socket)
+{
+    const bool binaryRequested = (logon.get<FixTag::WireEncoding>() == BinaryEncodingName);
+    const bool binaryPending = (Transport::wireEncoding(socket) == ConnectionManager::WireEncoding::BinaryPending);
+    auto session = sequencedSession(socket);
+
+    if (binaryPending || (session && session->logonSent))
+    {
+        /* Reply to our Logon */
+        if (binaryPending && binaryRequested)
+        {
+            Transport::setWireEncoding(socket, ConnectionManager::WireEncoding::Binary);
+            Logger::instance().info("Binary encoding accepted (socket: " + std::to_string(socket) + ")");
+        }
+        return;
+    }
+
+    if (!binaryRequested && !session)
+    {
+        return; /* Text only */
+    }
+
+    /* Peer's request: accept in text, then switch */
+    FixMessage reply;
+    reply.set<FixTag::MsgType>(FixMsgType::Logon);
+
+    if (session)
+        reply.set<FixTag::SenderCompID>(_compID);
+    if (binaryRequested)
+        reply.set<FixTag::WireEncoding>(BinaryEncodingName);
+
+    sendFixMessage(std::move(reply), socket);
+
+    if (binaryRequested)
+    {
+        Transport::setWireEncoding(socket, ConnectionManager::WireEncoding::Binary);
+        Logger::instance().info("Binary encoding enabled (socket: " + std::to_string(socket) + ")");
+    }
+}
+
+
+template <typename Transport>
+void FixEndpoint<Transport>::sendSequenced(FixMessage message, ConnectionManager::SocketFD socket, FixSequencer::Session &session)
+{
+    std::lock_guard lock(session.sendMutex);
+    message.set<FixTag::MsgSeqNo>(static_cast<int64_t>(session.journal.nextOutgoingSeqNo()));
+
+    std::string encoded(message.toStringView());
+    Logger::instance().info("Sent FixMsg (destination: " + std::to_string(socket) + "): " + encoded);
+    transmit(std::move(encoded), socket, &session);
+}
+
+
+template <typename Transport>
+void FixEndpoint<Transport>::transmit(std::string encoded, ConnectionManager::SocketFD socket, FixSequencer::Session *session)
+{
+    if (Transport::wireEncoding(socket) == ConnectionManager::WireEncoding::Binary)
+    {
+        try
+        {
+            encoded = FixBinaryCodec::encode(FixMessageView(encoded));
+        }
+        catch (const std::exception &e)
+        {
+            Logger::instance().error("Sending as text: " + std::string(e.what())); /* Peer decodes either */
+        }
+    }
+
+    if (session)
+    {
+        session->journal.append(encoded); /* Bytes as sent: resends add PossDupFlag (43) */
+    }
+
+    Transport::sendMessage(std::move(encoded), socket);
+}
+
+
+template <typename Transport>
+void FixEndpoint<Transport>::transmit(std::string encoded, const std::vector<ConnectionManager::SocketFD> &sockets)
+{
+    std::vector<ConnectionManager::SocketFD> textSockets;
+    std::vector<ConnectionManager::SocketFD> binarySockets;
+
+    for (auto socket : sockets)
+    {
+        if (auto session = sequencedSession(socket))
+        {
+            sendSequenced(FixMessage(encoded), socket, *session);
+            continue;
+        }
+
+        bool binary = (Transport::wireEncoding(socket) == ConnectionManager::WireEncoding::Binary);
+        (binary ? binarySockets : textSockets).push_back(socket);
+    }
+
+    if (!binarySockets.empty())
+    {
+        try
+        {
+            Transport::broadcast(std::make_shared<const std::string>(FixBinaryCodec::encode(FixMessageView(encoded))), binarySockets);
+        }
+        catch (const std::exception &e)
+        {
+            Logger::instance().error("Sending as text: " + std::string(e.what())); /* Peer decodes either */
+            textSockets.insert(textSockets.end(), binarySockets.begin(), binarySockets.end());
+        }
+    }
+
+    if (!textSockets.empty())
+    {
+        Transport::broadcast(std::make_shared<const std::string>(std::move(encoded)), textSockets);
+    }
+}
+
+
+template <typename Transport>
+FixMsgType FixEndpoint<Transport>::msgTypeOf(std::string_view message)
+{
+    if (FixBinaryCodec::isBinary(message))
+    {
+        return (message.size() >= FixBinaryCodec::HeaderLength ? FixBinaryCodec::msgType(message) : FixMsgType::Unknown);
+    }
+
+    return FixCodec::parseMsgType(FixMessageView::findValue(message, FixTag::MsgType));
+}
+
+
+template <typename Transport>
+bool FixEndpoint<Transport>::admitIncoming(const std::string &message, ConnectionManager::SocketFD socket)
+{
+    if (!_sequencer)
+    {
+        return true;
+    }
+
+    const bool binary = FixBinaryCodec::isBinary(message);
+    auto valueOf = [&message, binary](int tag)
+    {
+        return (binary ? FixBinaryCodec::findValue(message, tag) : FixMessageView::findValue(message, tag));
+    };
+
+    const int64_t seqNo = FixCodec::parseInt(valueOf(FixTag::MsgSeqNo));
+    if (seqNo <= 0)
+    {
+        return true; /* Peer does not sequence */
+    }
+
+    const FixMsgType msgType = msgTypeOf(message);
+    auto session = _sequencer->find(socket);
+
+    if (!session && msgType == FixMsgType::Logon && !valueOf(FixTag::SenderCompID).empty())
+    {
+        session = _sequencer->bind(socket, std::string(valueOf(FixTag::SenderCompID)));
+    }
+
+    if (!session)
+    {
+        return true;
+    }
+
+    const uint64_t expected = session->journal.expectedIncomingSeqNo();
+
+    if (msgType == FixMsgType::SequenceReset)
+    {
+        const int64_t newSeqNo = FixCodec::parseInt(valueOf(FixTag::NewSeqNo));
+
+        if (valueOf(FixTag::GapFillFlag) != "Y") /* Reset: MsgSeqNo is ignored */
+        {
+            session->journal.setExpectedIncomingSeqNo(static_cast<uint64_t>(std::max<int64_t>(newSeqNo, 1)));
+            session->resendRequested = false;
+        }
+        else if (auto check = _sequencer->checkIncoming(*session, seqNo); check == FixSequencer::Check::InOrder)
+        {
+            session->journal.setExpectedIncomingSeqNo(std::max(static_cast<uint64_t>(std::max<int64_t>(newSeqNo, 0)), expected + 1));
+        }
+        else if (check == FixSequencer::Check::NewGap)
+        {
+            requestResend(*session, socket, expected);
+        }
+
+        return false;
+    }
+
+    switch (_sequencer->checkIncoming(*session, seqNo))
+    {
+        case FixSequencer::Check::InOrder:
+            return true;
+        case FixSequencer::Check::Duplicate:
+            if (msgType == FixMsgType::Logon) /* Peer restarted without its journal */
+            {
+                Logger::instance().error("Logon MsgSeqNo " + std::to_string(seqNo) + " below expected " + std::to_string(expected) + " => Resetting (socket: " + std::to_string(socket) + ")");
+                session->journal.setExpectedIncomingSeqNo(seqNo + 1);
+                return true;
+            }
+
+            Logger::instance().warn("Discarding duplicate MsgSeqNo " + std::to_string(seqNo) + " (socket: " + std::to_string(socket) + ")");
+            return false;
+        case FixSequencer::Check::NewGap:
+            Logger::instance().error("Sequence gap: expected " + std::to_string(expected) + ", received " + std::to_string(seqNo) + " (socket: " + std::to_string(socket) + ")");
+            requestResend(*session, socket, expected);
+            return isSessionLevel(msgType);
+        default: /* Resend already requested: message will be resent */
+            return isSessionLevel(msgType);
+    }
+}
+
+
+template <typename Transport>
+void FixEndpoint<Transport>::requestResend(FixSequencer::Session &session, ConnectionManager::SocketFD socket, uint64_t beginSeqNo)
+{
+    session.resendFrom.store(beginSeqNo, std::memory_order_relaxed);
+    Transport::queueIncoming(std::string(), socket);
+}
+
+
+template <typename Transport>
+void FixEndpoint<Transport>::sendResendRequest(ConnectionManager::SocketFD socket)
+{
+    auto session = sequencedSession(socket);
+    const uint64_t beginSeqNo = (session ? session->resendFrom.exchange(0, std::memory_order_relaxed) : 0);
+
+    if (beginSeqNo == 0) /* Session closed, or request already sent */
+    {
+        return;
+    }
+
+    FixMessage request;
+    request.set<FixTag::MsgType>(FixMsgType::ResendRequest);
+    request.set<FixTag::BeginSeqNo>(static_cast<int64_t>(beginSeqNo));
+    request.set<FixTag::EndSeqNo>(0);
+
+    sendFixMessage(std::move(request), socket);
+}
+
+
+template <typename Transport>
+void FixEndpoint<Transport>::handleResendRequest(const FixMessageView &request, ConnectionManager::SocketFD socket)
 {
-    auto now = std::chrono::system_clock::now();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+    auto session = sequencedSession(socket);
+    if (!session)
+    {
+        Logger::instance().error("Ignoring ResendRequest on unsequenced session (socket: " + std::to_string(socket) + ")");
+        return;
+    }
 
-    std::time_t currentTime = std::chrono::system_clock::to_time_t(now);
+    std::lock_guard lock(session->sendMutex); /* Live messages queue behind the resend */
 
-    std::ostringstream os;
+    const uint64_t last = session->journal.nextOutgoingSeqNo() - 1;
+    const uint64_t begin = static_cast<uint64_t>(std::max<int64_t>(request.get<FixTag::BeginSeqNo>(), 1));
+    const int64_t requestedEnd = request.get<FixTag::EndSeqNo>();
+    const uint64_t end = (requestedEnd <= 0 ? last : std::min(static_cast<uint64_t>(requestedEnd), last));
 
-    struct tm currentGMTime; /* gmtime_r is a thread-safe verison */
-    os << std::put_time(gmtime_r(&currentTime, &currentGMTime), "%Y%m%d-%H:%M:%S") << "." << std::setw(3) << std::setfill('0') << ms;
+    Logger::instance().info("Resending MsgSeqNo " + std::to_string(begin) + " to " + std::to_string(end) + " (socket: " + std::to_string(socket) + ")");
+
+    uint64_t gapStart = 0; /* First of a run replaced by a gap fill (0 => none) */
+
+    for (uint64_t seqNo = begin; seqNo <= end; ++seqNo)
+    {
+        std::string_view record = session->journal.find(seqNo);
 
-    return os.str();
+        if (record.empty() || isSessionLevel(msgTypeOf(record)))
+        {
+            if (gapStart == 0)
+                gapStart = seqNo;
+            continue;
+        }
+
+        if (gapStart != 0)
+        {
+            sendGapFill(socket, gapStart, seqNo);
+            gapStart = 0;
+        }
+
+        resendJournaled(record, socket);
+    }
+
+    if (gapStart != 0)
+    {
+        sendGapFill(socket, gapStart, end + 1);
+    }
+}
+
+
+template <typename Transport>
+void FixEndpoint<Transport>::resendJournaled(std::string_view record, ConnectionManager::SocketFD socket)
+{
+    FixMessage message(FixBinaryCodec::isBinary(record) ? FixBinaryCodec::parse(record) : FixMessageView(record));
+
+    if (message.hasTag(FixTag::SendingTime))
+    {
+        message.setTag(FixTag::OrigSendingTime, message.getValue(FixTag::SendingTime));
+    }
+
+    message.set<FixTag::PossDupFlag>("Y");
+    enrichFixMessage(message);
+
+    std::string encoded(message.toStringView());
+    Logger::instance().info("Resent FixMsg (destination: " + std::to_string(socket) + "): " + encoded);
+    transmit(std::move(encoded), socket);
+}
+
+
+template <typename Transport>
+void FixEndpoint<Transport>::sendGapFill(ConnectionManager::SocketFD socket, uint64_t seqNo, uint64_t newSeqNo)
+{
+    FixMessage gapFill;
+    gapFill.set<FixTag::MsgType>(FixMsgType::SequenceReset);
+    gapFill.set<FixTag::MsgSeqNo>(static_cast<int64_t>(seqNo));
+    gapFill.set<FixTag::GapFillFlag>("Y");
+    gapFill.set<FixTag::NewSeqNo>(static_cast<int64_t>(newSeqNo));
+    enrichFixMessage(gapFill);
+
+    std::string encoded(gapFill.toStringView());
+    Logger::instance().info("Sent FixMsg (destination: " + std::to_string(socket) + "): " + encoded);
+    transmit(std::move(encoded), socket);
+}
+
+
+template <typename Transport>
+void FixEndpoint<Transport>::enrichFixMessage(FixMessage &message)
+{
+    char buffer[Clock::MaxFormattedLength];
+    message.setTag(FixTag::SendingTime, std::string_view(buffer, Clock::formatUTC(buffer)));
+}
+
+
+template <typename Transport>
+void FixEndpoint<Transport>::enrichFixMessage(FixBuilder &builder)
+{
+    builder.appendTimestamp(FixTag::SendingTime);
+}
+
+
+template <typename Transport>
+std::string FixEndpoint<Transport>::nowUTC() const
+{
+    return Clock::nowUTC(Clock::Milliseconds);
 }
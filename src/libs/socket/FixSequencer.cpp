@@ -0,0 +1,153 @@
+/**
+ * @file FixSequencer.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FixSequencer.hpp"
+#include "logger/Logger.hpp"
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+
+FixSequencer::FixSequencer(std::string journalDirectory) : _journalDirectory(std::move(journalDirectory))
+{
+    std::error_code error;
+    std::filesystem::create_directories(_journalDirectory, error);
+
+    if (error)
+    {
+        throw std::runtime_error("Failed to create journal directory " + _journalDirectory + ": " + error.message());
+    }
+}
+
+
+std::shared_ptr<FixSequencer::Session> FixSequencer::bind(SocketFD socket, const std::string &sessionName)
+{
+    std::unique_lock lock(_mutex);
+
+    if (auto iter = _sessions.find(socket); iter != _sessions.end())
+    {
+        return iter->second;
+    }
+
+    for (const auto &[boundSocket, session] : _sessions)
+    {
+        if (session->name == sessionName)
+        {
+            Logger::instance().error("Session " + sessionName + " already bound to socket " + std::to_string(boundSocket) + " => Not sequencing socket " + std::to_string(socket));
+            return nullptr;
+        }
+    }
+
+    auto &journal = _journals[sessionName];
+
+    if (!journal)
+    {
+        try
+        {
+            journal = std::make_unique<FixJournal>(journalPath(sessionName));
+        }
+        catch (const std::exception &e)
+        {
+            _journals.erase(sessionName);
+            Logger::instance().error(std::string(e.what()) + " => Not sequencing socket " + std::to_string(socket));
+            return nullptr;
+        }
+    }
+
+    auto session = std::make_shared<Session>(sessionName, *journal);
+    _sessions.emplace(socket, session);
+
+    Logger::instance().info("Sequencing session " + sessionName + " (socket: " + std::to_string(socket) + ", next outgoing: " + std::to_string(journal->nextOutgoingSeqNo()) +
+                            ", expected incoming: " + std::to_string(journal->expectedIncomingSeqNo()) + ")");
+    return session;
+}
+
+
+void FixSequencer::unbind(SocketFD socket)
+{
+    std::unique_lock lock(_mutex);
+    _sessions.erase(socket);
+}
+
+
+std::shared_ptr<FixSequencer::Session> FixSequencer::find(SocketFD socket) const
+{
+    std::shared_lock lock(_mutex);
+
+    auto iter = _sessions.find(socket);
+    return (iter != _sessions.end() ? iter->second : nullptr);
+}
+
+
+FixSequencer::Check FixSequencer::checkIncoming(Session &session, uint64_t seqNo)
+{
+    const uint64_t expected = session.journal.expectedIncomingSeqNo();
+
+    if (seqNo == expected)
+    {
+        session.journal.setExpectedIncomingSeqNo(seqNo + 1);
+        session.resendRequested = false;
+        return Check::InOrder;
+    }
+
+    if (seqNo < expected)
+    {
+        return Check::Duplicate;
+    }
+
+    if (session.resendRequested)
+    {
+        return Check::Gap;
+    }
+
+    session.resendRequested = true;
+    return Check::NewGap;
+}
+
+
+std::vector<std::pair<FixSequencer::SocketFD, std::string>> FixSequencer::report() const
+{
+    std::vector<std::pair<SocketFD, std::string>> result;
+
+    {
+        std::shared_lock lock(_mutex);
+        result.reserve(_sessions.size());
+
+        for (const auto &[socket, session] : _sessions)
+        {
+            FixJournal::Stats stats = session->journal.stats();
+
+            std::ostringstream line;
+            line << "session=" << session->name << ",out=" << stats.nextOutgoingSeqNo << ",in=" << stats.expectedIncomingSeqNo << ",records=" << stats.records
+                 << ",used=" << stats.bytesUsed << "/" << stats.capacity;
+            result.emplace_back(socket, line.str());
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    return result;
+}
+
+
+std::string FixSequencer::journalPath(const std::string &sessionName) const
+{
+    std::string fileName = sessionName;
+
+    for (char &c : fileName)
+    {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '.' && c != '-' && c != '_')
+            c = '_';
+    }
+
+    return (std::filesystem::path(_journalDirectory) / (fileName + ".journal")).string();
+}
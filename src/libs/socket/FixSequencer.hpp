@@ -0,0 +1,84 @@
+/**
+ * @file FixSequencer.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "ConnectionManager.hpp"
+#include "fix/FixJournal.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+/**
+ * MsgSeqNo (34) state of sequenced FIX sessions, each backed by a FixJournal.
+ *
+ * A socket is sequenced once bound to a session name: the peer's SenderCompID (49) on accepted
+ * sessions or the server address on outbound links. Journals stay open by name, so a peer that
+ * reconnects (or this process after a restart) resumes the same numbering.
+ */
+class FixSequencer
+{
+public:
+    using SocketFD = ConnectionManager::SocketFD;
+
+    /* Creates journalDirectory if needed. Throws std::runtime_error on failure */
+    explicit FixSequencer(std::string journalDirectory);
+
+    struct Session
+    {
+        Session(std::string name, FixJournal &journal) : name(std::move(name)), journal(journal) {}
+
+        const std::string name;
+        FixJournal &journal;
+
+        std::mutex sendMutex;        /* Held from stamping MsgSeqNo until the message is queued */
+        bool resendRequested{false}; /* Gap reported and not yet filled. Receiving thread only */
+        bool logonSent{false};       /* We initiated the Logon: the peer's Logon is the reply */
+
+        std::atomic<uint64_t> resendFrom{0}; /* BeginSeqNo of a ResendRequest queued for a handler thread (0 => none) */
+    };
+
+    /* Sequence socket as sessionName, opening or creating its journal. Null if the name is already
+     * bound to another socket or the journal cannot be opened */
+    std::shared_ptr<Session> bind(SocketFD socket, const std::string &sessionName);
+    void unbind(SocketFD socket);
+
+    /* Null if socket is not sequenced */
+    [[nodiscard]] std::shared_ptr<Session> find(SocketFD socket) const;
+
+    enum class Check
+    {
+        InOrder,   /* Expected number: advanced */
+        Duplicate, /* Already received */
+        NewGap,    /* Ahead of expected: request a resend */
+        Gap        /* Ahead of expected with a resend already requested */
+    };
+
+    /* Compare seqNo with the session's expected incoming number */
+    Check checkIncoming(Session &session, uint64_t seqNo);
+
+    /* Sequenced sockets with their journal state, ordered by socket */
+    std::vector<std::pair<SocketFD, std::string>> report() const;
+
+private:
+    /* Journal file for sessionName (characters other than [A-Za-z0-9._-] replaced) */
+    std::string journalPath(const std::string &sessionName) const;
+
+    std::string _journalDirectory;
+
+    mutable std::shared_mutex _mutex;
+    std::unordered_map<std::string, std::unique_ptr<FixJournal>> _journals; /* Open for the process lifetime */
+    std::unordered_map<SocketFD, std::shared_ptr<Session>> _sessions;
+};
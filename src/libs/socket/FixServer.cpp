@@ -8,23 +8,95 @@
  */
 
 #include "socket/FixServer.hpp"
+#include "fix/FixMessagePool.hpp"
+#include <algorithm>
 #include <sstream>
 
 
 void FixServer::onStartup()
 {
+    /* Freeze handlers before we start accepting connections */
+    rebuildDispatchTable();
+    onRegisterNetAdminCmds();
+
     FixEndpoint<Server>::onStartup();
+}
+
+
+void FixServer::rebuildDispatchTable()
+{
+    std::lock_guard guard(_dispatchTableMutex);
+
+    _pendingDispatchTable = std::make_unique<DispatchTable>();
     onRegisterMsgTypes();
-    onRegisterNetAdminCmds();
+
+    publishDispatchTable(std::move(_pendingDispatchTable));
+}
+
+
+void FixServer::publishDispatchTable(std::unique_ptr<const DispatchTable> table)
+{
+    _dispatchTable.store(table.get(), std::memory_order_seq_cst);
+
+    if (_liveDispatchTable)
+    {
+        _retiredDispatchTables.push_back(std::move(_liveDispatchTable));
+    }
+
+    _liveDispatchTable = std::move(table);
+    reclaimDispatchTables();
+}
+
+
+void FixServer::reclaimDispatchTables()
+{
+    /* NB: deferred rather than waited for since a handler (msgtypes.reload) may be the writer */
+    auto drained = [this](unsigned int phase) -> bool
+    {
+        for (const auto &slot : _readerSlots)
+        {
+            if (slot.readers[phase].load(std::memory_order_seq_cst) != 0)
+                return false;
+        }
+
+        return true;
+    };
+
+    unsigned int phase = _readerPhase.load(std::memory_order_relaxed);
+
+    if (!_drainingDispatchTables.empty())
+    {
+        if (!drained(phase ^ 1))
+        {
+            return; /* Still in use. Retry on the next publish */
+        }
+
+        _drainingDispatchTables.clear();
+    }
+
+    if (_retiredDispatchTables.empty())
+    {
+        return;
+    }
+
+    /* Readers arriving after the flip count in the new phase and load the new table */
+    _drainingDispatchTables = std::move(_retiredDispatchTables);
+    _retiredDispatchTables.clear();
+    _readerPhase.store(phase ^ 1, std::memory_order_seq_cst);
+
+    if (drained(phase))
+    {
+        _drainingDispatchTables.clear();
+    }
 }
 
 
 void FixServer::onRegisterMsgTypes()
 {
     /* TODO: - other servers should override this to add their own registered types */
-    auto handler = [this](FixMessage fixMsg, SocketFD netAdminSocket) -> void
+    auto handler = [this](const FixMessageView &fixMsg, SocketFD netAdminSocket) -> void
     {
-        std::string adminCmd = fixMsg.getValue(FixTag::AdminCommand);
+        std::string adminCmd(fixMsg.getValue(FixTag::AdminCommand));
 
         NetAdminCmdMap::iterator iter;
 
@@ -41,16 +113,30 @@ void FixServer::onRegisterMsgTypes()
         iter->second(netAdminSocket);
     };
 
-    registerMsgTypeHandler("QR", std::move(handler));
+    registerMsgTypeHandler(FixMsgType::AdminRequest, std::move(handler));
 }
 
 
-void FixServer::registerMsgTypeHandler(std::string msgType, MsgTypeHandler handler)
+void FixServer::registerMsgTypeHandler(FixMsgType msgType, MsgTypeHandler handler)
 {
-    Logger::instance().debug("Registering MsgType " + msgType);
+    char buffer[FixCodec::MaxEncodedLength];
+    Logger::instance().debug("Registering MsgType " + std::string(FixCodec::formatMsgType(msgType, buffer)));
+
+    std::lock_guard guard(_dispatchTableMutex); /* NB: recursive since called from onRegisterMsgTypes() */
+
+    if (_pendingDispatchTable) /* Building */
+    {
+        _pendingDispatchTable->add(msgType, std::move(handler));
+        return;
+    }
+
+    /* Runtime change: copy the live table, add handler and swap */
+    const DispatchTable *current = _dispatchTable.load(std::memory_order_acquire);
+
+    auto table = (current ? std::make_unique<DispatchTable>(*current) : std::make_unique<DispatchTable>());
+    table->add(msgType, std::move(handler));
 
-    std::unique_lock guard(_handlerForMsgTypeMutex);
-    _handlerForMsgType[msgType] = std::move(handler);
+    publishDispatchTable(std::move(table));
 }
 
 
@@ -60,8 +146,7 @@ void FixServer::onRegisterNetAdminCmds()
     registerNetAdminCmdHandler("shutdown", [this](SocketFD socket)
     {
         sendNetAdminResponse("Commencing shutdown", socket);
-        stop();
-        wait();
+        stop(); /* NB: no wait() on a handler thread; the owner's wait() returns once stopped */
     });
 
     /* Lists available commands */
@@ -80,6 +165,172 @@ void FixServer::onRegisterNetAdminCmds()
         sendNetAdminResponse(responseOS.str(), socket);
     });
 
+    /* Lists registered MsgTypes */
+    registerNetAdminCmdHandler("msgtypes.list", [this](SocketFD socket)
+    {
+        std::ostringstream responseOS;
+
+        const DispatchTable *table = _dispatchTable.load(std::memory_order_acquire);
+        if (table)
+        {
+            char buffer[FixCodec::MaxEncodedLength];
+            for (FixMsgType msgType : table->msgTypes())
+            {
+                responseOS << FixCodec::formatMsgType(msgType, buffer) << '\n';
+            }
+        }
+
+        sendNetAdminResponse(responseOS.str(), socket);
+    });
+
+    /* Rebuilds MsgType handlers and swaps them in without pausing message handling */
+    registerNetAdminCmdHandler("msgtypes.reload", [this](SocketFD socket)
+    {
+        rebuildDispatchTable();
+        sendNetAdminResponse("Reloaded MsgType handlers", socket);
+    });
+
+    /* FixMessage pool occupancy (one line per pool) */
+    registerNetAdminCmdHandler("pool.stats", [this](SocketFD socket)
+    {
+        std::ostringstream responseOS;
+
+        auto allStats = FixMessagePool::allStats();
+        for (std::size_t i = 0; i < allStats.size(); ++i)
+        {
+            const auto &stats = allStats[i];
+            responseOS << "pool " << i << (stats.threadAttached ? "" : " (idle)") << ": inUse=" << stats.bytesInUse << "B peak=" << stats.peakBytesInUse
+                       << "B reserved=" << stats.bytesReserved << "B allocations=" << stats.allocations << " heapAllocations=" << stats.upstreamAllocations
+                       << " offThread=" << stats.offThreadAllocations << '\n';
+        }
+
+        sendNetAdminResponse(responseOS.str(), socket);
+    });
+
+    /* Send coalescing per session (one line per session) */
+    registerNetAdminCmdHandler("send.stats", [this](SocketFD socket)
+    {
+        std::ostringstream responseOS;
+
+        for (const auto &[sessionSocket, stats] : sendStats())
+        {
+            double perSyscall = (stats.syscalls ? static_cast<double>(stats.messages) / stats.syscalls : 0.0);
+            responseOS << "socket " << sessionSocket << ": syscalls=" << stats.syscalls << " messages=" << stats.messages << " bytes=" << stats.bytes
+                       << " messages/syscall=" << perSyscall << " bytes/syscall=" << (stats.syscalls ? stats.bytes / stats.syscalls : 0) << '\n';
+        }
+
+        sendNetAdminResponse(responseOS.str(), socket);
+    });
+
+    /* Outgoing queue depth and backpressure per session (one line per session) */
+    registerNetAdminCmdHandler("queue.stats", [this](SocketFD socket)
+    {
+        std::ostringstream responseOS;
+
+        for (const auto &[sessionSocket, stats] : outgoingQueueStats())
+        {
+            responseOS << "socket " << sessionSocket << ": depth=" << stats.depth << (stats.congested ? " (congested)" : "") << " dropped=" << stats.dropped
+                       << " congestionEvents=" << stats.congestionEvents << " " << stats.policy.describe() << '\n';
+        }
+
+        sendNetAdminResponse(responseOS.str(), socket);
+    });
+
+    /* Accept load per acceptor thread and system-wide accept queue drops */
+    registerNetAdminCmdHandler("accept.stats", [this](SocketFD socket)
+    {
+        std::ostringstream responseOS;
+
+        auto allStats = acceptorStats();
+        double uptime = std::max(uptimeSeconds(), 1e-3);
+
+        /* accepts/s: since the previous accept.stats (or startup); avgAccepts/s: over the uptime */
+        std::lock_guard lock(_acceptStatsMutex);
+
+        double window = std::max(uptime - _uptimeAtLastAcceptStats, 1e-3);
+        _acceptedAtLastAcceptStats.resize(allStats.size(), 0);
+
+        responseOS << "window=" << window << "s\n";
+
+        for (std::size_t i = 0; i < allStats.size(); ++i)
+        {
+            const auto &stats = allStats[i];
+            double rate = static_cast<double>(stats.accepted - _acceptedAtLastAcceptStats[i]) / window;
+
+            responseOS << "acceptor " << i << ": accepted=" << stats.accepted << " accepts/s=" << rate << " avgAccepts/s=" << stats.accepted / uptime
+                       << " wakeups=" << stats.wakeups << " peakBatch=" << stats.peakBatch << " errors=" << stats.errors << " queued=" << stats.queued << "/"
+                       << stats.backlog << '\n';
+
+            _acceptedAtLastAcceptStats[i] = stats.accepted;
+        }
+
+        _uptimeAtLastAcceptStats = uptime;
+
+        auto [overflows, drops] = listenDrops();
+        responseOS << "system: listenOverflows=" << overflows << " listenDrops=" << drops << '\n';
+
+        sendNetAdminResponse(responseOS.str(), socket);
+    });
+
+    /* MsgSeqNo state and journal usage per sequenced session */
+    registerNetAdminCmdHandler("seq.stats", [this](SocketFD socket)
+    {
+        std::ostringstream responseOS;
+
+        if (!sequencingEnabled())
+        {
+            responseOS << "Sequencing disabled\n";
+        }
+
+        for (const auto &[sessionSocket, state] : sequencingReport())
+        {
+            responseOS << "socket " << sessionSocket << ": " << state << '\n';
+        }
+
+        sendNetAdminResponse(responseOS.str(), socket);
+    });
+
+    /* Effective socket tuning (read back from the kernel) for the listening socket and each session */
+    registerNetAdminCmdHandler("socket.options", [this](SocketFD socket)
+    {
+        std::ostringstream responseOS;
+        for (SocketFD listeningSocket : listenSockets())
+        {
+            responseOS << "listen " << listeningSocket << ": " << SocketOptions::describe(listeningSocket) << '\n';
+        }
+
+        for (const auto &[sessionSocket, options] : socketOptionsReport())
+        {
+            responseOS << "socket " << sessionSocket << ": " << options << '\n';
+        }
+
+        sendNetAdminResponse(responseOS.str(), socket);
+    });
+
+    /* Handler thread load. Imbalance is busiest shard / mean (1 => even) */
+    registerNetAdminCmdHandler("shard.stats", [this](SocketFD socket)
+    {
+        std::ostringstream responseOS;
+
+        auto allStats = handlerShardStats();
+        uint64_t total = 0, busiest = 0;
+
+        for (std::size_t i = 0; i < allStats.size(); ++i)
+        {
+            const auto &stats = allStats[i];
+            responseOS << "shard " << i << ": messages=" << stats.messages << " wakeups=" << stats.wakeups
+                       << " messages/wakeup=" << (stats.wakeups ? static_cast<double>(stats.messages) / stats.wakeups : 0.0) << '\n';
+
+            total += stats.messages;
+            busiest = std::max(busiest, stats.messages);
+        }
+
+        double mean = (allStats.empty() ? 0.0 : static_cast<double>(total) / allStats.size());
+        responseOS << "imbalance=" << (mean > 0.0 ? busiest / mean : 1.0) << '\n';
+
+        sendNetAdminResponse(responseOS.str(), socket);
+    });
+
     /* TODO: - add additional commands to log statistics, performance, etc */
 }
 
@@ -100,29 +351,40 @@ void FixServer::sendNetAdminResponse(std::string response, SocketFD netAdminSock
         Logger::instance().error("Invalid response/destination => Ignoring.");
     }
 
-    FixMessage responseFix;
-    responseFix.setTag(FixTag::MsgType, "QR");
-    responseFix.setTag(FixTag::AdminResponse, std::move(response));
+    /* Responses (e.g. command lists) are unbounded => size the buffer for this response */
+    FixBuilder responseFix(response.size() + 128);
+    responseFix.set<FixTag::MsgType>(FixMsgType::AdminRequest);
+    responseFix.append(FixTag::AdminResponse, response);
 
-    sendFixMessage(std::move(responseFix), netAdminSocket);
+    sendFixMessage(responseFix, netAdminSocket);
 }
 
 
-void FixServer::handleFixMessage(FixMessage message, SocketFD socket)
+void FixServer::handleFixMessage(const FixMessageView &message, SocketFD socket)
 {
-    std::string msgType(message.getValue(FixTag::MsgType));
+    static std::atomic<std::size_t> nextReaderSlot{0};
+    thread_local const std::size_t readerSlot = nextReaderSlot.fetch_add(1, std::memory_order_relaxed) % NumReaderSlots;
 
-    MsgTypeHandlerMap::iterator iter;
+    /* Hold the table for the duration of the handler (see reclaimDispatchTables) */
+    unsigned int phase = _readerPhase.load(std::memory_order_seq_cst);
 
+    std::atomic<uint64_t> &readers = _readerSlots[readerSlot].readers[phase];
+    readers.fetch_add(1, std::memory_order_seq_cst);
+
+    struct Release
     {
-        std::shared_lock guard(_handlerForMsgTypeMutex);
-        iter = _handlerForMsgType.find(msgType);
-        if (iter == _handlerForMsgType.end())
-        {
-            Logger::instance().error("No handler registered for msgType " + msgType);
-            return;
-        }
+        std::atomic<uint64_t> &readers;
+        ~Release() { readers.fetch_sub(1, std::memory_order_release); }
+    } release{readers};
+
+    const DispatchTable *table = _dispatchTable.load(std::memory_order_seq_cst);
+    const MsgTypeHandler *handler = (table ? table->find(message.get<FixTag::MsgType>()) : nullptr);
+
+    if (!handler)
+    {
+        Logger::instance().error("No handler registered for msgType " + std::string(message.getValue(FixTag::MsgType)));
+        return;
     }
 
-    iter->second(std::move(message), socket); /* Call */
+    (*handler)(message, socket); /* Call */
 }
@@ -9,23 +9,32 @@
 
 #pragma once
 #include "FixEndpoint.hpp"
+#include "MsgTypeDispatchTable.hpp"
 #include "Server.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <fix/FixMessage.hpp>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 
 class FixServer : public FixEndpoint<Server>
 {
 protected:
     using NetAdminCmdHandler = std::function<void(SocketFD)>;
-    using MsgTypeHandler = std::function<void(FixMessage, SocketFD)>;
+    using MsgTypeHandler = std::function<void(const FixMessageView &, SocketFD)>;
 
-    FixServer(Port port) : FixEndpoint<Server>(port) {}
+    FixServer(SocketAddress address) : FixEndpoint<Server>(std::move(address)) {}
 
-    void registerMsgTypeHandler(std::string msgType, MsgTypeHandler handler);
+    /* Called from onRegisterMsgTypes(). Any later call publishes a new table (copy-on-write) */
+    void registerMsgTypeHandler(FixMsgType msgType, MsgTypeHandler handler);
     void registerNetAdminCmdHandler(std::string cmd, NetAdminCmdHandler handler);
 
     void sendNetAdminResponse(std::string response, SocketFD netAdminSocket);
@@ -39,14 +48,49 @@ private:
     void onStartup() final;
 
     /* Maps message to registered handler */
-    void handleFixMessage(FixMessage message, SocketFD socket) final;
+    void handleFixMessage(const FixMessageView &message, SocketFD socket) final;
+
+    /* Re-runs onRegisterMsgTypes() into a new table and swaps it in atomically */
+    void rebuildDispatchTable();
+
+    /* Atomically replace the live table and retire the old one. Requires _dispatchTableMutex */
+    void publishDispatchTable(std::unique_ptr<const MsgTypeDispatchTable<MsgTypeHandler>> table);
+
+    /* Free retired tables no handler can still be reading. Requires _dispatchTableMutex */
+    void reclaimDispatchTables();
 
     using NetAdminCmdMap = std::unordered_map<std::string, NetAdminCmdHandler>;
-    using MsgTypeHandlerMap = std::unordered_map<std::string, MsgTypeHandler>;
+    using DispatchTable = MsgTypeDispatchTable<MsgTypeHandler>;
 
     NetAdminCmdMap _handlerForNetAdminCmd;
     std::shared_mutex _netadminCmdsMutex;
 
-    MsgTypeHandlerMap _handlerForMsgType;
-    std::shared_mutex _handlerForMsgTypeMutex;
+    /* accept.stats: per-acceptor totals at the previous query => rates over the interval since */
+    std::mutex _acceptStatsMutex;
+    std::vector<uint64_t> _acceptedAtLastAcceptStats;
+    double _uptimeAtLastAcceptStats{0.0};
+
+    /* Live table read lock-free on every message */
+    std::atomic<const DispatchTable *> _dispatchTable{nullptr};
+
+    /* Grace periods for replaced tables. A reader counts itself in the current phase of its slot
+     * (threads hashed over slots) while it holds the table. Tables retired before a phase flip are
+     * freed once every slot's count for the old phase has drained */
+    static constexpr std::size_t NumReaderSlots = 16;
+
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<uint64_t> readers[2]{};
+    };
+
+    std::array<ReaderSlot, NumReaderSlots> _readerSlots;
+    std::atomic<unsigned int> _readerPhase{0};
+
+    /* Writers only: table under construction, the live table and replaced tables awaiting their
+     * grace period (retired: since the last phase flip; draining: before it) */
+    std::recursive_mutex _dispatchTableMutex;
+    std::unique_ptr<DispatchTable> _pendingDispatchTable;
+    std::unique_ptr<const DispatchTable> _liveDispatchTable;
+    std::vector<std::unique_ptr<const DispatchTable>> _retiredDispatchTables;
+    std::vector<std::unique_ptr<const DispatchTable>> _drainingDispatchTables;
 };
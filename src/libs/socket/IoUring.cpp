@@ -0,0 +1,399 @@
+/**
+ * @file IoUring.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "IoUring.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+
+namespace
+{
+
+int ioUringSetup(unsigned entries, io_uring_params *params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+
+int ioUringRegister(int ringFD, unsigned opcode, const void *arg, unsigned nArgs)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, ringFD, opcode, arg, nArgs));
+}
+
+
+void *mapRing(int ringFD, std::size_t size, off_t offset)
+{
+    void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, offset);
+    if (p == MAP_FAILED)
+    {
+        throw std::runtime_error("Failed to map io_uring ring: " + std::string(std::strerror(errno)));
+    }
+
+    return p;
+}
+
+
+template <typename T>
+T *offsetPtr(void *base, unsigned offset)
+{
+    return reinterpret_cast<T *>(static_cast<char *>(base) + offset);
+}
+
+} // namespace
+
+
+IoUring::IoUring(unsigned entries)
+{
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    if ((_ringFD = ioUringSetup(entries, &params)) < 0)
+    {
+        throw std::runtime_error("io_uring_setup failed: " + std::string(std::strerror(errno)));
+    }
+
+    _sqEntries = params.sq_entries;
+    _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP);
+    if (singleMap)
+    {
+        _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+    }
+
+    try
+    {
+        _sqRing = mapRing(_ringFD, _sqRingSize, IORING_OFF_SQ_RING);
+        _cqRing = (singleMap ? _sqRing : mapRing(_ringFD, _cqRingSize, IORING_OFF_CQ_RING));
+
+        _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        _sqes = static_cast<io_uring_sqe *>(mapRing(_ringFD, _sqesSize, IORING_OFF_SQES));
+    }
+    catch (...)
+    {
+        release();
+        throw;
+    }
+
+    _sqHead = offsetPtr<unsigned>(_sqRing, params.sq_off.head);
+    _sqTail = offsetPtr<unsigned>(_sqRing, params.sq_off.tail);
+    _sqMask = offsetPtr<unsigned>(_sqRing, params.sq_off.ring_mask);
+    _sqArray = offsetPtr<unsigned>(_sqRing, params.sq_off.array);
+
+    _cqHead = offsetPtr<unsigned>(_cqRing, params.cq_off.head);
+    _cqTail = offsetPtr<unsigned>(_cqRing, params.cq_off.tail);
+    _cqMask = offsetPtr<unsigned>(_cqRing, params.cq_off.ring_mask);
+    _cqes = offsetPtr<io_uring_cqe>(_cqRing, params.cq_off.cqes);
+
+    /* Identity mapping: SQ array slot i => SQE i */
+    for (unsigned i = 0; i < _sqEntries; ++i)
+    {
+        _sqArray[i] = i;
+    }
+}
+
+
+IoUring::~IoUring()
+{
+    release();
+}
+
+
+void IoUring::release()
+{
+    if (_buffers)
+        munmap(_buffers, static_cast<std::size_t>(_nBuffers) * _bufferSize);
+    if (_bufferRing)
+        munmap(_bufferRing, _bufferRingSize);
+    if (_sqes)
+        munmap(_sqes, _sqesSize);
+    if (_cqRing && _cqRing != _sqRing)
+        munmap(_cqRing, _cqRingSize);
+    if (_sqRing)
+        munmap(_sqRing, _sqRingSize);
+    if (_ringFD != (-1))
+        close(_ringFD);
+
+    _buffers = nullptr;
+    _bufferRing = nullptr;
+    _sqes = nullptr;
+    _cqRing = _sqRing = nullptr;
+    _ringFD = (-1);
+}
+
+
+bool IoUring::isSupported()
+{
+    try
+    {
+        IoUring ring(4);
+
+        /* Opcodes */
+        constexpr unsigned nOps = 256;
+        std::vector<char> probeBuffer(sizeof(io_uring_probe) + nOps * sizeof(io_uring_probe_op), 0);
+        auto *probe = reinterpret_cast<io_uring_probe *>(probeBuffer.data());
+
+        if (ioUringRegister(ring._ringFD, IORING_REGISTER_PROBE, probe, nOps) < 0)
+        {
+            return false;
+        }
+
+        auto supported = [probe](unsigned op)
+        {
+            return (op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED));
+        };
+
+        /* SEND_ZC arrived with multishot recv (6.0) => use as a proxy for it */
+        if (!supported(IORING_OP_RECV) || !supported(IORING_OP_SENDMSG) || !supported(IORING_OP_POLL_ADD) || !supported(IORING_OP_SEND_ZC))
+        {
+            return false;
+        }
+
+        if (!supported(IORING_OP_PROVIDE_BUFFERS))
+        {
+            return false;
+        }
+
+        ring.registerFiles(4);
+        return true;
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+}
+
+
+io_uring_sqe *IoUring::getSqe()
+{
+    unsigned head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+    unsigned tail = *_sqTail;
+
+    if (tail - head == _sqEntries) /* Full => make room */
+    {
+        if (enter(_sqPending, 0, 0) < 0)
+        {
+            return nullptr;
+        }
+
+        _sqPending = 0;
+        head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+
+        if (tail - head == _sqEntries)
+        {
+            return nullptr;
+        }
+    }
+
+    io_uring_sqe *sqe = &_sqes[tail & *_sqMask];
+    std::memset(sqe, 0, sizeof(*sqe));
+
+    __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++_sqPending;
+
+    return sqe;
+}
+
+
+int IoUring::submitAndWait(unsigned minComplete)
+{
+    int result = enter(_sqPending, minComplete, IORING_ENTER_GETEVENTS); /* Also runs deferred completion work */
+
+    if (result >= 0)
+    {
+        _sqPending = 0;
+    }
+
+    return result;
+}
+
+
+int IoUring::enter(unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    int result = static_cast<int>(syscall(__NR_io_uring_enter, _ringFD, toSubmit, minComplete, flags, nullptr, 0));
+    return (result < 0 ? -errno : result);
+}
+
+
+void IoUring::registerFiles(unsigned nFiles)
+{
+    std::vector<int> fds(nFiles, -1); /* Sparse */
+
+    if (ioUringRegister(_ringFD, IORING_REGISTER_FILES, fds.data(), nFiles) < 0)
+    {
+        throw std::runtime_error("Failed to register io_uring files: " + std::string(std::strerror(errno)));
+    }
+}
+
+
+void IoUring::updateFile(unsigned slot, int fd)
+{
+    io_uring_files_update update;
+    std::memset(&update, 0, sizeof(update));
+
+    update.offset = slot;
+    update.fds = reinterpret_cast<uint64_t>(&fd);
+
+    if (ioUringRegister(_ringFD, IORING_REGISTER_FILES_UPDATE, &update, 1) < 0)
+    {
+        throw std::runtime_error("Failed to update io_uring file slot: " + std::string(std::strerror(errno)));
+    }
+}
+
+
+void IoUring::registerBufferRing(uint16_t groupID, unsigned nBuffers, unsigned bufferSize)
+{
+    if (nBuffers == 0 || (nBuffers & (nBuffers - 1)) != 0 || nBuffers > 32768)
+    {
+        throw std::invalid_argument("io_uring buffer count must be a power of 2");
+    }
+
+    static const bool useRing = bufferRingsWork();
+    registerBufferRing(groupID, nBuffers, bufferSize, useRing);
+}
+
+
+void IoUring::registerBufferRing(uint16_t groupID, unsigned nBuffers, unsigned bufferSize, bool useRing)
+{
+    _bufferRingSize = nBuffers * sizeof(io_uring_buf);
+    void *ring = (useRing ? mmap(nullptr, _bufferRingSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0) : nullptr);
+    void *buffers = mmap(nullptr, static_cast<std::size_t>(nBuffers) * bufferSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+
+    if (ring == MAP_FAILED || buffers == MAP_FAILED)
+    {
+        if (ring && ring != MAP_FAILED)
+            munmap(ring, _bufferRingSize);
+        if (buffers != MAP_FAILED)
+            munmap(buffers, static_cast<std::size_t>(nBuffers) * bufferSize);
+
+        throw std::runtime_error("Failed to allocate io_uring provided buffers");
+    }
+
+    _bufferRing = static_cast<io_uring_buf_ring *>(ring);
+    _buffers = static_cast<char *>(buffers);
+    _nBuffers = nBuffers;
+    _bufferSize = bufferSize;
+    _bufferTail = 0;
+    _bufferGroup = groupID;
+    _legacyBuffers = !useRing;
+
+    if (_legacyBuffers)
+    {
+        provideBuffers(0, nBuffers);
+        return;
+    }
+
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+
+    reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+    reg.ring_entries = nBuffers;
+    reg.bgid = groupID;
+
+    if (ioUringRegister(_ringFD, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+    {
+        throw std::runtime_error("Failed to register io_uring buffer ring: " + std::string(std::strerror(errno)));
+    }
+
+    for (unsigned i = 0; i < nBuffers; ++i)
+    {
+        recycleBuffer(static_cast<uint16_t>(i));
+    }
+}
+
+
+bool IoUring::bufferRingsWork()
+{
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == (-1))
+    {
+        return false;
+    }
+
+    bool works = false;
+
+    try
+    {
+        IoUring ring(4);
+        ring.registerBufferRing(0, 4, 64, true);
+
+        if (write(sockets[1], "x", 1) == 1)
+        {
+            io_uring_sqe *sqe = ring.getSqe();
+            sqe->opcode = IORING_OP_RECV;
+            sqe->fd = sockets[0];
+            sqe->flags = IOSQE_BUFFER_SELECT;
+            sqe->buf_group = 0;
+            sqe->user_data = 1;
+
+            if (ring.submitAndWait(1) >= 0)
+            {
+                ring.forEachCqe([&works](const io_uring_cqe &cqe)
+                {
+                    works = (cqe.res == 1 && (cqe.flags & IORING_CQE_F_BUFFER));
+                });
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        works = false;
+    }
+
+    close(sockets[0]);
+    close(sockets[1]);
+    return works;
+}
+
+
+void IoUring::provideBuffers(uint16_t bufferID, unsigned nBuffers)
+{
+    io_uring_sqe *sqe = getSqe();
+    if (!sqe)
+    {
+        throw std::runtime_error("io_uring submission queue full");
+    }
+
+    sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd = static_cast<int>(nBuffers);
+    sqe->addr = reinterpret_cast<uint64_t>(buffer(bufferID));
+    sqe->len = _bufferSize;
+    sqe->off = bufferID;
+    sqe->buf_group = _bufferGroup;
+    sqe->user_data = InternalUserData;
+}
+
+
+void IoUring::recycleBuffer(uint16_t bufferID)
+{
+    if (_legacyBuffers)
+    {
+        provideBuffers(bufferID, 1); /* Submitted with the next batch */
+        return;
+    }
+
+    io_uring_buf &entry = _bufferRing->bufs[_bufferTail & (_nBuffers - 1)];
+
+    entry.addr = reinterpret_cast<uint64_t>(buffer(bufferID));
+    entry.len = _bufferSize;
+    entry.bid = bufferID;
+
+    ++_bufferTail;
+    __atomic_store_n(&_bufferRing->tail, static_cast<uint16_t>(_bufferTail), __ATOMIC_RELEASE);
+}
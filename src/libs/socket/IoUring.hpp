@@ -0,0 +1,121 @@
+/**
+ * @file IoUring.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <linux/io_uring.h>
+
+
+/**
+ * Minimal io_uring wrapper over the raw syscalls (no liburing dependency).
+ *
+ * Not thread-safe: a ring is owned by a single event-loop thread. Throws std::runtime_error if the
+ * kernel does not support a feature.
+ */
+class IoUring
+{
+public:
+    explicit IoUring(unsigned entries);
+    ~IoUring();
+
+    IoUring(const IoUring &) = delete;
+    IoUring &operator=(const IoUring &) = delete;
+
+    /* True if the kernel supports everything we use (multishot recv, provided buffers, sendmsg) */
+    [[nodiscard]] static bool isSupported();
+
+    /* Completions for internal requests (e.g. re-providing legacy buffers) are never passed to callers */
+    static constexpr uint64_t InternalUserData = ~uint64_t(0);
+
+    /* Next free submission entry (zeroed). Submits pending entries if the queue is full */
+    io_uring_sqe *getSqe();
+
+    /* Submit pending entries and wait for at least minComplete completions (0 => reap without blocking) */
+    int submitAndWait(unsigned minComplete);
+
+    /* Calls fn(const io_uring_cqe &) for each available completion then marks them consumed */
+    template <typename Fn>
+    unsigned forEachCqe(Fn &&fn)
+    {
+        unsigned head = *_cqHead;
+        unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+        unsigned count = 0;
+
+        for (; head != tail; ++head, ++count)
+        {
+            const io_uring_cqe &cqe = _cqes[head & *_cqMask];
+            if (cqe.user_data != InternalUserData)
+                fn(cqe);
+        }
+
+        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+    /* Registered (fixed) files: sparse table of nFiles slots */
+    void registerFiles(unsigned nFiles);
+    void updateFile(unsigned slot, int fd);
+
+    /* Provided buffers: nBuffers (power of 2) buffers of bufferSize bytes in group groupID. Uses a
+     * mapped buffer ring where it works, otherwise falls back to IORING_OP_PROVIDE_BUFFERS */
+    void registerBufferRing(uint16_t groupID, unsigned nBuffers, unsigned bufferSize);
+
+    /* Start of provided buffer */
+    [[nodiscard]] inline char *buffer(uint16_t bufferID) const { return _buffers + static_cast<std::size_t>(bufferID) * _bufferSize; }
+
+    /* Return provided buffer to the kernel */
+    void recycleBuffer(uint16_t bufferID);
+
+private:
+    /* Unmap rings/buffers and close the ring */
+    void release();
+
+    int enter(unsigned toSubmit, unsigned minComplete, unsigned flags);
+
+    /* Some kernels accept a buffer ring but never select from it => check with a real recv() */
+    [[nodiscard]] static bool bufferRingsWork();
+
+    void registerBufferRing(uint16_t groupID, unsigned nBuffers, unsigned bufferSize, bool useRing);
+
+    /* Queue IORING_OP_PROVIDE_BUFFERS for nBuffers consecutive buffers from bufferID */
+    void provideBuffers(uint16_t bufferID, unsigned nBuffers);
+
+    int _ringFD{-1};
+
+    /* Submission queue */
+    void *_sqRing{nullptr};
+    std::size_t _sqRingSize{0};
+    unsigned *_sqHead{nullptr};
+    unsigned *_sqTail{nullptr};
+    unsigned *_sqMask{nullptr};
+    unsigned *_sqArray{nullptr};
+    io_uring_sqe *_sqes{nullptr};
+    std::size_t _sqesSize{0};
+    unsigned _sqEntries{0};
+    unsigned _sqPending{0}; /* Entries written but not yet submitted */
+
+    /* Completion queue */
+    void *_cqRing{nullptr};
+    std::size_t _cqRingSize{0};
+    unsigned *_cqHead{nullptr};
+    unsigned *_cqTail{nullptr};
+    unsigned *_cqMask{nullptr};
+    io_uring_cqe *_cqes{nullptr};
+
+    /* Provided buffers */
+    io_uring_buf_ring *_bufferRing{nullptr};
+    std::size_t _bufferRingSize{0};
+    char *_buffers{nullptr};
+    unsigned _nBuffers{0};
+    unsigned _bufferSize{0};
+    unsigned _bufferTail{0};
+    uint16_t _bufferGroup{0};
+    bool _legacyBuffers{false}; /* No buffer ring: buffers re-provided via SQEs */
+};
@@ -0,0 +1,99 @@
+/**
+ * @file MsgTypeDispatchTable.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "fix/FixDictionary.hpp"
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+
+/**
+ * MsgType --> handler table indexed by a dense encoding of the (up to) 2-character MsgType.
+ *
+ * Each character in [0-9A-Za-z] maps to 1..62 so the index table is 64 x 64 one-byte slots (4KB).
+ * Built once and then treated as immutable so lookups need no locks.
+ */
+template <typename Handler>
+class MsgTypeDispatchTable
+{
+public:
+    /* Add or replace handler. Throws if msgType cannot be encoded */
+    void add(FixMsgType msgType, Handler handler)
+    {
+        std::size_t i = index(msgType);
+        if (i == 0)
+        {
+            throw std::invalid_argument("invalid MsgType");
+        }
+
+        if (_slotForIndex[i] != 0)
+        {
+            _handlers[_slotForIndex[i] - 1] = std::move(handler);
+            return;
+        }
+
+        if (_handlers.size() == 255)
+        {
+            throw std::length_error("too many MsgType handlers");
+        }
+
+        _handlers.push_back(std::move(handler));
+        _msgTypes.push_back(msgType);
+        _slotForIndex[i] = static_cast<uint8_t>(_handlers.size());
+    }
+
+    /* Returns nullptr if no handler registered */
+    [[nodiscard]] const Handler *find(FixMsgType msgType) const
+    {
+        uint8_t slot = _slotForIndex[index(msgType)];
+        return (slot != 0 ? &_handlers[slot - 1] : nullptr);
+    }
+
+    /* Registered MsgTypes in registration order */
+    [[nodiscard]] const std::vector<FixMsgType> &msgTypes() const { return _msgTypes; }
+
+private:
+    /* 0 => not a valid MsgType character */
+    static constexpr std::size_t charIndex(unsigned int c)
+    {
+        if (c >= '0' && c <= '9')
+            return (c - '0') + 1;
+        else if (c >= 'A' && c <= 'Z')
+            return (c - 'A') + 11;
+        else if (c >= 'a' && c <= 'z')
+            return (c - 'a') + 37;
+
+        return 0;
+    }
+
+    /* 0 => invalid (slot 0 is never populated) */
+    static constexpr std::size_t index(FixMsgType msgType)
+    {
+        auto code = static_cast<uint16_t>(msgType);
+
+        unsigned int first = (code > 0xFF ? (code >> 8) : code);
+        unsigned int second = (code > 0xFF ? (code & 0xFF) : 0);
+
+        std::size_t iFirst = charIndex(first);
+        std::size_t iSecond = charIndex(second);
+
+        if (iFirst == 0 || (second != 0 && iSecond == 0))
+        {
+            return 0;
+        }
+
+        return (iFirst * 64) + iSecond;
+    }
+
+    std::array<uint8_t, 64 * 64> _slotForIndex{}; /* 1-based index into _handlers (0 => none) */
+    std::vector<Handler> _handlers;
+    std::vector<FixMsgType> _msgTypes;
+};
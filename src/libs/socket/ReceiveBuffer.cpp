@@ -0,0 +1,65 @@
+/**
+ * @file ReceiveBuffer.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ReceiveBuffer.hpp"
+#include <cstring>
+
+
+ReceiveBuffer::ReceiveBuffer(std::size_t initialCapacity)
+    : _buffer(new char[initialCapacity]), _capacity(initialCapacity)
+{
+}
+
+
+void ReceiveBuffer::reserve(std::size_t n)
+{
+    if (writable() >= n)
+    {
+        return;
+    }
+
+    std::size_t nReadable = _end - _begin;
+
+    /* Compact: move unconsumed bytes to the front */
+    if (_begin > 0)
+    {
+        std::memmove(_buffer.get(), _buffer.get() + _begin, nReadable);
+        _begin = 0;
+        _end = nReadable;
+    }
+
+    if (writable() >= n)
+    {
+        return;
+    }
+
+    /* Grow */
+    std::size_t newCapacity = _capacity;
+    while (newCapacity - nReadable < n)
+    {
+        newCapacity *= 2;
+    }
+
+    std::unique_ptr<char[]> newBuffer(new char[newCapacity]);
+    std::memcpy(newBuffer.get(), _buffer.get(), nReadable);
+
+    _buffer = std::move(newBuffer);
+    _capacity = newCapacity;
+}
+
+
+void ReceiveBuffer::consume(std::size_t n)
+{
+    _begin += n;
+
+    if (_begin == _end) /* Empty => reset to front for free */
+    {
+        _begin = _end = 0;
+    }
+}
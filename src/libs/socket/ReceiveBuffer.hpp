@@ -0,0 +1,53 @@
+/**
+ * @file ReceiveBuffer.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+
+/**
+ * Growable per-session receive buffer.
+ *
+ * Bytes are written at the back (recv) and consumed from the front (frame decoder). Unconsumed
+ * bytes are moved to the front before growing so a partial frame is never lost.
+ */
+class ReceiveBuffer
+{
+public:
+    explicit ReceiveBuffer(std::size_t initialCapacity = 4096);
+
+    ReceiveBuffer(const ReceiveBuffer &) = delete;
+    ReceiveBuffer &operator=(const ReceiveBuffer &) = delete;
+
+    /* Ensure at least n writable bytes (compacts, then grows if required) */
+    void reserve(std::size_t n);
+
+    /* Write position and number of writable bytes */
+    [[nodiscard]] inline char *writePtr() { return _buffer.get() + _end; }
+    [[nodiscard]] inline std::size_t writable() const { return _capacity - _end; }
+
+    /* Mark n bytes as written */
+    inline void commit(std::size_t n) { _end += n; }
+
+    /* Unconsumed bytes */
+    [[nodiscard]] inline std::string_view readable() const { return std::string_view(_buffer.get() + _begin, _end - _begin); }
+
+    /* Mark n bytes as consumed */
+    void consume(std::size_t n);
+
+    [[nodiscard]] inline std::size_t capacity() const { return _capacity; }
+
+private:
+    std::unique_ptr<char[]> _buffer;
+    std::size_t _capacity;
+    std::size_t _begin{0};
+    std::size_t _end{0};
+};
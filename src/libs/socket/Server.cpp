@@ -9,112 +9,328 @@
 
 #include "Server.hpp"
 #include "logger/Logger.hpp"
+#include <algorithm>
 #include <arpa/inet.h>
+#include <cerrno>
 #include <cstring>
+#include <fcntl.h>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <poll.h>
 #include <signal.h>
+#include <sstream>
 #include <stdexcept>
 #include <thread>
 #include <unistd.h>
+#include <utility>
 
 
-Server::Server(Port port) : _port(port)
+Server::Server(SocketAddress address) : _address(std::move(address))
 {
 }
 
 
 void Server::onStartup()
 {
-    Logger::instance().info("Starting up server on port: " + std::to_string(port()));
+    Logger::instance().info("Starting up server on: " + _address.toString());
 
+    std::size_t nAcceptors = _nAcceptorThreads;
+
+    if (_address.isUnix())
+    {
+        unlink(_address.path.c_str()); /* Stale socket file from a previous run (avoid address already in use) */
+
+        if (nAcceptors > 1)
+        {
+            Logger::instance().error("SO_REUSEPORT is TCP only => Accepting on one thread.");
+            nAcceptors = 1;
+        }
+    }
+
+    _acceptors.clear();
+    for (std::size_t i = 0; i < nAcceptors; ++i)
+    {
+        auto acceptor = std::make_unique<Acceptor>();
+        acceptor->index = i;
+        acceptor->listeningSocket = openListeningSocket(nAcceptors > 1);
+        _acceptors.push_back(std::move(acceptor));
+    }
+
+    _startTime = std::chrono::steady_clock::now();
+
+    /* Start listening and accepting connections */
+    for (auto &acceptor : _acceptors)
+    {
+        acceptor->thread = std::thread(&Server::listenLoop, this, std::ref(*acceptor));
+    }
+}
+
+
+Server::SocketFD Server::openListeningSocket(bool reusePort)
+{
     /* Create server socket */
-    if ((_listeningSocket = socket(AF_INET, SOCK_STREAM, 0)) == (-1))
+    SocketFD listeningSocket = _address.openSocket();
+    if (listeningSocket == (-1))
     {
         throw std::runtime_error("Failed to create server socket");
     }
 
-    /* Enable reuse of a socket (avoid address already in use) */
-    int state{1};
-    if (setsockopt(_listeningSocket, SOL_SOCKET, SO_REUSEADDR, &state, sizeof(state)) == (-1))
+    auto fail = [this, listeningSocket](const std::string &what)
     {
-        throw std::runtime_error("Failed to set option SO_REUSEADDR");
+        closeSocket(listeningSocket);
+        throw std::runtime_error(what);
+    };
+
+    if (!_address.isUnix())
+    {
+        /* Enable reuse of a socket (avoid address already in use) */
+        int state{1};
+        if (setsockopt(listeningSocket, SOL_SOCKET, SO_REUSEADDR, &state, sizeof(state)) == (-1))
+        {
+            fail("Failed to set option SO_REUSEADDR");
+        }
+
+        /* Each acceptor binds the same port; the kernel hashes new connections between them */
+        if (reusePort && setsockopt(listeningSocket, SOL_SOCKET, SO_REUSEPORT, &state, sizeof(state)) == (-1))
+        {
+            fail("Failed to set option SO_REUSEPORT");
+        }
     }
 
-    /* Setup server address */
-    sockaddr_in serverAddress;
+    /* Accepted sockets inherit buffer sizes from the listening socket; the rest is re-applied on accept */
+    socketOptions().apply(listeningSocket);
 
-    serverAddress.sin_family = AF_INET;         /* IPV4 */
-    serverAddress.sin_port = htons(_port);      /* Port */
-    serverAddress.sin_addr.s_addr = INADDR_ANY; /* Accept all incoming messages */
+    /* Setup server address */
+    sockaddr_storage serverAddress;
+    socklen_t serverAddressLength = _address.toSockaddr(serverAddress, false); /* Accept all incoming messages */
 
     /* Bind server socket */
-    if ((bind(_listeningSocket, (const struct sockaddr *)&serverAddress, sizeof(serverAddress))) == (-1))
+    if ((bind(listeningSocket, (const struct sockaddr *)&serverAddress, serverAddressLength)) == (-1))
     {
-        throw std::runtime_error("Failed to bind server socket to address");
+        fail("Failed to bind server socket to address");
     }
 
     /* Start listening */
-    if (listen(_listeningSocket, SOMAXCONN) == (-1))
+    if (listen(listeningSocket, SOMAXCONN) == (-1))
     {
-        throw std::runtime_error("Failed to listen on socket");
+        fail("Failed to listen on socket");
     }
 
-    /* Start listening and accepting connections */
-    _listenLoopThread = std::thread(&Server::listenLoop, this);
+    /* Non-blocking: each wake-up accepts until EAGAIN */
+    int flags = fcntl(listeningSocket, F_GETFL, 0);
+    if (flags == (-1) || fcntl(listeningSocket, F_SETFL, flags | O_NONBLOCK) == (-1))
+    {
+        fail("Failed to make server socket non-blocking");
+    }
+
+    return listeningSocket;
 }
 
 
 void Server::onWait()
 {
-    if (_listenLoopThread.joinable())
-        _listenLoopThread.join();
+    for (auto &acceptor : _acceptors)
+    {
+        if (acceptor->thread.joinable())
+            acceptor->thread.join();
+    }
+}
+
+
+void Server::setAcceptorThreads(std::size_t nThreads)
+{
+    if (_active)
+    {
+        Logger::instance().error("Acceptor threads must be set before start() => Ignoring.");
+        return;
+    }
+
+    _nAcceptorThreads = std::max<std::size_t>(nThreads, 1);
+}
+
+
+std::vector<Server::SocketFD> Server::listenSockets() const
+{
+    std::vector<SocketFD> result;
+    for (const auto &acceptor : _acceptors)
+    {
+        result.push_back(acceptor->listeningSocket);
+    }
+
+    return result;
 }
 
 
-void Server::listenLoop()
+std::vector<Server::AcceptorStats> Server::acceptorStats() const
 {
-    Logger::instance().info("Starting listening loop (socket: " + std::to_string(_listeningSocket) + ")");
+    std::vector<AcceptorStats> result;
+
+    for (const auto &acceptor : _acceptors)
+    {
+        AcceptorStats stats;
+        stats.accepted = acceptor->accepted.load(std::memory_order_relaxed);
+        stats.wakeups = acceptor->wakeups.load(std::memory_order_relaxed);
+        stats.peakBatch = acceptor->peakBatch.load(std::memory_order_relaxed);
+        stats.errors = acceptor->errors.load(std::memory_order_relaxed);
+
+        /* Listening TCP socket: unacked = connections waiting to be accepted, sacked = backlog */
+        struct tcp_info info{};
+        socklen_t length = sizeof(info);
+
+        if (!_address.isUnix() && getsockopt(acceptor->listeningSocket, IPPROTO_TCP, TCP_INFO, &info, &length) == 0)
+        {
+            stats.queued = info.tcpi_unacked;
+            stats.backlog = info.tcpi_sacked;
+        }
+
+        result.push_back(stats);
+    }
+
+    return result;
+}
+
+
+double Server::uptimeSeconds() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - _startTime).count();
+}
+
+
+std::pair<uint64_t, uint64_t> Server::listenDrops()
+{
+    /* Two "TcpExt:" lines: field names then values */
+    std::ifstream netstat("/proc/net/netstat");
+    std::string names, values;
+
+    while (std::getline(netstat, names) && names.rfind("TcpExt:", 0) != 0)
+    {
+    }
+
+    if (!std::getline(netstat, values))
+    {
+        return {0, 0};
+    }
+
+    std::istringstream namesIS(names), valuesIS(values);
+    std::string name, value;
+    std::pair<uint64_t, uint64_t> result{0, 0};
+
+    while (namesIS >> name && valuesIS >> value)
+    {
+        if (name == "ListenOverflows")
+            result.first = std::stoull(value);
+        else if (name == "ListenDrops")
+            result.second = std::stoull(value);
+    }
+
+    return result;
+}
+
+
+void Server::listenLoop(Acceptor &acceptor)
+{
+    Logger::instance().info("Starting listening loop (socket: " + std::to_string(acceptor.listeningSocket) + ")");
+
+    /* Reactor mode sets sessions non-blocking anyway; thread-per-connection sends block */
+    const int acceptFlags = SOCK_CLOEXEC | (reactorMode() ? SOCK_NONBLOCK : 0);
 
     /* Reference: https://man7.org/linux/man-pages/man2/poll.2.html */
-    struct pollfd fds;
+    struct pollfd fds[2];
 
-    fds.fd = _listeningSocket;
-    fds.events = POLLIN; /* POLLIN: data to read */
+    fds[0].fd = acceptor.listeningSocket;
+    fds[0].events = POLLIN; /* POLLIN: data to read */
+    fds[1].fd = shutdownFD();
+    fds[1].events = POLLIN; /* Readable once stop() is called */
 
     while (_active) /* Run for server lifetime */
     {
-        int pollResult = poll(&fds, 1, 1000); /* 1000ms between polls */
+        int pollResult = poll(fds, 2, -1); /* No timeout: stop() wakes us */
 
-        if (pollResult == 0)
+        if (pollResult == (-1))
         {
-            /* System call timed out with no new connections */
+            if (errno != EINTR)
+                Logger::instance().error("A polling error occurred (socket: " + std::to_string(acceptor.listeningSocket) + ")");
+            continue;
         }
-        else if (pollResult == (-1))
+
+        if (!(fds[0].revents & POLLIN)) /* No new incoming connection */
         {
-            Logger::instance().error("A polling error occurred (socket: " + std::to_string(_listeningSocket) + ")");
+            continue;
         }
-        else
+
+        uint64_t nAccepted = 0;
+        bool outOfFDs = false;
+
+        while (_active) /* Drain the accept queue */
         {
-            if (fds.revents & POLLIN) /* New incoming connection */
+            int clientSocket = accept4(acceptor.listeningSocket, nullptr, nullptr, acceptFlags);
+
+            if (clientSocket == (-1))
             {
-                int clientSocket = accept(_listeningSocket, nullptr, nullptr);
-                if (clientSocket == (-1))
+                if (errno == EINTR || errno == ECONNABORTED) /* Client gave up while queued => next */
+                    continue;
+
+                if (errno != EAGAIN && errno != EWOULDBLOCK)
                 {
-                    Logger::instance().error("Failed to accept connection from client");
+                    acceptor.errors.fetch_add(1, std::memory_order_relaxed);
+                    Logger::instance().error("Failed to accept connection from client: " + std::string(std::strerror(errno)));
+
+                    outOfFDs = (errno == EMFILE || errno == ENFILE);
                 }
 
-                /* Create and detach a new thread to handle messages from the client */
-                Logger::instance().info("Accepted new connection (socket: " + std::to_string(clientSocket) + ")");
-                addClientSession(clientSocket);
+                break;
             }
+
+            ++nAccepted;
+            acceptSession(clientSocket);
+        }
+
+        acceptor.accepted.fetch_add(nAccepted, std::memory_order_relaxed);
+        acceptor.wakeups.fetch_add(1, std::memory_order_relaxed);
+
+        if (nAccepted > acceptor.peakBatch.load(std::memory_order_relaxed)) /* Only written by this thread */
+            acceptor.peakBatch.store(nAccepted, std::memory_order_relaxed);
+
+        /* The connection stays queued so the listener polls readable at once => wait for descriptors
+         * to be freed rather than spin. stop() still wakes us */
+        if (outOfFDs)
+        {
+            poll(&fds[1], 1, AcceptBackoffMS);
         }
     }
 
     /* Cleanup */
-    closeSocket(_listeningSocket);
-    Logger::instance().info("Shutting-down listening loop (socket: " + std::to_string(_listeningSocket) + ")");
+    closeSocket(acceptor.listeningSocket);
+    if (_address.isUnix())
+        unlink(_address.path.c_str());
+    Logger::instance().info("Shutting-down listening loop (socket: " + std::to_string(acceptor.listeningSocket) + ")");
+}
+
+
+void Server::acceptSession(SocketFD clientSocket)
+{
+    Logger::instance().info("Accepted new connection (socket: " + std::to_string(clientSocket) + ")");
+    socketOptions().apply(clientSocket);
+
+    std::unique_ptr<ShmChannel> channel;
+
+    if (_address.isSharedMemory())
+    {
+        try
+        {
+            channel = ShmChannel::offer(clientSocket);
+        }
+        catch (const std::exception &e)
+        {
+            Logger::instance().error("Failed to offer shared-memory channel (socket: " + std::to_string(clientSocket) + "): " + e.what());
+            closeSocket(clientSocket);
+            return;
+        }
+    }
+
+    addClientSession(clientSocket, std::move(channel));
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #pragma once
 #include "ConnectionManager.hpp"
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -20,29 +21,84 @@
 #include <sys/socket.h>
 #include <thread>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 
 class Server : public ConnectionManager
 {
 public:
-    explicit Server(Port port);
+    /* TCP port or AF_UNIX path ("unix:/path", "unixpacket:/path") */
+    explicit Server(SocketAddress address);
 
-    /* Accessor for server's port */
-    [[nodiscard]] inline Port port() const { return _port; }
+    /* Accessor for server's port. 0 for AF_UNIX */
+    [[nodiscard]] inline Port port() const { return _address.isUnix() ? 0 : _address.port; }
 
-    /* Accessor for server's listening socket */
-    [[nodiscard]] inline SocketFD listenSocket() const { return _listeningSocket; }
+    /* Accessor for server's address */
+    [[nodiscard]] inline const SocketAddress &address() const { return _address; }
+
+    /* Accessor for server's (first) listening socket. (-1) before start() */
+    [[nodiscard]] inline SocketFD listenSocket() const { return _acceptors.empty() ? (-1) : _acceptors.front()->listeningSocket; }
+
+    /* Listening socket of each acceptor */
+    [[nodiscard]] std::vector<SocketFD> listenSockets() const;
+
+    /* Accept on nThreads threads, each with its own SO_REUSEPORT listening socket so the kernel spreads
+     * incoming connections between them (default 1). TCP only. Call before start() */
+    void setAcceptorThreads(std::size_t nThreads);
+
+    /* Work done by each acceptor thread */
+    struct AcceptorStats
+    {
+        uint64_t accepted{0};
+        uint64_t wakeups{0};   /* Wake-ups with connections to accept */
+        uint64_t peakBatch{0}; /* Most connections accepted in one wake-up */
+        uint64_t errors{0};    /* accept4() failures */
+        uint32_t queued{0};    /* Connections waiting in the accept queue (TCP_INFO) */
+        uint32_t backlog{0};   /* Accept queue limit */
+    };
+
+    [[nodiscard]] std::vector<AcceptorStats> acceptorStats() const;
+
+    /* Seconds since the listening sockets were opened */
+    [[nodiscard]] double uptimeSeconds() const;
+
+    /* System-wide TCP connections dropped because an accept queue was full (ListenOverflows, ListenDrops
+     * from /proc/net/netstat). Zeros if unavailable */
+    [[nodiscard]] static std::pair<uint64_t, uint64_t> listenDrops();
 
 protected:
     void onStartup() override;
     void onWait() override;
 
 private:
-    /* Accept incoming connections and spawn new connection/sender loops */
-    void listenLoop();
+    struct Acceptor
+    {
+        SocketFD listeningSocket{-1};
+        std::size_t index{0};
+        std::thread thread;
+
+        std::atomic<uint64_t> accepted{0};
+        std::atomic<uint64_t> wakeups{0};
+        std::atomic<uint64_t> peakBatch{0};
+        std::atomic<uint64_t> errors{0};
+    };
+
+    /* Pause before retrying accept4() after EMFILE/ENFILE */
+    static constexpr int AcceptBackoffMS = 100;
+
+    /* Bound, listening, non-blocking socket. Throws std::runtime_error */
+    SocketFD openListeningSocket(bool reusePort);
+
+    /* Accept incoming connections until stop() */
+    void listenLoop(Acceptor &acceptor);
+
+    /* Tune a newly accepted socket and add its session */
+    void acceptSession(SocketFD clientSocket);
 
-    Port _port;                    /* Server's port */
-    SocketFD _listeningSocket{-1}; /* Server socket's file-descriptor (FD). (-1) on error */
+    SocketAddress _address; /* Server's port or unix path */
 
-    std::thread _listenLoopThread;
+    std::size_t _nAcceptorThreads{1};
+    std::vector<std::unique_ptr<Acceptor>> _acceptors;
+    std::chrono::steady_clock::time_point _startTime;
 };
@@ -0,0 +1,359 @@
+/**
+ * @file ShmChannel.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ShmChannel.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <stdexcept>
+#include <string>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+/* Control block at the start of each ring. Positions only increase; index = position % capacity */
+struct ShmChannel::RingHeader
+{
+    alignas(64) std::atomic<uint64_t> writePosition{0}; /* Producer's cache line */
+    alignas(64) std::atomic<uint64_t> readPosition{0};  /* Consumer's cache line */
+    alignas(64) std::atomic<uint32_t> readerParked{0};  /* 1 => reader may be asleep in poll() */
+    std::atomic<uint32_t> closed{0};                    /* Writer has closed the channel */
+};
+
+
+namespace
+{
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared-memory rings need lock-free atomics");
+
+constexpr int NumPassedFDs = 3; /* memfd, eventfd (accepting side's reader), eventfd (connecting side's reader) */
+
+/* Ring header padded to a page so data stays aligned */
+constexpr std::size_t HeaderSize = 4096;
+
+/* Spinning reader: iterations between checks of the socket for a peer that exited without close() */
+constexpr unsigned PeerCheckInterval = 1u << 14;
+
+/* Socket carries no data after setup => readable means EOF/hang-up */
+bool socketHungUp(int unixSocket)
+{
+    struct pollfd fd{unixSocket, POLLIN | POLLRDHUP, 0};
+    return (poll(&fd, 1, 0) > 0 && fd.revents != 0);
+}
+constexpr std::size_t RingSize = HeaderSize + ShmChannel::RingCapacity;
+} // namespace
+
+
+std::unique_ptr<ShmChannel> ShmChannel::offer(int unixSocket)
+{
+    static_assert(sizeof(RingHeader) <= HeaderSize);
+
+    int fds[NumPassedFDs] = {memfd_create("talos-shm", MFD_CLOEXEC), eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC), eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)};
+
+    auto closeAll = [&fds]()
+    {
+        for (int fd : fds)
+        {
+            if (fd != (-1))
+                ::close(fd);
+        }
+    };
+
+    if (fds[0] == (-1) || fds[1] == (-1) || fds[2] == (-1) || ftruncate(fds[0], 2 * RingSize) == (-1))
+    {
+        closeAll();
+        throw std::runtime_error("Failed to create shared-memory channel: " + std::string(std::strerror(errno)));
+    }
+
+    /* Pass all three descriptors in one message */
+    char payload = 'S';
+    struct iovec iov{&payload, sizeof(payload)};
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(fds))]{};
+
+    struct msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    std::unique_ptr<ShmChannel> channel(new ShmChannel());
+
+    try
+    {
+        channel->map(fds[0], true); /* Zero-filled by ftruncate() => headers start empty */
+    }
+    catch (...)
+    {
+        closeAll();
+        throw;
+    }
+
+    if (sendmsg(unixSocket, &msg, MSG_NOSIGNAL) != static_cast<long>(sizeof(payload)))
+    {
+        closeAll();
+        throw std::runtime_error("Failed to send shared-memory channel: " + std::string(std::strerror(errno)));
+    }
+
+    ::close(fds[0]); /* Mapping keeps the memory alive */
+    channel->_ownEventFD = fds[1];
+    channel->_peerEventFD = fds[2];
+    return channel;
+}
+
+
+std::unique_ptr<ShmChannel> ShmChannel::accept(int unixSocket)
+{
+    char payload = 0;
+    struct iovec iov{&payload, sizeof(payload)};
+
+    int fds[NumPassedFDs] = {-1, -1, -1};
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(fds))]{};
+
+    struct msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    long nBytes;
+    while ((nBytes = recvmsg(unixSocket, &msg, MSG_CMSG_CLOEXEC)) == (-1) && errno == EINTR)
+    {
+    }
+
+    struct cmsghdr *cmsg = (nBytes == sizeof(payload) ? CMSG_FIRSTHDR(&msg) : nullptr);
+
+    if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(sizeof(fds)))
+    {
+        throw std::runtime_error("Peer did not offer a shared-memory channel");
+    }
+
+    std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+
+    std::unique_ptr<ShmChannel> channel(new ShmChannel());
+    channel->_ownEventFD = fds[2];
+    channel->_peerEventFD = fds[1];
+
+    try
+    {
+        channel->map(fds[0], false);
+    }
+    catch (...)
+    {
+        ::close(fds[0]);
+        throw; /* Destructor closes the eventfds */
+    }
+
+    ::close(fds[0]);
+    return channel;
+}
+
+
+ShmChannel::~ShmChannel()
+{
+    if (_mapping)
+        munmap(_mapping, _mappingSize);
+    if (_ownEventFD != (-1))
+        ::close(_ownEventFD);
+    if (_peerEventFD != (-1))
+        ::close(_peerEventFD);
+}
+
+
+void ShmChannel::map(int memFD, bool accepting)
+{
+    _mappingSize = 2 * RingSize;
+    _mapping = mmap(nullptr, _mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, memFD, 0);
+
+    if (_mapping == MAP_FAILED)
+    {
+        _mapping = nullptr;
+        throw std::runtime_error("Failed to map shared-memory channel: " + std::string(std::strerror(errno)));
+    }
+
+    char *base = static_cast<char *>(_mapping);
+    Ring rings[2] = {{reinterpret_cast<RingHeader *>(base), base + HeaderSize},
+                     {reinterpret_cast<RingHeader *>(base + RingSize), base + RingSize + HeaderSize}};
+
+    _out = rings[accepting ? 0 : 1];
+    _in = rings[accepting ? 1 : 0];
+}
+
+
+bool ShmChannel::tryWrite(const char *data, std::size_t n)
+{
+    RingHeader &header = *_out.header;
+
+    uint64_t writePosition = header.writePosition.load(std::memory_order_relaxed);
+    uint64_t readPosition = header.readPosition.load(std::memory_order_acquire);
+
+    if (writePosition - readPosition > RingCapacity) /* Peer moved our positions */
+    {
+        distance(writePosition, readPosition);
+        return false;
+    }
+
+    if (RingCapacity - (writePosition - readPosition) < n)
+    {
+        return false;
+    }
+
+    std::size_t offset = writePosition % RingCapacity;
+    std::size_t first = std::min(n, RingCapacity - offset); /* Up to the end of the ring */
+
+    std::memcpy(_out.data + offset, data, first);
+    std::memcpy(_out.data, data + first, n - first);
+
+    header.writePosition.store(writePosition + n, std::memory_order_release);
+    return true;
+}
+
+
+void ShmChannel::notifyPeer()
+{
+    RingHeader &header = *_out.header;
+
+    std::atomic_thread_fence(std::memory_order_seq_cst); /* Publish before checking for a sleeper */
+
+    if (header.readerParked.load(std::memory_order_relaxed) && header.readerParked.exchange(0, std::memory_order_relaxed))
+    {
+        signal(_peerEventFD);
+    }
+}
+
+
+std::size_t ShmChannel::readable() const
+{
+    const RingHeader &header = *_in.header;
+    return distance(header.writePosition.load(std::memory_order_acquire), header.readPosition.load(std::memory_order_relaxed));
+}
+
+
+std::size_t ShmChannel::read(char *out, std::size_t n)
+{
+    RingHeader &header = *_in.header;
+
+    uint64_t readPosition = header.readPosition.load(std::memory_order_relaxed);
+    n = std::min(n, distance(header.writePosition.load(std::memory_order_acquire), readPosition));
+
+    std::size_t offset = readPosition % RingCapacity;
+    std::size_t first = std::min(n, RingCapacity - offset);
+
+    std::memcpy(out, _in.data + offset, first);
+    std::memcpy(out + first, _in.data, n - first);
+
+    header.readPosition.store(readPosition + n, std::memory_order_release);
+    return n;
+}
+
+
+bool ShmChannel::waitReadable(int unixSocket, Doorbell::WaitStrategy strategy)
+{
+    RingHeader &header = *_in.header;
+
+    for (unsigned i = 1; strategy != Doorbell::WaitStrategy::Block && (strategy == Doorbell::WaitStrategy::Spin || i <= Doorbell::SpinIterations); ++i)
+    {
+        if (readable() > 0 || peerClosed())
+            return !peerClosed() || readable() > 0;
+
+        if (_wakeRequested.load(std::memory_order_relaxed)) /* close()/wakeReader(): caller rechecks its state */
+        {
+            _wakeRequested.store(false, std::memory_order_relaxed);
+            return true;
+        }
+
+        if (i % PeerCheckInterval == 0 && socketHungUp(unixSocket)) /* Peer crashed without close() */
+            return readable() > 0;
+
+        Doorbell::cpuRelax();
+    }
+
+    _wakeRequested.store(false, std::memory_order_relaxed); /* Eventfd below carries any wake-up */
+
+    header.readerParked.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst); /* Pairs with fence in notifyPeer() */
+
+    bool peerGone = false;
+
+    if (readable() == 0 && !peerClosed())
+    {
+        struct pollfd fds[2] = {{_ownEventFD, POLLIN, 0}, {unixSocket, POLLIN | POLLRDHUP, 0}};
+
+        if (poll(fds, 2, -1) > 0) /* close()/wakeReader() or peer signal/hang-up */
+        {
+            uint64_t count;
+            while (::read(_ownEventFD, &count, sizeof(count)) > 0) /* Drain */
+            {
+            }
+
+            peerGone = (fds[1].revents != 0); /* Socket carries no data after setup => EOF/hang-up */
+        }
+    }
+
+    header.readerParked.store(0, std::memory_order_relaxed);
+    return (readable() > 0 || (!peerGone && !peerClosed()));
+}
+
+
+void ShmChannel::close()
+{
+    _out.header->closed.store(1, std::memory_order_release);
+    _out.header->readerParked.store(0, std::memory_order_relaxed);
+    signal(_peerEventFD);
+    wakeReader();
+}
+
+
+void ShmChannel::wakeReader()
+{
+    _wakeRequested.store(true, std::memory_order_relaxed); /* Spinning reader never polls the eventfd */
+    signal(_ownEventFD);
+}
+
+
+bool ShmChannel::peerClosed() const
+{
+    return (corrupted() || _in.header->closed.load(std::memory_order_acquire) != 0);
+}
+
+
+std::size_t ShmChannel::distance(uint64_t writePosition, uint64_t readPosition) const
+{
+    uint64_t n = writePosition - readPosition;
+
+    if (n <= RingCapacity)
+    {
+        return n;
+    }
+
+    if (!_corrupted.exchange(true, std::memory_order_relaxed))
+    {
+        signal(_ownEventFD); /* Parked reader sees peerClosed() */
+    }
+
+    return 0;
+}
+
+
+void ShmChannel::signal(int eventFD)
+{
+    uint64_t one = 1;
+    if (write(eventFD, &one, sizeof(one)) == (-1) && errno != EAGAIN)
+    {
+        /* Counter saturated => reader already has a wake-up pending */
+    }
+}
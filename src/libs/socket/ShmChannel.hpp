@@ -0,0 +1,112 @@
+/**
+ * @file ShmChannel.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "utilities/Doorbell.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+
+/**
+ * Shared-memory connection between two co-located processes.
+ *
+ * One memfd holds a single-producer/single-consumer byte ring per direction. Messages are copied
+ * once into the ring and read straight out of it by the peer: no kernel copies. A reader that has
+ * spun without finding data parks in poll() on an eventfd, which the writer signals only when the
+ * reader is parked.
+ *
+ * Set up over a connected AF_UNIX stream socket: the accepting side creates the memfd and eventfds
+ * and passes them with SCM_RIGHTS. The socket then only signals the peer going away.
+ *
+ * Ring positions live in memory the peer can write. Positions more than RingCapacity apart mark the
+ * channel corrupted, which reads as the peer having closed.
+ */
+class ShmChannel
+{
+public:
+    /* Bytes per direction */
+    static constexpr std::size_t RingCapacity = std::size_t(1) << 20;
+
+    /* Accepting side: create the rings and send them to the peer. Throws std::runtime_error */
+    static std::unique_ptr<ShmChannel> offer(int unixSocket);
+
+    /* Connecting side: receive the rings from the peer (blocking). Throws std::runtime_error */
+    static std::unique_ptr<ShmChannel> accept(int unixSocket);
+
+    ~ShmChannel();
+
+    ShmChannel(const ShmChannel &) = delete;
+    ShmChannel &operator=(const ShmChannel &) = delete;
+
+    /* Producer: append all n bytes or nothing (false => not enough space). Callers serialize with
+     * writeMutex() if several threads send */
+    bool tryWrite(const char *data, std::size_t n);
+
+    /* Producer: wake the peer's reader if parked. Call after tryWrite() */
+    void notifyPeer();
+
+    [[nodiscard]] inline std::mutex &writeMutex() { return _writeMutex; }
+
+    /* Consumer: bytes ready to read */
+    [[nodiscard]] std::size_t readable() const;
+
+    /* Consumer: copy up to n bytes into out. Returns number copied */
+    std::size_t read(char *out, std::size_t n);
+
+    /* Consumer: wait until data is readable, either side closes or wakeReader() is called. Watches
+     * unixSocket for the peer exiting (polled periodically while spinning). Returns false once the
+     * peer has gone */
+    bool waitReadable(int unixSocket, Doorbell::WaitStrategy strategy);
+
+    /* Tell the peer we are closing and wake our own reader */
+    void close();
+
+    /* Wake our own reader (e.g. on shutdown) */
+    void wakeReader();
+
+    /* Peer closed the channel or corrupted its positions */
+    [[nodiscard]] bool peerClosed() const;
+
+    [[nodiscard]] inline bool corrupted() const { return _corrupted.load(std::memory_order_relaxed); }
+
+private:
+    struct RingHeader;
+    struct Ring
+    {
+        RingHeader *header{nullptr};
+        char *data{nullptr};
+    };
+
+    ShmChannel() = default;
+
+    /* Map memfd; accepting side writes ring 0 and reads ring 1 */
+    void map(int memFD, bool accepting);
+
+    static void signal(int eventFD);
+
+    /* Bytes between positions, or 0 (and the channel marked corrupted) if they are out of range */
+    std::size_t distance(uint64_t writePosition, uint64_t readPosition) const;
+
+    void *_mapping{nullptr};
+    std::size_t _mappingSize{0};
+
+    Ring _out; /* We write */
+    Ring _in;  /* We read */
+
+    int _peerEventFD{-1}; /* Signalled when the peer's reader is parked */
+    int _ownEventFD{-1};  /* Our reader parks on this */
+
+    std::atomic<bool> _wakeRequested{false}; /* close()/wakeReader() called. Checked while spinning */
+    mutable std::atomic<bool> _corrupted{false};
+
+    std::mutex _writeMutex;
+};
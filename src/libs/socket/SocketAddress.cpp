@@ -0,0 +1,115 @@
+/**
+ * @file SocketAddress.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "SocketAddress.hpp"
+#include <arpa/inet.h>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <netinet/in.h>
+#include <stdexcept>
+#include <sys/un.h>
+#include <utility>
+
+
+namespace
+{
+constexpr std::string_view TcpScheme = "tcp:";
+constexpr std::string_view UnixScheme = "unix:";
+constexpr std::string_view UnixPacketScheme = "unixpacket:";
+constexpr std::string_view SharedMemoryScheme = "shm:";
+
+bool startsWith(std::string_view text, std::string_view prefix)
+{
+    return (text.substr(0, prefix.size()) == prefix);
+}
+} // namespace
+
+
+SocketAddress SocketAddress::parse(std::string_view address)
+{
+    for (auto [scheme, family] : {std::pair{UnixScheme, Family::Unix}, std::pair{UnixPacketScheme, Family::UnixPacket},
+                                 std::pair{SharedMemoryScheme, Family::SharedMemory}})
+    {
+        if (!startsWith(address, scheme))
+            continue;
+
+        std::string_view path = address.substr(scheme.size());
+
+        if (path.empty() || path.size() >= sizeof(sockaddr_un::sun_path))
+        {
+            throw std::runtime_error("Invalid unix socket path: " + std::string(address));
+        }
+
+        return SocketAddress(family, std::string(path));
+    }
+
+    std::string_view portText = (startsWith(address, TcpScheme) ? address.substr(TcpScheme.size()) : address);
+
+    unsigned port = 0;
+    auto [end, error] = std::from_chars(portText.data(), portText.data() + portText.size(), port);
+
+    if (error != std::errc() || end != portText.data() + portText.size() || port == 0 || port > UINT16_MAX)
+    {
+        throw std::runtime_error("Invalid address: " + std::string(address));
+    }
+
+    return SocketAddress(static_cast<uint16_t>(port));
+}
+
+
+int SocketAddress::openSocket() const
+{
+    switch (family)
+    {
+        case Family::Unix:
+        case Family::SharedMemory:
+            return socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        case Family::UnixPacket:
+            return socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+        default:
+            return socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    }
+}
+
+
+socklen_t SocketAddress::toSockaddr(sockaddr_storage &storage, bool loopback) const
+{
+    std::memset(&storage, 0, sizeof(storage));
+
+    if (isUnix())
+    {
+        auto &unixAddress = reinterpret_cast<sockaddr_un &>(storage);
+        unixAddress.sun_family = AF_UNIX;
+        std::memcpy(unixAddress.sun_path, path.data(), path.size()); /* Length checked by parse() */
+        return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + path.size() + 1);
+    }
+
+    auto &inetAddress = reinterpret_cast<sockaddr_in &>(storage);
+    inetAddress.sin_family = AF_INET;                                                /* IPV4 */
+    inetAddress.sin_port = htons(port);                                              /* Port */
+    inetAddress.sin_addr.s_addr = (loopback ? inet_addr("127.0.0.1") : INADDR_ANY); /* Localhost or all interfaces */
+    return sizeof(sockaddr_in);
+}
+
+
+std::string SocketAddress::toString() const
+{
+    switch (family)
+    {
+        case Family::Unix:
+            return std::string(UnixScheme) + path;
+        case Family::UnixPacket:
+            return std::string(UnixPacketScheme) + path;
+        case Family::SharedMemory:
+            return std::string(SharedMemoryScheme) + path;
+        default:
+            return std::string(TcpScheme) + std::to_string(port);
+    }
+}
@@ -0,0 +1,61 @@
+/**
+ * @file SocketAddress.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <utility>
+
+
+/**
+ * Where a server listens or a client connects.
+ *
+ * Written as "PORT" or "tcp:PORT" (TCP on localhost), "unix:/path" (AF_UNIX SOCK_STREAM) or
+ * "unixpacket:/path" (AF_UNIX SOCK_SEQPACKET: one record per send, so message boundaries are kept).
+ * "shm:/path" is a shared-memory channel (see ShmChannel) set up over an AF_UNIX stream socket at path.
+ */
+struct SocketAddress
+{
+    enum class Family : uint8_t
+    {
+        Tcp = 0,
+        Unix = 1,
+        UnixPacket = 2,
+        SharedMemory = 3
+    };
+
+    SocketAddress() = default;
+
+    /* Implicit: a bare port is TCP */
+    SocketAddress(uint16_t port) : port(port) {}
+
+    SocketAddress(Family family, std::string path) : family(family), path(std::move(path)) {}
+
+    /* Throws std::runtime_error if malformed */
+    static SocketAddress parse(std::string_view address);
+
+    /* Unconnected socket of the right domain/type (close-on-exec). (-1) on error */
+    [[nodiscard]] int openSocket() const;
+
+    /* Fill storage for bind()/connect(). loopback => 127.0.0.1 else INADDR_ANY (TCP only) */
+    [[nodiscard]] socklen_t toSockaddr(sockaddr_storage &storage, bool loopback) const;
+
+    [[nodiscard]] inline bool isUnix() const { return family != Family::Tcp; }
+
+    [[nodiscard]] inline bool isSharedMemory() const { return family == Family::SharedMemory; }
+
+    /* Canonical form accepted by parse() */
+    [[nodiscard]] std::string toString() const;
+
+    Family family{Family::Tcp};
+    uint16_t port{0}; /* TCP */
+    std::string path; /* AF_UNIX */
+};
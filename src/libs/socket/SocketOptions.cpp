@@ -0,0 +1,187 @@
+/**
+ * @file SocketOptions.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "SocketOptions.hpp"
+#include "logger/Logger.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <sys/socket.h>
+
+
+namespace
+{
+bool setOption(int socket, int level, int name, int value, const char *optionName)
+{
+    if (setsockopt(socket, level, name, &value, sizeof(value)) == (-1))
+    {
+        Logger::instance().error("Failed to set " + std::string(optionName) + "=" + std::to_string(value) + " (socket: " + std::to_string(socket) + "): " + std::strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+
+int getOption(int socket, int level, int name)
+{
+    int value = -1;
+    socklen_t length = sizeof(value);
+
+    return (getsockopt(socket, level, name, &value, &length) == (-1) ? (-1) : value);
+}
+
+
+int parseInt(std::string_view text, std::string_view spec)
+{
+    int value = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+
+    if (error != std::errc() || end != text.data() + text.size() || value < 0)
+    {
+        throw std::runtime_error("Invalid socket options: " + std::string(spec));
+    }
+
+    return value;
+}
+} // namespace
+
+
+bool SocketOptions::apply(int socket) const
+{
+    bool success = true;
+
+    if (sendBufferBytes > 0)
+        success &= setOption(socket, SOL_SOCKET, SO_SNDBUF, sendBufferBytes, "SO_SNDBUF");
+    if (receiveBufferBytes > 0)
+        success &= setOption(socket, SOL_SOCKET, SO_RCVBUF, receiveBufferBytes, "SO_RCVBUF");
+
+    if (getOption(socket, SOL_SOCKET, SO_DOMAIN) == AF_UNIX) /* No TCP stack => only buffer sizes apply */
+        return success;
+
+    success &= setOption(socket, IPPROTO_TCP, TCP_NODELAY, noDelay, "TCP_NODELAY");
+
+    if (quickAck)
+        success &= setOption(socket, IPPROTO_TCP, TCP_QUICKACK, 1, "TCP_QUICKACK");
+    if (busyPollMicros > 0)
+        success &= setOption(socket, SOL_SOCKET, SO_BUSY_POLL, busyPollMicros, "SO_BUSY_POLL");
+    if (userTimeoutMillis > 0)
+        success &= setOption(socket, IPPROTO_TCP, TCP_USER_TIMEOUT, userTimeoutMillis, "TCP_USER_TIMEOUT");
+
+    if (keepAlive)
+    {
+        success &= setOption(socket, SOL_SOCKET, SO_KEEPALIVE, 1, "SO_KEEPALIVE");
+
+        if (keepAliveIdleSecs > 0)
+            success &= setOption(socket, IPPROTO_TCP, TCP_KEEPIDLE, keepAliveIdleSecs, "TCP_KEEPIDLE");
+        if (keepAliveIntervalSecs > 0)
+            success &= setOption(socket, IPPROTO_TCP, TCP_KEEPINTVL, keepAliveIntervalSecs, "TCP_KEEPINTVL");
+        if (keepAliveCount > 0)
+            success &= setOption(socket, IPPROTO_TCP, TCP_KEEPCNT, keepAliveCount, "TCP_KEEPCNT");
+    }
+
+    return success;
+}
+
+
+std::string SocketOptions::describe(int socket)
+{
+    std::string result;
+
+    if (getOption(socket, SOL_SOCKET, SO_DOMAIN) == AF_UNIX)
+    {
+        result.append("unix,sndbuf=").append(std::to_string(getOption(socket, SOL_SOCKET, SO_SNDBUF)));
+        result.append(",rcvbuf=").append(std::to_string(getOption(socket, SOL_SOCKET, SO_RCVBUF)));
+        return result;
+    }
+
+    result.append("nodelay=").append(std::to_string(getOption(socket, IPPROTO_TCP, TCP_NODELAY)));
+    result.append(",quickack=").append(std::to_string(getOption(socket, IPPROTO_TCP, TCP_QUICKACK)));
+    result.append(",sndbuf=").append(std::to_string(getOption(socket, SOL_SOCKET, SO_SNDBUF)));
+    result.append(",rcvbuf=").append(std::to_string(getOption(socket, SOL_SOCKET, SO_RCVBUF)));
+    result.append(",busypoll=").append(std::to_string(getOption(socket, SOL_SOCKET, SO_BUSY_POLL)));
+    result.append(",usertimeout=").append(std::to_string(getOption(socket, IPPROTO_TCP, TCP_USER_TIMEOUT)));
+
+    if (getOption(socket, SOL_SOCKET, SO_KEEPALIVE) > 0)
+    {
+        result.append(",keepalive=").append(std::to_string(getOption(socket, IPPROTO_TCP, TCP_KEEPIDLE)));
+        result.append(":").append(std::to_string(getOption(socket, IPPROTO_TCP, TCP_KEEPINTVL)));
+        result.append(":").append(std::to_string(getOption(socket, IPPROTO_TCP, TCP_KEEPCNT)));
+    }
+    else
+    {
+        result.append(",keepalive=0");
+    }
+
+    return result;
+}
+
+
+SocketOptions SocketOptions::parse(std::string_view spec)
+{
+    SocketOptions options;
+
+    for (std::string_view remaining = spec; !remaining.empty();)
+    {
+        std::size_t comma = remaining.find(',');
+        std::string_view item = remaining.substr(0, comma);
+        remaining = (comma == std::string_view::npos ? std::string_view() : remaining.substr(comma + 1));
+
+        std::size_t equals = item.find('=');
+        if (equals == std::string_view::npos)
+        {
+            throw std::runtime_error("Invalid socket options: " + std::string(spec));
+        }
+
+        std::string_view key = item.substr(0, equals);
+        std::string_view value = item.substr(equals + 1);
+
+        if (key == "nodelay")
+            options.noDelay = parseInt(value, spec);
+        else if (key == "quickack")
+            options.quickAck = parseInt(value, spec);
+        else if (key == "sndbuf")
+            options.sendBufferBytes = parseInt(value, spec);
+        else if (key == "rcvbuf")
+            options.receiveBufferBytes = parseInt(value, spec);
+        else if (key == "busypoll")
+            options.busyPollMicros = parseInt(value, spec);
+        else if (key == "usertimeout")
+            options.userTimeoutMillis = parseInt(value, spec);
+        else if (key == "keepalive")
+        {
+            std::size_t first = value.find(':');
+            if (first == std::string_view::npos) /* On/off only */
+            {
+                options.keepAlive = parseInt(value, spec);
+                continue;
+            }
+
+            std::size_t second = value.find(':', first + 1);
+            if (second == std::string_view::npos)
+            {
+                throw std::runtime_error("Invalid socket options: " + std::string(spec));
+            }
+
+            options.keepAlive = true;
+            options.keepAliveIdleSecs = parseInt(value.substr(0, first), spec);
+            options.keepAliveIntervalSecs = parseInt(value.substr(first + 1, second - first - 1), spec);
+            options.keepAliveCount = parseInt(value.substr(second + 1), spec);
+        }
+        else
+        {
+            throw std::runtime_error("Unknown socket option: " + std::string(key));
+        }
+    }
+
+    return options;
+}
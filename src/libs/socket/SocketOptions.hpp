@@ -0,0 +1,44 @@
+/**
+ * @file SocketOptions.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <string>
+#include <string_view>
+
+
+/**
+ * Socket tuning profile for a TCP connection. Zero => leave the kernel default. On AF_UNIX sockets
+ * only the buffer sizes apply.
+ *
+ * Profiles are written as comma-separated key=value pairs, e.g.
+ * "nodelay=1,quickack=1,sndbuf=262144,rcvbuf=262144,busypoll=50,usertimeout=5000,keepalive=30:10:3"
+ * where keepalive is IDLE:INTERVAL:COUNT (seconds, seconds, probes) or 0 to disable.
+ */
+struct SocketOptions
+{
+    bool noDelay{true};           /* TCP_NODELAY: no Nagle delay on small messages */
+    bool quickAck{false};         /* TCP_QUICKACK: set on setup; the kernel may fall back to delayed ACKs */
+    int sendBufferBytes{0};       /* SO_SNDBUF */
+    int receiveBufferBytes{0};    /* SO_RCVBUF */
+    int busyPollMicros{0};        /* SO_BUSY_POLL */
+    int userTimeoutMillis{0};     /* TCP_USER_TIMEOUT: drop connection if data is unacknowledged this long */
+    bool keepAlive{false};        /* SO_KEEPALIVE */
+    int keepAliveIdleSecs{0};     /* TCP_KEEPIDLE */
+    int keepAliveIntervalSecs{0}; /* TCP_KEEPINTVL */
+    int keepAliveCount{0};        /* TCP_KEEPCNT */
+
+    /* Apply to socket. Failures are logged. Returns false if any option could not be set */
+    bool apply(int socket) const;
+
+    /* Effective values read back from the kernel (same format as parse()) */
+    static std::string describe(int socket);
+
+    /* Profile from defaults overridden by spec. Throws std::runtime_error if malformed */
+    static SocketOptions parse(std::string_view spec);
+};
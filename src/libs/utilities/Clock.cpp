@@ -0,0 +1,186 @@
+/**
+ * @file Clock.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Clock.hpp"
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TALOS_HAS_TSC 1
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+
+std::atomic<bool> Clock::_tscEnabled{false};
+double Clock::_nanosPerTick{0.0};
+uint64_t Clock::_tscOrigin{0};
+
+
+namespace
+{
+
+constexpr std::size_t PrefixLength = 17; /* YYYYMMDD-HH:MM:SS */
+
+/* Per-thread cache of the formatted prefix for the current second */
+struct PrefixCache
+{
+    int64_t second{-1};
+    char prefix[PrefixLength];
+};
+
+thread_local PrefixCache prefixCache;
+
+
+inline void writeDigits(char *buffer, unsigned int value, int nDigits)
+{
+    for (int i = nDigits - 1; i >= 0; --i)
+    {
+        buffer[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+
+void formatPrefix(int64_t seconds, char *buffer)
+{
+    std::time_t time = static_cast<std::time_t>(seconds);
+
+    struct tm gmTime; /* gmtime_r is a thread-safe verison */
+    gmtime_r(&time, &gmTime);
+
+    writeDigits(buffer, gmTime.tm_year + 1900, 4);
+    writeDigits(buffer + 4, gmTime.tm_mon + 1, 2);
+    writeDigits(buffer + 6, gmTime.tm_mday, 2);
+    buffer[8] = '-';
+    writeDigits(buffer + 9, gmTime.tm_hour, 2);
+    buffer[11] = ':';
+    writeDigits(buffer + 12, gmTime.tm_min, 2);
+    buffer[14] = ':';
+    writeDigits(buffer + 15, gmTime.tm_sec, 2);
+}
+
+} // namespace
+
+
+std::size_t Clock::formatUTC(char *buffer, Precision precision)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now); /* vDSO => no syscall */
+
+    return formatUTC(now.tv_sec, now.tv_nsec, buffer, precision);
+}
+
+
+std::size_t Clock::formatUTC(int64_t seconds, long nanoseconds, char *buffer, Precision precision)
+{
+    if (prefixCache.second != seconds)
+    {
+        formatPrefix(seconds, prefixCache.prefix);
+        prefixCache.second = seconds;
+    }
+
+    std::memcpy(buffer, prefixCache.prefix, PrefixLength);
+
+    switch (precision)
+    {
+        case Milliseconds:
+            buffer[PrefixLength] = '.';
+            writeDigits(buffer + PrefixLength + 1, static_cast<unsigned int>(nanoseconds / 1000000), 3);
+            return PrefixLength + 4;
+        case Microseconds:
+            buffer[PrefixLength] = '.';
+            writeDigits(buffer + PrefixLength + 1, static_cast<unsigned int>(nanoseconds / 1000), 6);
+            return PrefixLength + 7;
+        default:
+            return PrefixLength;
+    }
+}
+
+
+std::string Clock::nowUTC(Precision precision)
+{
+    char buffer[MaxFormattedLength];
+    return std::string(buffer, formatUTC(buffer, precision));
+}
+
+
+uint64_t Clock::monotonicNanos()
+{
+#ifdef TALOS_HAS_TSC
+    if (tscEnabled())
+    {
+        return static_cast<uint64_t>((__rdtsc() - _tscOrigin) * _nanosPerTick);
+    }
+#endif
+
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+
+bool Clock::enableTsc(bool enable)
+{
+    if (!enable)
+    {
+        _tscEnabled = false;
+        return false;
+    }
+
+    if (!hasInvariantTsc())
+    {
+        return false;
+    }
+
+    static std::once_flag calibrated;
+    std::call_once(calibrated, &Clock::calibrateTsc);
+
+    _tscEnabled = true;
+    return true;
+}
+
+
+bool Clock::hasInvariantTsc()
+{
+#ifdef TALOS_HAS_TSC
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007)
+    {
+        return false;
+    }
+
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0; /* Invariant TSC */
+#else
+    return false;
+#endif
+}
+
+
+void Clock::calibrateTsc()
+{
+#ifdef TALOS_HAS_TSC
+    auto steadyStart = std::chrono::steady_clock::now();
+    uint64_t tscStart = __rdtsc();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    auto steadyEnd = std::chrono::steady_clock::now();
+    uint64_t tscEnd = __rdtsc();
+
+    double elapsedNanos = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(steadyEnd - steadyStart).count());
+
+    _nanosPerTick = elapsedNanos / static_cast<double>(tscEnd - tscStart);
+    _tscOrigin = tscStart;
+#endif
+}
@@ -0,0 +1,68 @@
+/**
+ * @file Clock.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+/**
+ * Shared clock service.
+ *
+ * Wall-clock: formats UTC timestamps (FIX UTCTimestamp: YYYYMMDD-HH:MM:SS[.sss[sss]]). The
+ * YYYYMMDD-HH:MM:SS prefix is cached per-thread for each second so most calls only write the
+ * sub-second digits.
+ *
+ * Monotonic: nanoseconds for latency measurement. Optionally backed by the TSC (calibrated once
+ * against the steady clock) when the CPU has an invariant TSC.
+ */
+class Clock
+{
+public:
+    enum Precision
+    {
+        Seconds = 0,
+        Milliseconds = 3,
+        Microseconds = 6
+    };
+
+    /* Maximum number of characters written by formatUTC() */
+    static constexpr std::size_t MaxFormattedLength = 24;
+
+    /* Writes current UTC time into buffer (not null-terminated). Returns number of characters */
+    static std::size_t formatUTC(char *buffer, Precision precision = Milliseconds);
+
+    /* Writes UTC time for seconds/nanoseconds since epoch into buffer. Returns number of characters */
+    static std::size_t formatUTC(int64_t seconds, long nanoseconds, char *buffer, Precision precision = Milliseconds);
+
+    /* Convenience. Prefer formatUTC() on hot paths */
+    static std::string nowUTC(Precision precision = Milliseconds);
+
+    /* Monotonic nanoseconds (arbitrary epoch) */
+    static uint64_t monotonicNanos();
+
+    /* Use TSC for monotonicNanos() if invariant TSC is available. Returns true if enabled */
+    static bool enableTsc(bool enable = true);
+
+    /* True if monotonicNanos() is backed by the TSC */
+    [[nodiscard]] static inline bool tscEnabled() { return _tscEnabled.load(std::memory_order_acquire); }
+
+private:
+    /* Returns true if CPU has an invariant (constant-rate) TSC */
+    static bool hasInvariantTsc();
+
+    /* Measure TSC frequency against the steady clock */
+    static void calibrateTsc();
+
+    static std::atomic<bool> _tscEnabled;
+    static double _nanosPerTick;
+    static uint64_t _tscOrigin;
+};
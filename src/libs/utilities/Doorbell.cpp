@@ -0,0 +1,50 @@
+/**
+ * @file Doorbell.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Doorbell.hpp"
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TALOS_HAS_PAUSE 1
+#include <x86intrin.h>
+#endif
+
+
+Doorbell::WaitStrategy Doorbell::defaultStrategy()
+{
+    static const WaitStrategy strategy = (std::thread::hardware_concurrency() > 1 ? WaitStrategy::SpinThenPark : WaitStrategy::Block);
+    return strategy;
+}
+
+
+void Doorbell::cpuRelax()
+{
+#ifdef TALOS_HAS_PAUSE
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+
+void Doorbell::futexWait(std::atomic<uint32_t> &word, uint32_t expected)
+{
+    /* Returns immediately if word != expected (already rung). Spurious wake-ups re-check in wait() */
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+
+void Doorbell::futexWake(std::atomic<uint32_t> &word)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
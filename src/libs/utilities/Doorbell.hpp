@@ -0,0 +1,93 @@
+/**
+ * @file Doorbell.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+
+/**
+ * Wakes a single consumer thread when producers publish work.
+ *
+ * The consumer waits on a readiness predicate using its wait strategy; producers call ring() after
+ * publishing. ring() is a fence and a load unless the consumer is parked in the kernel (futex).
+ */
+class Doorbell
+{
+public:
+    enum class WaitStrategy : uint8_t
+    {
+        Spin = 0,         /* Busy-poll: lowest latency, burns a core */
+        SpinThenPark = 1, /* Spin briefly then sleep on a futex */
+        Block = 2         /* Sleep immediately */
+    };
+
+    /* Iterations spun before parking (SpinThenPark) */
+    static constexpr unsigned SpinIterations = 1024;
+
+    explicit Doorbell(WaitStrategy strategy = defaultStrategy()) : _strategy(strategy) {}
+
+    /* SpinThenPark, or Block on a single CPU where spinning only delays the producer */
+    static WaitStrategy defaultStrategy();
+
+    Doorbell(const Doorbell &) = delete;
+    Doorbell &operator=(const Doorbell &) = delete;
+
+    /* Consumer only. Not while waiting */
+    void setStrategy(WaitStrategy strategy) { _strategy = strategy; }
+    [[nodiscard]] WaitStrategy strategy() const { return _strategy; }
+
+    /* Consumer: returns once ready() is true */
+    template <typename Ready>
+    void wait(Ready &&ready)
+    {
+        for (unsigned i = 0; _strategy != WaitStrategy::Block && (_strategy == WaitStrategy::Spin || i < SpinIterations); ++i)
+        {
+            if (ready())
+                return;
+
+            cpuRelax();
+        }
+
+        while (!ready())
+        {
+            _parked.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst); /* Pairs with fence in ring() */
+
+            if (ready())
+            {
+                _parked.store(0, std::memory_order_relaxed);
+                return;
+            }
+
+            futexWait(_parked, 1);
+        }
+    }
+
+    /* Producer: call after publishing work */
+    void ring()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst); /* Publish before checking for a sleeper */
+
+        if (_parked.load(std::memory_order_relaxed) && _parked.exchange(0, std::memory_order_relaxed))
+        {
+            futexWake(_parked);
+        }
+    }
+
+    /* Pause hint for spin loops */
+    static void cpuRelax();
+
+private:
+    static void futexWait(std::atomic<uint32_t> &word, uint32_t expected);
+    static void futexWake(std::atomic<uint32_t> &word);
+
+    WaitStrategy _strategy;
+    std::atomic<uint32_t> _parked{0}; /* 1 => consumer may be asleep in futexWait() */
+};
@@ -0,0 +1,124 @@
+/**
+ * @file MpscQueue.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+
+/**
+ * Bounded lock-free multi-producer/single-consumer queue.
+ *
+ * Each cell carries a sequence number (Vyukov). Producers claim a position with a CAS and publish
+ * by advancing the cell's sequence; the single consumer never writes a shared counter, so it can
+ * drain a batch without any atomic read-modify-write.
+ */
+template <typename T>
+class MpscQueue
+{
+public:
+    /* Capacity rounded up to a power of 2 */
+    explicit MpscQueue(std::size_t capacity) : _mask(roundUpPow2(capacity) - 1), _cells(new Cell[_mask + 1])
+    {
+        for (std::size_t i = 0; i <= _mask; ++i)
+        {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    [[nodiscard]] inline std::size_t capacity() const { return _mask + 1; }
+
+    /* Producers. Returns false (value untouched) if full */
+    bool tryPush(T &&value)
+    {
+        std::size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+        Cell *cell;
+
+        while (true)
+        {
+            cell = &_cells[position & _mask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (diff == 0) /* Free => claim */
+            {
+                if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) /* Consumer has not freed it yet */
+            {
+                return false;
+            }
+            else /* Claimed by another producer */
+            {
+                position = _enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* Consumer only. Appends up to maxItems to out (any container with push_back). Returns number dequeued */
+    template <typename Container>
+    std::size_t popBatch(Container &out, std::size_t maxItems)
+    {
+        std::size_t n = 0;
+
+        for (; n < maxItems; ++n)
+        {
+            Cell &cell = _cells[_dequeuePosition & _mask];
+            if (cell.sequence.load(std::memory_order_acquire) != _dequeuePosition + 1)
+                break;
+
+            out.push_back(std::move(cell.value));
+            cell.sequence.store(_dequeuePosition + _mask + 1, std::memory_order_release); /* Free for next lap */
+            ++_dequeuePosition;
+        }
+
+        return n;
+    }
+
+    /* Consumer only */
+    [[nodiscard]] bool empty() const
+    {
+        return (_cells[_dequeuePosition & _mask].sequence.load(std::memory_order_acquire) != _dequeuePosition + 1);
+    }
+
+private:
+    static std::size_t roundUpPow2(std::size_t n)
+    {
+        std::size_t result = 2;
+        while (result < n)
+        {
+            result <<= 1;
+        }
+
+        return result;
+    }
+
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    const std::size_t _mask;
+    std::unique_ptr<Cell[]> _cells;
+
+    alignas(64) std::atomic<std::size_t> _enqueuePosition{0}; /* Own cache line: contended by producers */
+    alignas(64) std::size_t _dequeuePosition{0};              /* Consumer only */
+};
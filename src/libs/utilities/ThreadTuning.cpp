@@ -0,0 +1,107 @@
+/**
+ * @file ThreadTuning.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ThreadTuning.hpp"
+#include "logger/Logger.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+#include <string>
+
+
+bool ThreadTuning::apply(int cpu, int fifoPriority)
+{
+    bool success = true;
+
+    if (cpu >= 0)
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpu, &cpuSet);
+
+        int result = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+        if (result != 0)
+        {
+            Logger::instance().error("Failed to pin thread to CPU " + std::to_string(cpu) + ": " + std::strerror(result));
+            success = false;
+        }
+    }
+
+    if (fifoPriority > 0)
+    {
+        struct sched_param param{};
+        param.sched_priority = fifoPriority;
+
+        int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (result != 0)
+        {
+            Logger::instance().error("Failed to set SCHED_FIFO priority " + std::to_string(fifoPriority) + ": " + std::strerror(result));
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+
+int ThreadTuning::select(const std::vector<int> &cpus, std::size_t index)
+{
+    return cpus.empty() ? (-1) : cpus[index % cpus.size()];
+}
+
+
+std::vector<int> ThreadTuning::parseCpuList(std::string_view list)
+{
+    auto parseCpu = [list](std::string_view text)
+    {
+        int cpu = -1;
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), cpu);
+
+        if (error != std::errc() || end != text.data() + text.size() || cpu < 0 || cpu >= CPU_SETSIZE)
+        {
+            throw std::runtime_error("Invalid CPU list: " + std::string(list));
+        }
+
+        return cpu;
+    };
+
+    std::vector<int> cpus;
+
+    for (bool more = !list.empty(); more;)
+    {
+        std::size_t comma = list.find(',');
+        std::string_view item = list.substr(0, comma);
+        std::size_t dash = item.find('-');
+
+        if (dash == std::string_view::npos)
+        {
+            cpus.push_back(parseCpu(item));
+        }
+        else
+        {
+            int first = parseCpu(item.substr(0, dash));
+            int last = parseCpu(item.substr(dash + 1));
+
+            if (last < first)
+                throw std::runtime_error("Invalid CPU range: " + std::string(item));
+
+            for (int cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        }
+
+        more = (comma != std::string_view::npos); /* Trailing comma => empty item => error */
+        if (more)
+            list = list.substr(comma + 1);
+    }
+
+    return cpus;
+}
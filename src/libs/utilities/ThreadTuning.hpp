@@ -0,0 +1,31 @@
+/**
+ * @file ThreadTuning.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+
+/**
+ * CPU affinity and real-time scheduling for latency-critical threads.
+ */
+class ThreadTuning
+{
+public:
+    /* Pin the calling thread to cpu (-1 => leave unpinned) and optionally switch it to SCHED_FIFO at
+     * fifoPriority (0 => leave default scheduler). Failures are logged. Returns true on success */
+    static bool apply(int cpu, int fifoPriority = 0);
+
+    /* CPU for the index'th thread of a role, assigned round-robin. -1 if cpus is empty */
+    [[nodiscard]] static int select(const std::vector<int> &cpus, std::size_t index);
+
+    /* Parses a CPU list such as "2,3,6-8". Throws std::runtime_error if malformed */
+    static std::vector<int> parseCpuList(std::string_view list);
+};
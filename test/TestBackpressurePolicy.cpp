@@ -0,0 +1,36 @@
+/**
+ * @file TestBackpressurePolicy.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <socket/BackpressurePolicy.hpp>
+#include <stdexcept>
+
+namespace Socket
+{
+
+TEST(BackpressurePolicyTest, CheckParse)
+{
+    BackpressurePolicy policy = BackpressurePolicy::parse("policy=drop,high=4096,low=1024,timeout=250");
+
+    EXPECT_EQ(policy.action, BackpressurePolicy::Action::Drop);
+    EXPECT_EQ(policy.highWater, 4096u);
+    EXPECT_EQ(policy.lowWater, 1024u);
+    EXPECT_EQ(policy.blockTimeoutMS, 250u);
+    EXPECT_EQ(BackpressurePolicy::parse(policy.describe()).describe(), policy.describe());
+
+    EXPECT_EQ(BackpressurePolicy::parse("").action, BackpressurePolicy::Action::Block); /* Default: wait for sender */
+    EXPECT_EQ(BackpressurePolicy::parse("policy=disconnect,high=100").lowWater, 75u);
+
+    EXPECT_THROW(BackpressurePolicy::parse("policy=shed"), std::runtime_error);
+    EXPECT_THROW(BackpressurePolicy::parse("high=100,low=100"), std::runtime_error);
+    EXPECT_THROW(BackpressurePolicy::parse("high=0"), std::runtime_error);
+    EXPECT_THROW(BackpressurePolicy::parse("high=lots"), std::runtime_error);
+}
+
+} // namespace Socket
@@ -0,0 +1,53 @@
+/**
+ * @file TestClock.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <utilities/Clock.hpp>
+
+namespace Utilities
+{
+
+TEST(ClockTest, CheckFormatUTC)
+{
+    char buffer[Clock::MaxFormattedLength];
+
+    /* 2025-07-27 13:45:09.123456789 UTC */
+    int64_t seconds = 1753623909;
+    long nanoseconds = 123456789;
+
+    EXPECT_EQ(std::string(buffer, Clock::formatUTC(seconds, nanoseconds, buffer, Clock::Seconds)), "20250727-13:45:09");
+    EXPECT_EQ(std::string(buffer, Clock::formatUTC(seconds, nanoseconds, buffer, Clock::Milliseconds)), "20250727-13:45:09.123");
+    EXPECT_EQ(std::string(buffer, Clock::formatUTC(seconds, nanoseconds, buffer, Clock::Microseconds)), "20250727-13:45:09.123456");
+
+    /* Cached prefix must be refreshed on the next second */
+    EXPECT_EQ(std::string(buffer, Clock::formatUTC(seconds + 51, 0, buffer, Clock::Milliseconds)), "20250727-13:46:00.000");
+}
+
+
+TEST(ClockTest, CheckMonotonic)
+{
+    for (bool tsc : {false, true})
+    {
+        Clock::enableTsc(tsc);
+
+        uint64_t previous = Clock::monotonicNanos();
+        for (int i = 0; i < 1000; ++i)
+        {
+            uint64_t now = Clock::monotonicNanos();
+            EXPECT_GE(now, previous);
+            previous = now;
+        }
+    }
+
+    Clock::enableTsc(false);
+}
+
+
+} // namespace Utilities
@@ -0,0 +1,104 @@
+/**
+ * @file TestExchangeServer.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <arpa/inet.h>
+#include <exchange/ExchangeServer.hpp>
+#include <fix/FixBuilder.hpp>
+#include <fix/FixTag.hpp>
+#include <gtest/gtest.h>
+#include <logger/Logger.hpp>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace Fix
+{
+
+class ExchangeServerTest : public testing::Test
+{
+protected:
+    static int connectTo(int port)
+    {
+        int client = socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (connect(client, (const struct sockaddr *)&address, sizeof(address)) != 0)
+        {
+            close(client);
+            return (-1);
+        }
+
+        timeval timeout{2, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        return client;
+    }
+
+    static std::size_t count(const std::string &haystack, const std::string &needle)
+    {
+        std::size_t n = 0;
+        for (auto pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + needle.size()))
+        {
+            ++n;
+        }
+
+        return n;
+    }
+};
+
+
+TEST_F(ExchangeServerTest, CheckOversizedOrderIsFilled)
+{
+    Logger::instance().setLevel(Logger::Warn);
+
+    ExchangeServer exchange(SocketAddress(26545));
+    exchange.start();
+
+    int client = connectTo(26545);
+    ASSERT_NE(client, (-1));
+
+    /* Larger than the handler's stack buffer */
+    std::string text(4096, 'x');
+
+    FixBuilder order(8192);
+    order.set<FixTag::MsgType>(FixMsgType::NewOrderSingle);
+    order.append(FixTag::ClOrdID, "big-order");
+    order.append(58, text); /* Text */
+
+    std::string_view encoded = order.finish();
+    ASSERT_EQ(send(client, encoded.data(), encoded.size(), 0), static_cast<ssize_t>(encoded.size()));
+
+    /* Partial fill then fill, each carrying the order's fields */
+    std::string received;
+    char buffer[4096];
+
+    while (count(received, text) < 2)
+    {
+        long nBytes = recv(client, buffer, sizeof(buffer), 0);
+        if (nBytes <= 0)
+            break;
+
+        received.append(buffer, static_cast<std::size_t>(nBytes));
+    }
+
+    EXPECT_EQ(count(received, text), 2u);
+    EXPECT_EQ(count(received, "39=1;"), 1u);
+    EXPECT_EQ(count(received, "39=2;"), 1u);
+
+    close(client);
+
+    exchange.stop();
+    exchange.wait();
+}
+
+} // namespace Fix
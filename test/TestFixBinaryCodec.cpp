@@ -0,0 +1,155 @@
+/**
+ * @file TestFixBinaryCodec.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <fix/FixBinaryCodec.hpp>
+#include <fix/FixBuilder.hpp>
+#include <fix/FixFrameDecoder.hpp>
+#include <fix/FixMessage.hpp>
+#include <fix/FixMessageView.hpp>
+#include <fix/FixTag.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+namespace Fix
+{
+
+class FixBinaryCodecTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _order.set<FixTag::MsgType>(FixMsgType::NewOrderSingle);
+        _order.set<FixTag::Side>(FixSide::Buy);
+        _order.set<FixTag::OrderQty>(250);
+        _order.set<FixTag::Price>(FixPrice::fromDouble(101.25));
+        _order.setTag(FixTag::ClOrdID, "yhsbzifzjntuzmi");
+        _order.setTag(FixTag::TransactTime, "20261017-22:57:47.246");
+        _order.setTag(FixTag::Currency, "GBP");
+        _order.setTag(FixTag::Price, "101.250"); /* Not canonical => variable section */
+    }
+
+    FixMessage _order;
+};
+
+
+TEST_F(FixBinaryCodecTest, CheckRoundTrip)
+{
+    std::string text = _order.toString();
+    std::string frame = FixBinaryCodec::encode(FixMessageView(text));
+
+    ASSERT_TRUE(FixBinaryCodec::isBinary(frame));
+    EXPECT_EQ(FixBinaryCodec::frameLength(frame), frame.size());
+
+    std::string decoded = FixBinaryCodec::decode(frame);
+    FixMessageView view(decoded);
+
+    EXPECT_EQ(view.size(), FixMessageView(text).size());
+    EXPECT_EQ(view.get<FixTag::MsgType>(), FixMsgType::NewOrderSingle);
+    EXPECT_EQ(view.getValue(FixTag::Side), "1");
+    EXPECT_EQ(view.getValue(FixTag::OrderQty), "250");
+    EXPECT_EQ(view.getValue(FixTag::Price), "101.250");
+    EXPECT_EQ(view.getValue(FixTag::ClOrdID), "yhsbzifzjntuzmi");
+    EXPECT_EQ(view.getValue(FixTag::TransactTime), "20261017-22:57:47.246");
+    EXPECT_EQ(view.getValue(FixTag::Currency), "GBP");
+
+    /* Decoded text is a valid frame */
+    EXPECT_EQ(FixFrameDecoder::decode(decoded).status, FixFrameDecoder::Complete);
+}
+
+
+TEST_F(FixBinaryCodecTest, CheckFrameDecoder)
+{
+    std::string frame = FixBinaryCodec::encode(FixMessageView(_order.toString()));
+    std::string stream = frame + _order.toString();
+
+    auto result = FixFrameDecoder::decode(stream);
+    EXPECT_EQ(result.status, FixFrameDecoder::Complete);
+    EXPECT_EQ(result.length, frame.size());
+
+    EXPECT_EQ(FixFrameDecoder::decode(std::string_view(frame).substr(0, frame.size() - 1)).status, FixFrameDecoder::Incomplete);
+}
+
+
+TEST_F(FixBinaryCodecTest, CheckParse)
+{
+    std::string text = _order.toString();
+    std::string frame = FixBinaryCodec::encode(FixMessageView(text));
+
+    FixMessageView view = FixBinaryCodec::parse(frame);
+
+    ASSERT_TRUE(view.isBinary());
+    EXPECT_EQ(view.size(), FixMessageView(text).size() - 3); /* No 8, 9, 10 */
+    EXPECT_EQ(view.get<FixTag::MsgType>(), FixMsgType::NewOrderSingle);
+    EXPECT_EQ(view.getValue(FixTag::Side), "1");
+    EXPECT_EQ(view.getValue(FixTag::OrderQty), "250");
+    EXPECT_EQ(view.getValue(FixTag::Price), "101.250");
+    EXPECT_EQ(view.getValue(FixTag::ClOrdID), "yhsbzifzjntuzmi");
+    EXPECT_EQ(view.getValue(FixTag::Currency), "GBP");
+
+    /* Fixed-block strings and variable fields point into the frame */
+    EXPECT_EQ(view.getValue(FixTag::ClOrdID).data(), FixBinaryCodec::findValue(frame, FixTag::ClOrdID).data());
+    EXPECT_EQ(view.getValue(FixTag::Currency).data(), FixBinaryCodec::findValue(frame, FixTag::Currency).data());
+
+    /* Formatted values survive a copy of the view */
+    FixMessageView copy = view;
+    EXPECT_EQ(copy.getValue(FixTag::OrderQty), "250");
+
+    /* Fields copy out as text */
+    FixBuilder builder(copy.textLength() + 64);
+    builder.appendFieldsOf(copy, {FixTag::Currency});
+    FixMessageView rebuilt(builder.finish());
+
+    EXPECT_EQ(rebuilt.getValue(FixTag::OrderQty), "250");
+    EXPECT_EQ(rebuilt.getValue(FixTag::Price), "101.250");
+    EXPECT_FALSE(rebuilt.hasTag(FixTag::Currency));
+
+    EXPECT_EQ(FixMessage(view).getValue(FixTag::ClOrdID), "yhsbzifzjntuzmi");
+}
+
+
+TEST_F(FixBinaryCodecTest, CheckChecksum)
+{
+    std::string frame = FixBinaryCodec::encode(FixMessageView(_order.toString()));
+    ASSERT_TRUE(FixBinaryCodec::verify(frame));
+
+    /* A flipped bit anywhere in the body is framed but rejected */
+    for (std::size_t i : {std::size_t{16}, std::size_t{40}, frame.size() - 1})
+    {
+        std::string corrupt = frame;
+        corrupt[i] = static_cast<char>(corrupt[i] ^ 0x04);
+
+        EXPECT_FALSE(FixBinaryCodec::verify(corrupt));
+
+        auto result = FixFrameDecoder::decode(corrupt);
+        EXPECT_EQ(result.status, FixFrameDecoder::Invalid);
+        EXPECT_EQ(result.length, frame.size());
+    }
+}
+
+
+TEST_F(FixBinaryCodecTest, CheckTruncatedFrame)
+{
+    std::string frame = FixBinaryCodec::encode(FixMessageView(_order.toString()));
+    EXPECT_THROW((void)FixBinaryCodec::decode(std::string_view(frame).substr(0, FixBinaryCodec::BlockLength)), std::runtime_error);
+    EXPECT_THROW((void)FixBinaryCodec::parse(std::string_view(frame).substr(0, FixBinaryCodec::BlockLength)), std::runtime_error);
+}
+
+
+TEST_F(FixBinaryCodecTest, CheckFindValue)
+{
+    _order.setTag(FixTag::OrigClOrdID, "abc");
+    std::string frame = FixBinaryCodec::encode(FixMessageView(_order.toString()));
+
+    EXPECT_EQ(FixBinaryCodec::findValue(frame, FixTag::ClOrdID), "yhsbzifzjntuzmi"); /* Fixed block */
+    EXPECT_EQ(FixBinaryCodec::findValue(frame, FixTag::OrigClOrdID), "abc");        /* Variable section */
+    EXPECT_TRUE(FixBinaryCodec::findValue(frame, FixTag::SecurityID).empty());
+}
+
+} // namespace Fix
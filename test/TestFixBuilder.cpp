@@ -0,0 +1,100 @@
+/**
+ * @file TestFixBuilder.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <fix/FixBuilder.hpp>
+#include <fix/FixMessage.hpp>
+#include <fix/FixMessageView.hpp>
+#include <fix/FixTag.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+namespace Fix
+{
+
+class FixBuilderTest : public testing::Test
+{
+protected:
+    char _buffer[256];
+};
+
+
+TEST_F(FixBuilderTest, CheckMatchesFixMessage)
+{
+    FixBuilder builder(_buffer, sizeof(_buffer));
+    builder.set<FixTag::MsgType>(FixMsgType::ExecutionReport);
+    builder.set<FixTag::Side>(FixSide::Buy);
+    builder.set<FixTag::Price>(FixPrice::fromDouble(100.0));
+
+    EXPECT_EQ(builder.finish(), "8=FIX.4.4;9=20;35=8;54=1;44=100.00;10=151;");
+}
+
+
+TEST_F(FixBuilderTest, CheckTemplate)
+{
+    FixTemplate execReport{{FixTag::MsgType, "8"}, {FixTag::Side, "1"}};
+
+    FixBuilder builder(_buffer, sizeof(_buffer));
+    execReport.apply(builder).set<FixTag::Price>(FixPrice::fromDouble(100.0));
+
+    EXPECT_EQ(builder.finish(), "8=FIX.4.4;9=20;35=8;54=1;44=100.00;10=151;");
+
+    /* Reuse */
+    builder.reset();
+    execReport.apply(builder).set<FixTag::Price>(FixPrice::fromDouble(99.5));
+
+    EXPECT_EQ(builder.finish(), "8=FIX.4.4;9=19;35=8;54=1;44=99.50;10=133;");
+}
+
+
+TEST_F(FixBuilderTest, CheckAppendFieldsOf)
+{
+    FixMessageView order("8=FIX.4.4;9=20;35=D;54=1;44=100.00;10=xxx;");
+
+    FixBuilder builder(_buffer, sizeof(_buffer));
+    builder.set<FixTag::MsgType>(FixMsgType::ExecutionReport);
+    builder.appendFieldsOf(order, {FixTag::MsgType});
+
+    std::string encoded(builder.finish());
+    EXPECT_EQ(builder.body(), "35=8;54=1;44=100.00;");
+    EXPECT_EQ(FixMessage(encoded).toString(), encoded);
+}
+
+
+TEST_F(FixBuilderTest, CheckReleaseMovesOwnedBuffer)
+{
+    FixBuilder builder(256);
+    builder.set<FixTag::MsgType>(FixMsgType::ExecutionReport).set<FixTag::Side>(FixSide::Buy).set<FixTag::Price>(FixPrice::fromDouble(100.0));
+
+    const char *storage = builder.body().data() - FixBuilder::HeaderReserve;
+    std::string message = builder.release();
+
+    EXPECT_EQ(message, "8=FIX.4.4;9=20;35=8;54=1;44=100.00;10=151;");
+    EXPECT_EQ(message.data(), storage); /* Moved, not copied */
+
+    /* Reuse allocates a new buffer */
+    builder.reset();
+    builder.set<FixTag::MsgType>(FixMsgType::ExecutionReport).set<FixTag::Side>(FixSide::Buy).set<FixTag::Price>(FixPrice::fromDouble(99.5));
+    EXPECT_EQ(builder.release(), "8=FIX.4.4;9=19;35=8;54=1;44=99.50;10=133;");
+    EXPECT_EQ(message, "8=FIX.4.4;9=20;35=8;54=1;44=100.00;10=151;");
+
+    /* Caller-owned buffers are copied */
+    FixBuilder callerOwned(_buffer, sizeof(_buffer));
+    callerOwned.set<FixTag::MsgType>(FixMsgType::ExecutionReport).set<FixTag::Side>(FixSide::Buy).set<FixTag::Price>(FixPrice::fromDouble(100.0));
+    EXPECT_EQ(callerOwned.release(), message);
+}
+
+
+TEST_F(FixBuilderTest, CheckOverflow)
+{
+    FixBuilder builder(_buffer, 32);
+    EXPECT_THROW(builder.append(FixTag::AdminResponse, "too long for this buffer"), std::length_error);
+}
+
+} // namespace Fix
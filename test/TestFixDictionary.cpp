@@ -0,0 +1,76 @@
+/**
+ * @file TestFixDictionary.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <fix/FixDictionary.hpp>
+#include <fix/FixMessage.hpp>
+#include <fix/FixMessageView.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace Fix
+{
+
+TEST(FixDictionaryTest, CheckMsgType)
+{
+    static_assert(FixCodec::parseMsgType("D") == FixMsgType::NewOrderSingle);
+    static_assert(FixCodec::parseMsgType("QR") == FixMsgType::AdminRequest);
+    static_assert(FixCodec::parseMsgType("") == FixMsgType::Unknown);
+
+    char buffer[FixCodec::MaxEncodedLength];
+    EXPECT_EQ(FixCodec::formatMsgType(FixMsgType::AdminRequest, buffer), "QR");
+    EXPECT_EQ(FixCodec::formatMsgType(FixMsgType::ExecutionReport, buffer), "8");
+}
+
+
+TEST(FixDictionaryTest, CheckPrice)
+{
+    EXPECT_EQ(FixCodec::parsePrice("100.00").mantissa, 100 * FixPrice::Scale);
+    EXPECT_EQ(FixCodec::parsePrice("0.5").mantissa, FixPrice::Scale / 2);
+    EXPECT_EQ(FixCodec::parsePrice("-1.25"), FixPrice::fromDouble(-1.25));
+    EXPECT_EQ(FixCodec::parsePrice("12"), FixPrice::fromDouble(12));
+    EXPECT_EQ(FixCodec::parsePrice("1.2x"), FixPrice{});
+
+    /* Largest whole price is (2^63 - 1) / 10^8 */
+    EXPECT_EQ(FixCodec::parsePrice("92233720368").mantissa, INT64_C(92233720368) * FixPrice::Scale);
+    EXPECT_EQ(FixCodec::parsePrice("92233720369"), FixPrice{});
+    EXPECT_EQ(FixCodec::parsePrice("-99999999999999999999.5"), FixPrice{});
+
+    char buffer[FixCodec::MaxEncodedLength];
+    EXPECT_EQ(FixCodec::formatPrice(FixPrice::fromDouble(100), buffer), "100.00");
+    EXPECT_EQ(FixCodec::formatPrice(FixPrice::fromDouble(99.125), buffer), "99.125");
+    EXPECT_EQ(FixCodec::formatPrice(FixPrice::fromDouble(-0.5), buffer), "-0.50");
+}
+
+
+TEST(FixDictionaryTest, CheckTypedAccessors)
+{
+    FixMessage message;
+    message.set<FixTag::MsgType>(FixMsgType::ExecutionReport);
+    message.set<FixTag::OrdStatus>(FixOrdStatus::PartiallyFilled);
+    message.set<FixTag::OrderQty>(250);
+    message.set<FixTag::Price>(FixPrice::fromDouble(101.5));
+    message.set<FixTag::ClOrdID>("abc");
+
+    EXPECT_EQ(message.getValue(FixTag::MsgType), "8");
+    EXPECT_EQ(message.getValue(FixTag::OrdStatus), "1");
+    EXPECT_EQ(message.getValue(FixTag::Price), "101.50");
+
+    std::string raw = message.toString();
+    FixMessageView view(raw);
+
+    EXPECT_EQ(view.get<FixTag::MsgType>(), FixMsgType::ExecutionReport);
+    EXPECT_EQ(view.get<FixTag::OrdStatus>(), FixOrdStatus::PartiallyFilled);
+    EXPECT_EQ(view.get<FixTag::OrderQty>(), 250);
+    EXPECT_EQ(view.get<FixTag::Price>(), FixPrice::fromDouble(101.5));
+    EXPECT_EQ(view.get<FixTag::ClOrdID>(), "abc");
+    EXPECT_EQ(view.get<FixTag::Side>(), FixSide::Unknown);
+}
+
+
+} // namespace Fix
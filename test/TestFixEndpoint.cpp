@@ -0,0 +1,209 @@
+/**
+ * @file TestFixEndpoint.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fix/FixBuilder.hpp>
+#include <fix/FixFrameDecoder.hpp>
+#include <fix/FixMessageView.hpp>
+#include <fix/FixTag.hpp>
+#include <gtest/gtest.h>
+#include <logger/Logger.hpp>
+#include <netinet/in.h>
+#include <socket/FixEndpoint.hpp>
+#include <socket/Server.hpp>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace Socket
+{
+
+class FixEndpointTest : public testing::Test
+{
+protected:
+    /* Sequenced server recording the session of the last application message */
+    class SequencedServer : public FixEndpoint<Server>
+    {
+    public:
+        using FixEndpoint<Server>::FixEndpoint;
+
+        void send(FixMessage message, SocketFD socket) { sendFixMessage(std::move(message), socket); }
+
+        std::atomic<int> nHandled{0};
+        std::atomic<SocketFD> lastSocket{-1};
+
+    protected:
+        void handleFixMessage(const FixMessageView &, SocketFD socket) override
+        {
+            lastSocket = socket;
+            ++nHandled;
+        }
+    };
+
+    void SetUp() override
+    {
+        Logger::instance().setLevel(Logger::Critical);
+        std::filesystem::remove_all(journalDirectory);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(journalDirectory); }
+
+    static int connectTo(int port)
+    {
+        int client = socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (connect(client, (const struct sockaddr *)&address, sizeof(address)) != 0)
+        {
+            close(client);
+            return (-1);
+        }
+
+        timeval timeout{2, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        return client;
+    }
+
+    static void sendFix(int client, FixBuilder &builder)
+    {
+        std::string_view encoded = builder.finish();
+        ASSERT_EQ(send(client, encoded.data(), encoded.size(), 0), static_cast<ssize_t>(encoded.size()));
+    }
+
+    /* Next n frames from the server (fewer on timeout) */
+    std::vector<std::string> receiveFrames(int client, std::size_t n)
+    {
+        std::vector<std::string> frames;
+        char buffer[4096];
+
+        while (frames.size() < n)
+        {
+            auto result = FixFrameDecoder::decode(pending);
+
+            if (result.status == FixFrameDecoder::Complete)
+            {
+                frames.push_back(pending.substr(0, result.length));
+                pending.erase(0, result.length);
+                continue;
+            }
+
+            long nBytes = recv(client, buffer, sizeof(buffer), 0);
+            if (nBytes <= 0)
+                break;
+
+            pending.append(buffer, static_cast<std::size_t>(nBytes));
+        }
+
+        return frames;
+    }
+
+    static std::string valueOf(const std::string &frame, int tag) { return std::string(FixMessageView::findValue(frame, tag)); }
+
+    const std::string journalDirectory{"/tmp/talos-test-journal-" + std::to_string(getpid())};
+    std::string pending; /* Received bytes not yet framed */
+};
+
+
+TEST_F(FixEndpointTest, CheckGapRequestsResendAndReplays)
+{
+    SequencedServer server(SocketAddress(26550));
+    server.enableSequencing(journalDirectory, "SERVER");
+    server.start();
+
+    int client = connectTo(26550);
+    ASSERT_NE(client, (-1));
+
+    /* Logon names the session: the server replies with its own Logon (its MsgSeqNo 1) */
+    FixBuilder logon(256);
+    logon.set<FixTag::MsgType>(FixMsgType::Logon).set<FixTag::MsgSeqNo>(1).append(FixTag::SenderCompID, "PEER");
+    sendFix(client, logon);
+
+    auto frames = receiveFrames(client, 1);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(valueOf(frames[0], FixTag::MsgType), "A");
+    EXPECT_EQ(valueOf(frames[0], FixTag::MsgSeqNo), "1");
+
+    FixBuilder order(256);
+    order.set<FixTag::MsgType>(FixMsgType::NewOrderSingle).set<FixTag::MsgSeqNo>(2).append(FixTag::ClOrdID, "order-1");
+    sendFix(client, order);
+
+    for (int i = 0; i < 200 && server.nHandled < 1; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(server.nHandled, 1);
+
+    /* Server's MsgSeqNo 2 and 3 */
+    for (const char *clOrdID : {"order-1", "order-2"})
+    {
+        FixMessage report;
+        report.set<FixTag::MsgType>(FixMsgType::ExecutionReport);
+        report.setTag(FixTag::ClOrdID, clOrdID);
+        server.send(std::move(report), server.lastSocket);
+    }
+
+    frames = receiveFrames(client, 2);
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(valueOf(frames[1], FixTag::MsgSeqNo), "3");
+
+    /* Skip our MsgSeqNo 3: the order is held back and a resend of 3 onwards requested */
+    FixBuilder ahead(256);
+    ahead.set<FixTag::MsgType>(FixMsgType::NewOrderSingle).set<FixTag::MsgSeqNo>(4).append(FixTag::ClOrdID, "order-3");
+    sendFix(client, ahead);
+
+    frames = receiveFrames(client, 1);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(valueOf(frames[0], FixTag::MsgType), "2");
+    EXPECT_EQ(valueOf(frames[0], FixTag::BeginSeqNo), "3");
+    EXPECT_EQ(valueOf(frames[0], FixTag::EndSeqNo), "0");
+    EXPECT_EQ(valueOf(frames[0], FixTag::MsgSeqNo), "4");
+    EXPECT_EQ(server.nHandled, 1);
+
+    /* Ask for everything: session-level messages (Logon 1, ResendRequest 4) become gap fills */
+    FixBuilder resend(256);
+    resend.set<FixTag::MsgType>(FixMsgType::ResendRequest).set<FixTag::MsgSeqNo>(3).set<FixTag::BeginSeqNo>(1).set<FixTag::EndSeqNo>(0);
+    sendFix(client, resend);
+
+    frames = receiveFrames(client, 4);
+    ASSERT_EQ(frames.size(), 4u);
+
+    EXPECT_EQ(valueOf(frames[0], FixTag::MsgType), "4");
+    EXPECT_EQ(valueOf(frames[0], FixTag::MsgSeqNo), "1");
+    EXPECT_EQ(valueOf(frames[0], FixTag::GapFillFlag), "Y");
+    EXPECT_EQ(valueOf(frames[0], FixTag::NewSeqNo), "2");
+
+    for (std::size_t i : {1u, 2u})
+    {
+        EXPECT_EQ(valueOf(frames[i], FixTag::MsgType), "8");
+        EXPECT_EQ(valueOf(frames[i], FixTag::MsgSeqNo), std::to_string(i + 1));
+        EXPECT_EQ(valueOf(frames[i], FixTag::PossDupFlag), "Y");
+        EXPECT_FALSE(valueOf(frames[i], FixTag::OrigSendingTime).empty());
+    }
+
+    EXPECT_EQ(valueOf(frames[3], FixTag::MsgType), "4");
+    EXPECT_EQ(valueOf(frames[3], FixTag::MsgSeqNo), "4");
+    EXPECT_EQ(valueOf(frames[3], FixTag::NewSeqNo), "5");
+
+    close(client);
+
+    server.stop();
+    server.wait();
+}
+
+} // namespace Socket
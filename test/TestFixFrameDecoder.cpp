@@ -0,0 +1,149 @@
+/**
+ * @file TestFixFrameDecoder.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <fix/FixFrameDecoder.hpp>
+#include <gtest/gtest.h>
+#include <socket/ReceiveBuffer.hpp>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Fix
+{
+
+class FixFrameDecoderTest : public testing::Test
+{
+protected:
+    /* Feed bytes into buffer in chunks of chunkSize and collect decoded frames */
+    std::vector<std::string> decodeInChunks(const std::string &stream, std::size_t chunkSize)
+    {
+        ReceiveBuffer buffer(16);
+        std::vector<std::string> frames;
+
+        for (std::size_t i = 0; i < stream.size(); i += chunkSize)
+        {
+            std::size_t n = std::min(chunkSize, stream.size() - i);
+
+            buffer.reserve(n);
+            std::memcpy(buffer.writePtr(), stream.data() + i, n);
+            buffer.commit(n);
+
+            while (true)
+            {
+                auto [status, length] = FixFrameDecoder::decode(buffer.readable());
+                if (status == FixFrameDecoder::Incomplete)
+                    break;
+                if (status == FixFrameDecoder::Complete)
+                    frames.emplace_back(buffer.readable().substr(0, length));
+                buffer.consume(length);
+            }
+        }
+
+        return frames;
+    }
+
+    /* Frame a body with a valid BodyLength and CheckSum */
+    std::string frame(const std::string &body)
+    {
+        std::string message = "8=FIX.4.4;9=" + std::to_string(body.size()) + ";" + body;
+
+        unsigned int count = 0;
+        for (char c : message)
+            count += static_cast<unsigned char>(c);
+
+        std::ostringstream os;
+        os << message << "10=" << std::setw(3) << std::setfill('0') << (count % 256) << ";";
+        return os.str();
+    }
+
+    std::string _first{"8=FIX.4.4;9=20;35=8;54=1;44=100.00;10=151;"};
+    std::string _second{"8=FIX.4.4;9=10;35=D;11=a;10=204;"};
+};
+
+
+TEST_F(FixFrameDecoderTest, CheckSingleFrame)
+{
+    auto [status, length] = FixFrameDecoder::decode(_first);
+
+    EXPECT_EQ(status, FixFrameDecoder::Complete);
+    EXPECT_EQ(length, _first.size());
+}
+
+
+TEST_F(FixFrameDecoderTest, CheckIncomplete)
+{
+    for (std::size_t n = 0; n < _first.size(); ++n)
+    {
+        EXPECT_EQ(FixFrameDecoder::decode(std::string_view(_first).substr(0, n)).status, FixFrameDecoder::Incomplete);
+    }
+}
+
+
+TEST_F(FixFrameDecoderTest, CheckMergedAndSplitReads)
+{
+    std::string stream = _first + _second + _first;
+
+    for (std::size_t chunkSize : {1, 7, 33, 1000})
+    {
+        auto frames = decodeInChunks(stream, chunkSize);
+
+        ASSERT_EQ(frames.size(), 3);
+        EXPECT_EQ(frames[0], _first);
+        EXPECT_EQ(frames[1], _second);
+        EXPECT_EQ(frames[2], _first);
+    }
+}
+
+
+TEST_F(FixFrameDecoderTest, CheckResyncAfterGarbage)
+{
+    auto frames = decodeInChunks("garbage" + _first + "8=FIX.4.4;9=x;" + _second, 5);
+
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames[0], _first);
+    EXPECT_EQ(frames[1], _second);
+}
+
+
+TEST_F(FixFrameDecoderTest, CheckLargeFrame)
+{
+    std::string large = frame("35=D;58=" + std::string(5000, 'x') + ";");
+
+    auto frames = decodeInChunks(large + _second, 2047);
+
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames[0], large);
+}
+
+
+TEST_F(FixFrameDecoderTest, CheckInvalidCheckSum)
+{
+    std::string bad{"8=FIX.4.4;9=20;35=8;54=1;44=100.00;10=152;"};
+
+    auto [status, length] = FixFrameDecoder::decode(bad);
+    EXPECT_EQ(status, FixFrameDecoder::Invalid);
+    EXPECT_EQ(length, bad.size());
+
+    auto frames = decodeInChunks(bad + _second, 9);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames[0], _second);
+}
+
+
+TEST_F(FixFrameDecoderTest, CheckBodyLengthMismatch)
+{
+    std::string bad{"8=FIX.4.4;9=19;35=8;54=1;44=100.00;10=151;"};
+
+    EXPECT_EQ(FixFrameDecoder::decode(bad).status, FixFrameDecoder::Corrupt);
+}
+
+
+} // namespace Fix
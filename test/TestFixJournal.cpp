@@ -0,0 +1,88 @@
+/**
+ * @file TestFixJournal.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cstdio>
+#include <fix/FixJournal.hpp>
+#include <gtest/gtest.h>
+#include <logger/Logger.hpp>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace Fix
+{
+
+class FixJournalTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Logger::instance().setLevel(Logger::Warn);
+
+        _path = testing::TempDir() + "talos-journal-" + std::to_string(getpid()) + ".journal";
+        std::remove(_path.c_str());
+    }
+
+    void TearDown() override { std::remove(_path.c_str()); }
+
+    std::string _path;
+};
+
+
+TEST_F(FixJournalTest, CheckRecoverAfterReopen)
+{
+    {
+        FixJournal journal(_path);
+        EXPECT_EQ(journal.nextOutgoingSeqNo(), 1u);
+
+        EXPECT_TRUE(journal.append("8=FIX.4.4;35=D;34=1;"));
+        EXPECT_TRUE(journal.append("8=FIX.4.4;35=8;34=2;"));
+        journal.setExpectedIncomingSeqNo(7);
+    }
+
+    FixJournal journal(_path);
+
+    EXPECT_EQ(journal.nextOutgoingSeqNo(), 3u);
+    EXPECT_EQ(journal.expectedIncomingSeqNo(), 7u);
+    EXPECT_EQ(journal.find(1), "8=FIX.4.4;35=D;34=1;");
+    EXPECT_EQ(journal.find(2), "8=FIX.4.4;35=8;34=2;");
+    EXPECT_TRUE(journal.find(3).empty());
+
+    EXPECT_TRUE(journal.append("8=FIX.4.4;35=8;34=3;"));
+    EXPECT_EQ(journal.find(3), "8=FIX.4.4;35=8;34=3;");
+    EXPECT_EQ(journal.stats().records, 3u);
+}
+
+
+TEST_F(FixJournalTest, CheckFullJournalKeepsNumbering)
+{
+    FixJournal journal(_path, 8192); /* One page of records */
+
+    std::string message(3000, 'x');
+
+    EXPECT_TRUE(journal.append(message));
+    EXPECT_FALSE(journal.append(message)); /* Does not fit */
+    EXPECT_EQ(journal.nextOutgoingSeqNo(), 3u);
+
+    EXPECT_EQ(journal.find(1), message);
+    EXPECT_TRUE(journal.find(2).empty()); /* Cannot be resent */
+}
+
+
+TEST_F(FixJournalTest, CheckRejectsOtherFiles)
+{
+    FILE *file = std::fopen(_path.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    std::fputs("not a journal", file);
+    std::fclose(file);
+
+    EXPECT_THROW(FixJournal journal(_path), std::runtime_error);
+}
+
+} // namespace Fix
@@ -0,0 +1,99 @@
+/**
+ * @file TestFixKernels.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <fix/FixKernels.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+namespace Fix
+{
+
+class FixKernelsTest : public testing::TestWithParam<FixKernels::Isa>
+{
+protected:
+    void SetUp() override
+    {
+        _defaultIsa = FixKernels::isa();
+
+        if (!FixKernels::setIsa(GetParam()))
+        {
+            GTEST_SKIP() << "Instruction set not supported";
+        }
+
+        std::mt19937 generator{42};
+        std::uniform_int_distribution<> distribution{0, 255};
+
+        _buffer.resize(300);
+        for (char &c : _buffer)
+        {
+            c = static_cast<char>(distribution(generator));
+            if (c == ';')
+                c = 'x';
+        }
+    }
+
+    void TearDown() override
+    {
+        FixKernels::setIsa(_defaultIsa);
+    }
+
+    FixKernels::Isa _defaultIsa{FixKernels::Scalar};
+    std::string _buffer;
+};
+
+
+TEST_P(FixKernelsTest, CheckFind)
+{
+    const char *begin = _buffer.data();
+    const char *end = begin + _buffer.size();
+
+    EXPECT_EQ(FixKernels::find(begin, end, ';'), end);
+
+    /* Every position and every alignment of the start */
+    for (std::size_t iStart = 0; iStart < 40; ++iStart)
+    {
+        for (std::size_t iDelimiter = iStart; iDelimiter < _buffer.size(); ++iDelimiter)
+        {
+            _buffer[iDelimiter] = ';';
+            EXPECT_EQ(FixKernels::find(begin + iStart, end, ';'), begin + iDelimiter);
+            _buffer[iDelimiter] = 'x';
+        }
+    }
+}
+
+
+TEST_P(FixKernelsTest, CheckSum)
+{
+    for (std::size_t iStart = 0; iStart < 40; ++iStart)
+    {
+        for (std::size_t iEnd = iStart; iEnd <= _buffer.size(); ++iEnd)
+        {
+            uint32_t expected = 0;
+            for (std::size_t i = iStart; i < iEnd; ++i)
+                expected += static_cast<unsigned char>(_buffer[i]);
+
+            EXPECT_EQ(FixKernels::sum(_buffer.data() + iStart, _buffer.data() + iEnd), expected);
+        }
+    }
+}
+
+
+TEST_P(FixKernelsTest, CheckChecksum)
+{
+    std::string message{"8=FIX.4.4;9=20;35=8;54=1;44=100.00;"};
+
+    EXPECT_EQ(FixKernels::checksum(message.data(), message.data() + message.size()), 151);
+}
+
+
+INSTANTIATE_TEST_SUITE_P(AllIsas, FixKernelsTest, testing::Values(FixKernels::Scalar, FixKernels::SSE42, FixKernels::AVX2));
+
+
+} // namespace Fix
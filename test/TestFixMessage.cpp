@@ -8,6 +8,7 @@
  */
 
 #include <fix/FixMessage.hpp>
+#include <fix/FixMessageView.hpp>
 #include <fix/FixTag.hpp>
 #include <gtest/gtest.h>
 #include <iostream>
@@ -61,11 +62,29 @@ TEST_F(FixMessageTest, CheckToString)
 {
     std::string fix = _message.toString();
 
-    std::string expectedFix{"8=FIX.4.4;9=20;44=100.00;54=1;35=8;10=151;"};
+    std::string expectedFix{"8=FIX.4.4;9=20;35=8;54=1;44=100.00;10=151;"};
     EXPECT_EQ(fix, expectedFix);
 }
 
 
+TEST_F(FixMessageTest, CheckPatchInPlace)
+{
+    _message.setTag(FixTag::Price, "99.5");
+    EXPECT_EQ(_message.toString(), "8=FIX.4.4;9=18;35=8;54=1;44=99.5;10=084;");
+
+    _message.setTag(FixTag::SendingTime, "20250101-00:00:00.000");
+    _message.eraseTag(FixTag::Side);
+
+    FixMessage expected;
+    expected.setTag(35, "8");
+    expected.setTag(FixTag::Price, "99.5");
+    expected.setTag(FixTag::SendingTime, "20250101-00:00:00.000");
+
+    EXPECT_EQ(_message.toString(), expected.toString());
+    EXPECT_EQ(FixMessage(_message.toString()).toString(), expected.toString());
+}
+
+
 TEST_F(FixMessageTest, CheckFromString)
 {
     FixMessage newMessage(_message.toString());
@@ -73,6 +92,21 @@ TEST_F(FixMessageTest, CheckFromString)
     EXPECT_EQ(newMessage.getValue(35), "8");
     EXPECT_EQ(newMessage.getValue(FixTag::Side), "1");
     EXPECT_EQ(newMessage.getValue(FixTag::Price), "100.00");
+    EXPECT_EQ(newMessage.toString(), _message.toString());
+}
+
+
+TEST_F(FixMessageTest, CheckFromStringWithMalformedCheckSum)
+{
+    const std::string expected = _message.toString();
+
+    /* Short CheckSum inside a larger buffer: must not read past the message */
+    std::string buffer = "8=FIX.4.4;9=20;35=8;54=1;44=100.00;10=1;XX";
+    FixMessage shortCheckSum{FixMessageView(std::string_view(buffer).substr(0, buffer.size() - 2))};
+    EXPECT_EQ(shortCheckSum.toString(), expected);
+
+    FixMessage longCheckSum("8=FIX.4.4;9=20;35=8;54=1;44=100.00;10=1510;");
+    EXPECT_EQ(longCheckSum.toString(), expected);
 }
 
 
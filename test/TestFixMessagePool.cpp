@@ -0,0 +1,115 @@
+/**
+ * @file TestFixMessagePool.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <fix/FixMessage.hpp>
+#include <fix/FixMessagePool.hpp>
+#include <fix/FixTag.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+
+namespace Fix
+{
+
+class FixMessagePoolTest : public testing::Test
+{
+protected:
+    static FixMessage buildOrder()
+    {
+        FixMessage order;
+        order.set<FixTag::MsgType>(FixMsgType::NewOrderSingle);
+        order.setTag(FixTag::ClOrdID, "yhsbzifzjntuzmi");
+        order.set<FixTag::Price>(FixPrice::fromDouble(100.0));
+        return order;
+    }
+};
+
+
+TEST_F(FixMessagePoolTest, CheckSteadyStateRecycles)
+{
+    FixMessagePool &pool = FixMessagePool::local();
+
+    /* Warm-up */
+    for (int i = 0; i < 16; ++i)
+    {
+        FixMessage copy(buildOrder());
+    }
+
+    auto warm = pool.stats();
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        FixMessage order = buildOrder();
+        FixMessage copy(order);
+        copy.set<FixTag::MsgType>(FixMsgType::ExecutionReport);
+    }
+
+    auto after = pool.stats();
+
+    EXPECT_GT(after.allocations, warm.allocations);
+    EXPECT_EQ(after.upstreamAllocations, warm.upstreamAllocations); /* No new heap chunks */
+    EXPECT_EQ(after.bytesInUse, warm.bytesInUse);
+    EXPECT_TRUE(after.threadAttached);
+}
+
+
+TEST_F(FixMessagePoolTest, CheckThreadPoolsReused)
+{
+    FixMessagePool *first = nullptr;
+    FixMessagePool *second = nullptr;
+
+    std::thread([&first]() { first = &FixMessagePool::local(); }).join();
+    std::thread([&second]() { second = &FixMessagePool::local(); }).join();
+
+    EXPECT_NE(first, &FixMessagePool::local());
+    EXPECT_EQ(first, second); /* Released on thread exit and recycled */
+}
+
+TEST_F(FixMessagePoolTest, CheckFreeOnOtherThreadReturnsToOwner)
+{
+    FixMessagePool &pool = FixMessagePool::local();
+
+    auto before = pool.stats();
+
+    auto order = std::make_unique<FixMessage>(buildOrder());
+    EXPECT_GT(pool.stats().bytesInUse, before.bytesInUse);
+
+    std::thread([&order]() { order.reset(); }).join();
+
+    /* Returned blocks are released on the owner's next allocation */
+    {
+        FixMessage next = buildOrder();
+    }
+
+    EXPECT_EQ(pool.stats().bytesInUse, before.bytesInUse);
+}
+
+TEST_F(FixMessagePoolTest, CheckModifyOnOtherThreadUsesHeap)
+{
+    FixMessagePool &pool = FixMessagePool::local();
+
+    auto before = pool.stats();
+    auto order = std::make_unique<FixMessage>(buildOrder());
+    const std::string clOrdID(200, 'x'); /* Past the small-string buffer */
+
+    std::thread([&order, &clOrdID]() { order->setTag(FixTag::ClOrdID, clOrdID); }).join();
+
+    EXPECT_GT(pool.stats().offThreadAllocations, before.offThreadAllocations);
+    EXPECT_EQ(order->getValue(FixTag::ClOrdID), clOrdID);
+
+    order.reset(); /* Frees pooled and heap blocks alike */
+
+    {
+        FixMessage next = buildOrder();
+    }
+
+    EXPECT_EQ(pool.stats().bytesInUse, before.bytesInUse);
+}
+
+} // namespace Fix
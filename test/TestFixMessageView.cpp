@@ -0,0 +1,124 @@
+/**
+ * @file TestFixMessageView.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <fix/FixMessage.hpp>
+#include <fix/FixMessageView.hpp>
+#include <fix/FixTag.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+namespace Fix
+{
+
+class FixMessageViewTest : public testing::Test
+{
+protected:
+    std::string _raw{"8=FIX.4.4;9=20;35=8;54=1;44=100.00;10=151;"};
+};
+
+
+TEST_F(FixMessageViewTest, CheckGetValue)
+{
+    FixMessageView view(_raw);
+
+    EXPECT_EQ(view.size(), 6);
+    EXPECT_EQ(view.getValue(FixTag::MsgType), "8");
+    EXPECT_EQ(view.getValue(FixTag::Side), "1");
+    EXPECT_EQ(view.getValue(FixTag::Price), "100.00");
+    EXPECT_EQ(view.getValue(10), "151");
+
+    EXPECT_FALSE(view.hasTag(FixTag::TransactTime));
+    EXPECT_EQ(view.getValue(FixTag::TransactTime), "");
+}
+
+
+TEST_F(FixMessageViewTest, CheckReferencesBuffer)
+{
+    FixMessageView view(_raw);
+
+    auto price = view.getValue(FixTag::Price);
+    EXPECT_GE(price.data(), _raw.data());
+    EXPECT_LT(price.data(), _raw.data() + _raw.size());
+}
+
+
+TEST_F(FixMessageViewTest, CheckIgnoresIncompleteField)
+{
+    FixMessageView view("35=D;11=abc;44=10");
+
+    EXPECT_EQ(view.size(), 2);
+    EXPECT_EQ(view.getValue(FixTag::ClOrdID), "abc");
+    EXPECT_FALSE(view.hasTag(FixTag::Price));
+}
+
+
+TEST_F(FixMessageViewTest, CheckMalformed)
+{
+    EXPECT_THROW(FixMessageView("35=D;54;"), std::runtime_error);
+    EXPECT_THROW(FixMessageView("35=D;5x4=1;"), std::runtime_error);
+    EXPECT_THROW(FixMessageView("35=D;=1;"), std::runtime_error);
+}
+
+
+TEST_F(FixMessageViewTest, CheckFindValue)
+{
+    EXPECT_EQ(FixMessageView::findValue(_raw, FixTag::Price), "100.00");
+    EXPECT_EQ(FixMessageView::findValue(_raw, FixTag::MsgType), "8");
+    EXPECT_TRUE(FixMessageView::findValue(_raw, FixTag::OrigClOrdID).empty());
+    EXPECT_TRUE(FixMessageView::findValue("35=D;5x4=1;44=1;", FixTag::Price).empty()); /* Stops at malformed field */
+}
+
+
+TEST_F(FixMessageViewTest, CheckManyFields)
+{
+    std::string raw = "35=D;";
+    for (int tag = 1000; tag < 1100; ++tag) /* Beyond the inline index */
+    {
+        raw += std::to_string(tag) + "=" + std::to_string(tag * 2) + ";";
+    }
+
+    FixMessageView view(raw);
+
+    EXPECT_EQ(view.size(), 101u);
+    EXPECT_EQ(view.getValue(FixTag::MsgType), "D");
+    EXPECT_EQ(view.getValue(1063), "2126");
+    EXPECT_EQ(view.getValue(1099), "2198");
+    EXPECT_EQ(view.tagAt(100), 1099);
+    EXPECT_EQ(view.valueAt(100), "2198");
+
+    FixMessage message(view);
+    EXPECT_EQ(message.getValue(1099), "2198");
+}
+
+
+TEST_F(FixMessageViewTest, CheckRepeatedTagReadsLast)
+{
+    std::string raw = "35=D;44=1.00;54=1;44=2.00;";
+    FixMessageView view(raw);
+
+    EXPECT_EQ(view.size(), 4u);
+    EXPECT_EQ(view.getValue(FixTag::Price), "2.00");
+    EXPECT_EQ(FixMessageView::findValue(raw, FixTag::Price), "2.00");
+    EXPECT_EQ(FixMessage(view).getValue(FixTag::Price), "2.00");
+}
+
+
+TEST_F(FixMessageViewTest, CheckToFixMessage)
+{
+    FixMessage message{FixMessageView(_raw)};
+
+    EXPECT_EQ(message.getValue(FixTag::MsgType), "8");
+    EXPECT_EQ(message.getValue(FixTag::Price), "100.00");
+    EXPECT_FALSE(message.hasTag(10));
+    EXPECT_EQ(message.toString(), _raw);
+}
+
+
+} // namespace Fix
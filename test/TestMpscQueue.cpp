@@ -0,0 +1,100 @@
+/**
+ * @file TestMpscQueue.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <utilities/Doorbell.hpp>
+#include <utilities/MpscQueue.hpp>
+#include <utility>
+#include <vector>
+
+namespace Fix
+{
+
+class MpscQueueTest : public testing::Test
+{
+protected:
+    using Item = std::pair<int, int>; /* Producer, sequence */
+};
+
+
+TEST_F(MpscQueueTest, CheckTryPushFailsWhenFull)
+{
+    MpscQueue<int> queue(4);
+    ASSERT_EQ(queue.capacity(), 4);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.tryPush(int(i)));
+    }
+
+    EXPECT_FALSE(queue.tryPush(4));
+
+    std::vector<int> out;
+    EXPECT_EQ(queue.popBatch(out, 2), 2);
+    EXPECT_EQ(out, (std::vector<int>{0, 1}));
+
+    EXPECT_TRUE(queue.tryPush(4)); /* Freed slots reused on the next lap */
+    EXPECT_EQ(queue.popBatch(out, 16), 3);
+    EXPECT_EQ(out, (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_TRUE(queue.empty());
+}
+
+
+TEST_F(MpscQueueTest, CheckProducerOrderPreserved)
+{
+    constexpr int nProducers = 4;
+    constexpr int nItems = 20000;
+
+    MpscQueue<Item> queue(64); /* Small => producers regularly find it full */
+    Doorbell doorbell(Doorbell::WaitStrategy::SpinThenPark);
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < nProducers; ++producer)
+    {
+        producers.emplace_back([&, producer]()
+        {
+            for (int i = 0; i < nItems; ++i)
+            {
+                while (!queue.tryPush(Item(producer, i)))
+                {
+                    doorbell.ring();
+                    std::this_thread::yield();
+                }
+
+                doorbell.ring();
+            }
+        });
+    }
+
+    std::vector<int> next(nProducers, 0);
+    std::vector<Item> batch;
+
+    for (int received = 0; received < nProducers * nItems;)
+    {
+        doorbell.wait([&queue]() { return !queue.empty(); });
+
+        received += queue.popBatch(batch, 32);
+        for (auto [producer, sequence] : batch)
+        {
+            ASSERT_EQ(sequence, next[producer]++);
+        }
+
+        batch.clear();
+    }
+
+    for (auto &thread : producers)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(next, std::vector<int>(nProducers, nItems));
+}
+
+} // namespace Fix
@@ -0,0 +1,65 @@
+/**
+ * @file TestMsgTypeDispatchTable.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <fix/FixDictionary.hpp>
+#include <gtest/gtest.h>
+#include <socket/MsgTypeDispatchTable.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace Fix
+{
+
+class MsgTypeDispatchTableTest : public testing::Test
+{
+protected:
+    MsgTypeDispatchTable<int> _table;
+};
+
+
+TEST_F(MsgTypeDispatchTableTest, CheckAddAndFind)
+{
+    _table.add(FixMsgType::NewOrderSingle, 1);
+    _table.add(FixMsgType::AdminRequest, 2); /* Two-character MsgType */
+
+    ASSERT_NE(_table.find(FixMsgType::NewOrderSingle), nullptr);
+    EXPECT_EQ(*_table.find(FixMsgType::NewOrderSingle), 1);
+
+    ASSERT_NE(_table.find(FixMsgType::AdminRequest), nullptr);
+    EXPECT_EQ(*_table.find(FixMsgType::AdminRequest), 2);
+
+    EXPECT_EQ(_table.msgTypes(), (std::vector<FixMsgType>{FixMsgType::NewOrderSingle, FixMsgType::AdminRequest}));
+}
+
+
+TEST_F(MsgTypeDispatchTableTest, CheckReplaceKeepsSlot)
+{
+    _table.add(FixMsgType::ExecutionReport, 1);
+    _table.add(FixMsgType::ExecutionReport, 7);
+
+    ASSERT_NE(_table.find(FixMsgType::ExecutionReport), nullptr);
+    EXPECT_EQ(*_table.find(FixMsgType::ExecutionReport), 7);
+    EXPECT_EQ(_table.msgTypes().size(), 1u);
+}
+
+
+TEST_F(MsgTypeDispatchTableTest, CheckUnregisteredAndInvalidLookups)
+{
+    _table.add(FixMsgType::NewOrderSingle, 1);
+
+    EXPECT_EQ(_table.find(FixMsgType::ExecutionReport), nullptr);
+    EXPECT_EQ(_table.find(FixMsgType::Unknown), nullptr);
+    EXPECT_EQ(_table.find(static_cast<FixMsgType>('!')), nullptr);             /* Not [0-9A-Za-z] */
+    EXPECT_EQ(_table.find(static_cast<FixMsgType>(('D' << 8) | '~')), nullptr); /* Invalid second character */
+
+    EXPECT_THROW(_table.add(FixMsgType::Unknown, 2), std::invalid_argument);
+    EXPECT_THROW(_table.add(static_cast<FixMsgType>('!'), 2), std::invalid_argument);
+}
+
+} // namespace Fix
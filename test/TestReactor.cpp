@@ -0,0 +1,193 @@
+/**
+ * @file TestReactor.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fix/FixBuilder.hpp>
+#include <fix/FixTag.hpp>
+#include <gtest/gtest.h>
+#include <logger/Logger.hpp>
+#include <netinet/in.h>
+#include <socket/Server.hpp>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace Socket
+{
+
+/* Event-loop sessions on each backend (io_uring falls back to epoll where unsupported) */
+class ReactorTest : public testing::TestWithParam<ConnectionManager::ReactorBackend>
+{
+protected:
+    /* Sends every message straight back to the sender */
+    class EchoServer : public Server
+    {
+    public:
+        using Server::Server;
+
+    protected:
+        void handleMessage(Message message, SocketFD fromSocket) override { sendMessage(std::move(message), fromSocket); }
+    };
+
+    void SetUp() override
+    {
+        Logger::instance().setLevel(Logger::Warn);
+
+        FixBuilder builder(256);
+        builder.set<FixTag::MsgType>(FixMsgType::NewOrderSingle);
+        builder.append(FixTag::ClOrdID, "yhsbzifzjntuzmi");
+        builder.set<FixTag::Price>(FixPrice::fromDouble(100.0));
+        message = builder.finish();
+    }
+
+    /* Distinct port per test and backend */
+    static ConnectionManager::Port port(int test) { return static_cast<ConnectionManager::Port>(26570 + 2 * test + static_cast<int>(GetParam())); }
+
+    static int connectTo(ConnectionManager::Port port)
+    {
+        int client = socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (connect(client, (const struct sockaddr *)&address, sizeof(address)) != 0)
+        {
+            close(client);
+            return (-1);
+        }
+
+        timeval timeout{2, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        return client;
+    }
+
+    /* Send message n times and read back as many bytes. Returns the bytes echoed */
+    std::string echo(int client, int n) const
+    {
+        std::string expected;
+        for (int i = 0; i < n; ++i)
+        {
+            expected += message;
+        }
+
+        if (send(client, expected.data(), expected.size(), 0) != static_cast<long>(expected.size()))
+            return {};
+
+        std::string received;
+        char buffer[4096];
+
+        while (received.size() < expected.size())
+        {
+            long nBytes = recv(client, buffer, sizeof(buffer), 0);
+            if (nBytes <= 0)
+                break;
+
+            received.append(buffer, static_cast<std::size_t>(nBytes));
+        }
+
+        return received;
+    }
+
+    static void waitForSessions(Server &server, std::size_t n)
+    {
+        for (int i = 0; i < 200 && server.outgoingQueueStats().size() != n; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    std::string message;
+};
+
+
+TEST_P(ReactorTest, CheckEcho)
+{
+    EchoServer server(port(0));
+    server.setReactorThreads(1, GetParam());
+    server.start();
+
+    int client = connectTo(server.port());
+    ASSERT_NE(client, (-1));
+
+    constexpr int NumMessages = 100;
+    std::string expected;
+    for (int i = 0; i < NumMessages; ++i)
+    {
+        expected += message;
+    }
+
+    EXPECT_TRUE(echo(client, NumMessages) == expected);
+
+    close(client);
+
+    server.stop();
+    server.wait();
+}
+
+
+TEST_P(ReactorTest, CheckReconnect)
+{
+    EchoServer server(port(1));
+    server.setReactorThreads(1, GetParam());
+    server.start();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        int client = connectTo(server.port());
+        ASSERT_NE(client, (-1));
+
+        EXPECT_EQ(echo(client, 1), message);
+        close(client);
+
+        waitForSessions(server, 0); /* Session removed from its event-loop before the next */
+        ASSERT_TRUE(server.outgoingQueueStats().empty());
+    }
+
+    server.stop();
+    server.wait();
+}
+
+
+TEST_P(ReactorTest, CheckStopWithConnectedClient)
+{
+    EchoServer server(port(2));
+    server.setReactorThreads(1, GetParam());
+    server.start();
+
+    int client = connectTo(server.port());
+    ASSERT_NE(client, (-1));
+    EXPECT_EQ(echo(client, 1), message);
+
+    auto start = std::chrono::steady_clock::now();
+    server.stop();
+    server.wait();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+    /* NB: io_uring teardown can interrupt a timed recv() on the thread that started the server */
+    char buffer[64];
+    long nBytes;
+    while ((nBytes = recv(client, buffer, sizeof(buffer), 0)) == (-1) && errno == EINTR)
+    {
+    }
+
+    EXPECT_EQ(nBytes, 0) << std::strerror(errno); /* Closed by the server */
+
+    close(client);
+}
+
+
+INSTANTIATE_TEST_SUITE_P(AllBackends, ReactorTest, testing::Values(ConnectionManager::ReactorBackend::Epoll, ConnectionManager::ReactorBackend::IoUring));
+
+} // namespace Socket
@@ -0,0 +1,598 @@
+/**
+ * @file TestServer.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <fix/FixBuilder.hpp>
+#include <fix/FixTag.hpp>
+#include <gtest/gtest.h>
+#include <logger/Logger.hpp>
+#include <memory>
+#include <netinet/in.h>
+#include <socket/BackpressurePolicy.hpp>
+#include <socket/Server.hpp>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace Socket
+{
+
+class ServerTest : public testing::Test
+{
+protected:
+    /* Discards incoming messages */
+    class SinkServer : public Server
+    {
+    public:
+        using Server::Server;
+        using Server::MaxRecordSize;
+
+    protected:
+        void handleMessage(Message, SocketFD) override {}
+    };
+
+    /* Sends every message straight back to the sender */
+    class EchoServer : public Server
+    {
+    public:
+        using Server::Server;
+
+    protected:
+        void handleMessage(Message message, SocketFD fromSocket) override { sendMessage(std::move(message), fromSocket); }
+    };
+
+    static sockaddr_in loopback(ConnectionManager::Port port)
+    {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return address;
+    }
+
+    /* Loopback TCP client. A receiveBuffer is set before connecting so the window is small from the
+     * start. Returns (-1) on failure */
+    static int connectTo(ConnectionManager::Port port, int receiveBuffer = 0)
+    {
+        int client = socket(AF_INET, SOCK_STREAM, 0);
+
+        if (receiveBuffer > 0)
+            setsockopt(client, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+
+        sockaddr_in address = loopback(port);
+
+        if (connect(client, (const struct sockaddr *)&address, sizeof(address)) != 0)
+        {
+            close(client);
+            return (-1);
+        }
+
+        return client;
+    }
+
+    /* Read until n bytes have arrived, the peer closes or the 2s timeout expires */
+    static std::string receive(int client, std::size_t n)
+    {
+        timeval timeout{2, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        std::string received;
+        char buffer[4096];
+
+        while (received.size() < n)
+        {
+            long nBytes = recv(client, buffer, sizeof(buffer), 0);
+            if (nBytes <= 0)
+                break;
+
+            received.append(buffer, static_cast<std::size_t>(nBytes));
+        }
+
+        return received;
+    }
+
+    static uint64_t totalAccepted(const Server &server)
+    {
+        uint64_t total = 0;
+        for (const auto &stats : server.acceptorStats())
+        {
+            total += stats.accepted;
+        }
+
+        return total;
+    }
+};
+
+
+TEST_F(ServerTest, CheckReusePortAcceptors)
+{
+    Logger::instance().setLevel(Logger::Warn);
+
+    SinkServer server(SocketAddress(26543));
+    server.setAcceptorThreads(2);
+    server.start();
+
+    ASSERT_EQ(server.listenSockets().size(), 2u);
+
+    constexpr int NumClients = 16;
+    std::vector<int> clients;
+
+    for (int i = 0; i < NumClients; ++i)
+    {
+        int client = connectTo(server.port());
+        ASSERT_NE(client, (-1));
+        clients.push_back(client);
+    }
+
+    for (int i = 0; i < 200 && totalAccepted(server) < NumClients; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    EXPECT_EQ(totalAccepted(server), static_cast<uint64_t>(NumClients));
+
+    for (int client : clients)
+    {
+        close(client);
+    }
+
+    server.stop();
+    server.wait();
+}
+
+
+TEST_F(ServerTest, CheckAcceptBacksOffWhenOutOfDescriptors)
+{
+    Logger::instance().setLevel(Logger::Critical);
+
+    SinkServer server(SocketAddress(26549));
+    server.start();
+
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_NE(client, (-1));
+
+    /* Use up every descriptor: the queued connection cannot be accepted */
+    rlimit original{};
+    ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &original), 0);
+
+    rlimit limited = original;
+    limited.rlim_cur = std::min<rlim_t>(original.rlim_cur, 1024);
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &limited), 0);
+
+    std::vector<int> fillers;
+    for (int fd; (fd = dup(client)) != (-1);)
+    {
+        fillers.push_back(fd);
+    }
+
+    sockaddr_in address = loopback(server.port());
+    EXPECT_EQ(connect(client, (const struct sockaddr *)&address, sizeof(address)), 0); /* Queued by the kernel */
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    uint64_t errors = server.acceptorStats().front().errors;
+
+    for (int fd : fillers)
+    {
+        close(fd);
+    }
+
+    setrlimit(RLIMIT_NOFILE, &original);
+
+    /* Retried every 100ms rather than in a tight loop */
+    EXPECT_GE(errors, 1u);
+    EXPECT_LE(errors, 10u);
+
+    /* Accepted once descriptors are free again */
+    for (int i = 0; i < 200 && totalAccepted(server) < 1; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    EXPECT_EQ(totalAccepted(server), 1u);
+
+    close(client);
+
+    server.stop();
+    server.wait();
+}
+
+
+TEST_F(ServerTest, CheckBroadcastReachesAllSessions)
+{
+    Logger::instance().setLevel(Logger::Warn);
+
+    SinkServer server(SocketAddress(26544));
+    server.start();
+
+    constexpr int NumClients = 3;
+    std::vector<int> clients;
+
+    for (int i = 0; i < NumClients; ++i)
+    {
+        int client = connectTo(server.port());
+        ASSERT_NE(client, (-1));
+        clients.push_back(client);
+    }
+
+    for (int i = 0; i < 200 && totalAccepted(server) < NumClients; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(totalAccepted(server), static_cast<uint64_t>(NumClients));
+
+    auto message = std::make_shared<const std::string>("8=FIX.4.2\x01" "35=D\x01");
+    server.broadcast(message);
+
+    for (int client : clients)
+    {
+        timeval timeout{2, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        std::string received;
+        char buffer[64];
+
+        while (received.size() < message->size())
+        {
+            long nBytes = recv(client, buffer, sizeof(buffer), 0);
+            if (nBytes <= 0)
+                break;
+
+            received.append(buffer, static_cast<std::size_t>(nBytes));
+        }
+
+        EXPECT_EQ(received, *message);
+        close(client);
+    }
+
+    server.stop();
+    server.wait();
+}
+
+
+TEST_F(ServerTest, CheckBlockedSenderDisconnectsSlowConsumer)
+{
+    Logger::instance().setLevel(Logger::Warn);
+
+    SinkServer server(SocketAddress(26547));
+    server.setBackpressurePolicy(BackpressurePolicy::parse("policy=block,high=8,low=4,timeout=200"));
+    server.start();
+
+    int client = connectTo(server.port(), 4096); /* Never read => the server's queue fills */
+    ASSERT_NE(client, (-1));
+
+    for (int i = 0; i < 200 && server.outgoingQueueStats().empty(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(server.outgoingQueueStats().size(), 1u);
+
+    /* Each broadcast blocks for at most the timeout, then the session is disconnected and cleaned up */
+    auto message = std::make_shared<const std::string>(65536, 'x');
+    auto start = std::chrono::steady_clock::now();
+
+    while (!server.outgoingQueueStats().empty() && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+    {
+        server.broadcast(message);
+    }
+
+    EXPECT_TRUE(server.outgoingQueueStats().empty());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+
+    /* Peer still connected and not reading: the sender must have been woken for teardown to finish */
+    auto stopStart = std::chrono::steady_clock::now();
+    server.stop();
+    server.wait();
+    EXPECT_LT(std::chrono::steady_clock::now() - stopStart, std::chrono::seconds(1));
+
+    /* Queued bytes, then the close */
+    timeval timeout{5, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    char buffer[65536];
+    long nBytes;
+    while ((nBytes = recv(client, buffer, sizeof(buffer), 0)) > 0)
+    {
+    }
+
+    EXPECT_TRUE(nBytes == 0 || errno == ECONNRESET);
+    close(client);
+}
+
+
+TEST_F(ServerTest, CheckStopWithNonReadingPeerIsPrompt)
+{
+    Logger::instance().setLevel(Logger::Error);
+
+    SinkServer server(SocketAddress(26548));
+    server.setBackpressurePolicy(BackpressurePolicy::parse("policy=drop"));
+    server.start();
+
+    int client = connectTo(server.port(), 4096); /* Never read => the sender blocks on a full socket */
+    ASSERT_NE(client, (-1));
+
+    for (int i = 0; i < 200 && server.outgoingQueueStats().empty(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(server.outgoingQueueStats().size(), 1u);
+
+    auto message = std::make_shared<const std::string>(65536, 'x');
+    for (int i = 0; i < 200; ++i)
+    {
+        server.broadcast(message);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); /* Sender is now blocked */
+
+    auto start = std::chrono::steady_clock::now();
+    server.stop();
+    server.wait();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+    close(client);
+}
+
+
+TEST_F(ServerTest, CheckReactorFlushesPartialWrites)
+{
+    Logger::instance().setLevel(Logger::Warn);
+
+    SinkServer server(SocketAddress(26546));
+    server.setReactorThreads(1);
+    server.start();
+
+    int client = connectTo(server.port(), 4096); /* Small => short writes and EAGAIN */
+    ASSERT_NE(client, (-1));
+
+    for (int i = 0; i < 200 && totalAccepted(server) < 1; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(totalAccepted(server), 1u);
+
+    std::string expected;
+    for (int i = 0; i < 256; ++i)
+    {
+        auto message = std::make_shared<const std::string>(std::to_string(i) + ":" + std::string(3000 + i, static_cast<char>('a' + i % 26)) + ";");
+        expected += *message;
+        server.broadcast(message);
+    }
+
+    timeval timeout{2, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    std::string received;
+    char buffer[4096];
+
+    while (received.size() < expected.size())
+    {
+        long nBytes = recv(client, buffer, sizeof(buffer), 0);
+        if (nBytes <= 0)
+            break;
+
+        received.append(buffer, static_cast<std::size_t>(nBytes));
+    }
+
+    EXPECT_EQ(received.size(), expected.size());
+    EXPECT_TRUE(received == expected); /* In order with no bytes lost or repeated */
+
+    close(client);
+
+    server.stop();
+    server.wait();
+}
+
+TEST_F(ServerTest, CheckSeqPacketLargeMessages)
+{
+    Logger::instance().setLevel(Logger::Error);
+
+    using Backend = ConnectionManager::ReactorBackend;
+
+    /* Thread per connection, epoll and io_uring */
+    for (auto [nReactors, backend] : {std::pair(0u, Backend::Epoll), std::pair(1u, Backend::Epoll), std::pair(1u, Backend::IoUring)})
+    {
+        const SocketAddress address(SocketAddress::Family::UnixPacket, "/tmp/talos-test-" + std::to_string(getpid()) + ".sock");
+
+        SinkServer server(address);
+        server.setReactorThreads(nReactors, backend);
+        server.start();
+
+        auto connectClient = [&address]()
+        {
+            int client = address.openSocket();
+            sockaddr_storage storage{};
+            socklen_t length = address.toSockaddr(storage, true);
+            EXPECT_EQ(connect(client, reinterpret_cast<const sockaddr *>(&storage), length), 0);
+
+            timeval timeout{2, 0};
+            setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            return client;
+        };
+
+        /* Sent as several records of at most MaxRecordSize bytes and reassembled */
+        int client = connectClient();
+
+        for (int i = 0; i < 200 && totalAccepted(server) < 1; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        auto message = std::make_shared<const std::string>(3 * SinkServer::MaxRecordSize + 100, 'x');
+        server.broadcast(message);
+
+        std::string received;
+        char buffer[4 * SinkServer::MaxRecordSize];
+
+        while (received.size() < message->size())
+        {
+            long nBytes = recv(client, buffer, sizeof(buffer), 0);
+            if (nBytes <= 0)
+                break;
+
+            EXPECT_LE(static_cast<std::size_t>(nBytes), SinkServer::MaxRecordSize);
+            received.append(buffer, static_cast<std::size_t>(nBytes));
+        }
+
+        EXPECT_TRUE(received == *message);
+
+        /* Oversized record from the peer is not silently truncated: the session is closed */
+        const std::string oversized(2 * SinkServer::MaxRecordSize, 'y');
+        ASSERT_EQ(send(client, oversized.data(), oversized.size(), 0), static_cast<long>(oversized.size()));
+        EXPECT_EQ(recv(client, buffer, sizeof(buffer), 0), 0);
+
+        close(client);
+
+        server.stop();
+        server.wait();
+    }
+}
+
+
+
+TEST_F(ServerTest, CheckEchoAcrossReactors)
+{
+    Logger::instance().setLevel(Logger::Warn);
+
+    EchoServer server(SocketAddress(26541));
+    server.setReactorThreads(3);
+    server.start();
+
+    /* Sessions are assigned round-robin => two per event-loop, all echoing at once */
+    constexpr int NumClients = 6;
+    constexpr int NumMessages = 200;
+
+    std::vector<int> clients;
+    std::vector<std::string> expected(NumClients);
+    std::vector<std::string> received(NumClients);
+
+    for (int i = 0; i < NumClients; ++i)
+    {
+        int client = connectTo(server.port());
+        ASSERT_NE(client, (-1));
+        clients.push_back(client);
+
+        for (int j = 0; j < NumMessages; ++j)
+        {
+            FixBuilder builder(256);
+            builder.set<FixTag::MsgType>(FixMsgType::NewOrderSingle).append(FixTag::ClOrdID, std::to_string(i) + "-" + std::to_string(j));
+            expected[i] += builder.finish();
+        }
+    }
+
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < NumClients; ++i)
+    {
+        threads.emplace_back([&, i]()
+        {
+            if (send(clients[i], expected[i].data(), expected[i].size(), 0) == static_cast<long>(expected[i].size()))
+                received[i] = receive(clients[i], expected[i].size());
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int i = 0; i < NumClients; ++i)
+    {
+        EXPECT_TRUE(received[i] == expected[i]) << "client " << i; /* Own messages only, in order */
+        close(clients[i]);
+    }
+
+    server.stop();
+    server.wait();
+}
+
+
+TEST_F(ServerTest, CheckConcurrentProducersOnOneSession)
+{
+    Logger::instance().setLevel(Logger::Warn);
+
+    SinkServer server(SocketAddress(26542));
+    server.start();
+
+    int client = connectTo(server.port());
+    ASSERT_NE(client, (-1));
+
+    for (int i = 0; i < 200 && server.outgoingQueueStats().empty(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(server.outgoingQueueStats().size(), 1u);
+    const ConnectionManager::SocketFD socket = server.outgoingQueueStats().front().first;
+
+    /* Each message is "producer:sequence;" padded so that batches span several writes */
+    constexpr int NumProducers = 4;
+    constexpr int NumMessages = 2000;
+
+    auto format = [](int producer, int sequence)
+    {
+        std::string message = std::to_string(producer) + ":" + std::to_string(sequence) + ":";
+        return message.append(64 - message.size() - 1, 'x').append(";");
+    };
+
+    std::vector<std::thread> producers;
+
+    for (int producer = 0; producer < NumProducers; ++producer)
+    {
+        producers.emplace_back([&server, &format, socket, producer]()
+        {
+            for (int sequence = 0; sequence < NumMessages; ++sequence)
+            {
+                server.sendMessage(format(producer, sequence), socket);
+            }
+        });
+    }
+
+    std::string received = receive(client, std::size_t{NumProducers} * NumMessages * 64);
+
+    for (auto &thread : producers)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(received.size(), std::size_t{NumProducers} * NumMessages * 64);
+
+    /* Messages arrive whole and, per producer, in the order sent */
+    std::vector<int> nextSequence(NumProducers, 0);
+
+    for (std::size_t offset = 0; offset < received.size(); offset += 64)
+    {
+        std::string_view message(received.data() + offset, 64);
+        int producer = message[0] - '0';
+
+        ASSERT_TRUE(producer >= 0 && producer < NumProducers);
+        ASSERT_EQ(message, format(producer, nextSequence[producer]));
+        ++nextSequence[producer];
+    }
+
+    EXPECT_EQ(nextSequence, std::vector<int>(NumProducers, NumMessages));
+
+    close(client);
+
+    server.stop();
+    server.wait();
+}
+
+} // namespace Socket
@@ -0,0 +1,167 @@
+/**
+ * @file TestShmChannel.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <socket/ShmChannel.hpp>
+#include <string>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace Socket
+{
+
+class ShmChannelTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+
+        server = ShmChannel::offer(sockets[0]);
+        client = ShmChannel::accept(sockets[1]);
+    }
+
+    void TearDown() override
+    {
+        close(sockets[0]);
+        close(sockets[1]);
+    }
+
+    int sockets[2]{-1, -1};
+    std::unique_ptr<ShmChannel> server;
+    std::unique_ptr<ShmChannel> client;
+};
+
+
+TEST_F(ShmChannelTest, CheckRoundTripAcrossWrap)
+{
+    const std::string message(ShmChannel::RingCapacity / 3, 'x');
+    std::string received(message.size(), '\0');
+
+    /* Three messages leave the fourth straddling the end of the ring */
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(client->tryWrite(message.data(), message.size()));
+        client->notifyPeer();
+
+        ASSERT_TRUE(server->waitReadable(sockets[0], Doorbell::WaitStrategy::Block));
+        EXPECT_EQ(server->readable(), message.size());
+        EXPECT_EQ(server->read(received.data(), received.size()), message.size());
+        EXPECT_EQ(received, message);
+    }
+
+    /* All or nothing when full */
+    EXPECT_TRUE(server->tryWrite(message.data(), message.size()));
+    EXPECT_TRUE(server->tryWrite(message.data(), message.size()));
+    EXPECT_TRUE(server->tryWrite(message.data(), message.size()));
+    EXPECT_FALSE(server->tryWrite(message.data(), message.size()));
+    EXPECT_EQ(client->readable(), 3 * message.size());
+}
+
+
+TEST_F(ShmChannelTest, CheckParkedReaderWoken)
+{
+    std::thread writer([this]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); /* Reader parks first */
+        server->tryWrite("8=FIX", 5);
+        server->notifyPeer();
+        server->close();
+    });
+
+    char buffer[5];
+    ASSERT_TRUE(client->waitReadable(sockets[1], Doorbell::WaitStrategy::Block));
+    EXPECT_EQ(client->read(buffer, sizeof(buffer)), 5u);
+    EXPECT_FALSE(client->waitReadable(sockets[1], Doorbell::WaitStrategy::Block)); /* Closed and drained */
+
+    writer.join();
+}
+
+TEST_F(ShmChannelTest, CheckSpinningReaderExits)
+{
+    /* Local wake-up (e.g. shutdown) */
+    std::thread waker([this]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        server->wakeReader();
+    });
+
+    EXPECT_TRUE(server->waitReadable(sockets[0], Doorbell::WaitStrategy::Spin)); /* Woken: caller rechecks */
+    EXPECT_EQ(server->readable(), 0u);
+    waker.join();
+
+    /* Peer exits without close() */
+    std::thread crasher([this]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        shutdown(sockets[1], SHUT_RDWR);
+    });
+
+    EXPECT_FALSE(server->waitReadable(sockets[0], Doorbell::WaitStrategy::Spin));
+    crasher.join();
+}
+
+TEST_F(ShmChannelTest, CheckCorruptPositionsClose)
+{
+    /* Offer by hand so the test can scribble on the ring headers as a rogue peer would */
+    constexpr std::size_t RingSize = 4096 + ShmChannel::RingCapacity;
+
+    int pair[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+
+    int fds[3] = {memfd_create("test-shm", MFD_CLOEXEC), eventfd(0, EFD_NONBLOCK), eventfd(0, EFD_NONBLOCK)};
+    ASSERT_EQ(ftruncate(fds[0], 2 * RingSize), 0);
+
+    char payload = 'S';
+    struct iovec iov{&payload, sizeof(payload)};
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(fds))]{};
+
+    struct msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+    ASSERT_EQ(sendmsg(pair[0], &msg, 0), 1);
+
+    auto victim = ShmChannel::accept(pair[1]);
+
+    void *mapping = mmap(nullptr, 2 * RingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+    ASSERT_NE(mapping, MAP_FAILED);
+
+    /* Victim reads ring 0: write position far past the read position */
+    auto *writePosition = static_cast<std::atomic<uint64_t> *>(mapping);
+    writePosition->store(ShmChannel::RingCapacity + 1);
+
+    char buffer[64];
+    EXPECT_EQ(victim->readable(), 0u);
+    EXPECT_EQ(victim->read(buffer, sizeof(buffer)), 0u);
+    EXPECT_TRUE(victim->corrupted());
+    EXPECT_TRUE(victim->peerClosed());
+    EXPECT_FALSE(victim->waitReadable(pair[1], Doorbell::WaitStrategy::Block));
+
+    munmap(mapping, 2 * RingSize);
+    for (int fd : fds)
+        close(fd);
+    close(pair[0]);
+    close(pair[1]);
+}
+
+} // namespace Socket
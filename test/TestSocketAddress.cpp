@@ -0,0 +1,45 @@
+/**
+ * @file TestSocketAddress.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <socket/SocketAddress.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace Socket
+{
+
+TEST(SocketAddressTest, CheckParse)
+{
+    SocketAddress tcp = SocketAddress::parse("8080");
+    EXPECT_EQ(tcp.family, SocketAddress::Family::Tcp);
+    EXPECT_EQ(tcp.port, 8080);
+    EXPECT_EQ(tcp.toString(), "tcp:8080");
+    EXPECT_EQ(SocketAddress::parse("tcp:8080").port, 8080);
+
+    SocketAddress stream = SocketAddress::parse("unix:/run/talos/db.sock");
+    EXPECT_EQ(stream.family, SocketAddress::Family::Unix);
+    EXPECT_EQ(stream.path, "/run/talos/db.sock");
+    EXPECT_EQ(SocketAddress::parse(stream.toString()).path, stream.path);
+
+    SocketAddress packet = SocketAddress::parse("unixpacket:/tmp/exchange.sock");
+    EXPECT_EQ(packet.family, SocketAddress::Family::UnixPacket);
+    EXPECT_TRUE(packet.isUnix());
+
+    SocketAddress shm = SocketAddress::parse("shm:/tmp/db.sock");
+    EXPECT_TRUE(shm.isSharedMemory());
+    EXPECT_EQ(shm.toString(), "shm:/tmp/db.sock");
+
+    EXPECT_THROW(SocketAddress::parse("0"), std::runtime_error);
+    EXPECT_THROW(SocketAddress::parse("70000"), std::runtime_error);
+    EXPECT_THROW(SocketAddress::parse("unix:"), std::runtime_error);
+    EXPECT_THROW(SocketAddress::parse("unix:/" + std::string(200, 'a')), std::runtime_error);
+}
+
+} // namespace Socket
@@ -0,0 +1,58 @@
+/**
+ * @file TestSocketOptions.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <socket/SocketOptions.hpp>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace Socket
+{
+
+TEST(SocketOptionsTest, CheckParse)
+{
+    SocketOptions options = SocketOptions::parse("nodelay=0,quickack=1,sndbuf=65536,usertimeout=5000,keepalive=30:10:3");
+
+    EXPECT_FALSE(options.noDelay);
+    EXPECT_TRUE(options.quickAck);
+    EXPECT_EQ(options.sendBufferBytes, 65536);
+    EXPECT_EQ(options.receiveBufferBytes, 0);
+    EXPECT_EQ(options.userTimeoutMillis, 5000);
+    EXPECT_TRUE(options.keepAlive);
+    EXPECT_EQ(options.keepAliveIdleSecs, 30);
+    EXPECT_EQ(options.keepAliveIntervalSecs, 10);
+    EXPECT_EQ(options.keepAliveCount, 3);
+
+    EXPECT_TRUE(SocketOptions::parse("").noDelay); /* Default: Nagle off */
+
+    EXPECT_THROW(SocketOptions::parse("nodelay"), std::runtime_error);
+    EXPECT_THROW(SocketOptions::parse("sndbuf=big"), std::runtime_error);
+    EXPECT_THROW(SocketOptions::parse("keepalive=30:10"), std::runtime_error);
+    EXPECT_THROW(SocketOptions::parse("nagle=1"), std::runtime_error);
+}
+
+
+TEST(SocketOptionsTest, CheckApplyAndDescribe)
+{
+    int socket = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_NE(socket, -1);
+
+    EXPECT_TRUE(SocketOptions::parse("usertimeout=5000,keepalive=30:10:3").apply(socket));
+
+    std::string effective = SocketOptions::describe(socket);
+    EXPECT_NE(effective.find("nodelay=1"), std::string::npos);
+    EXPECT_NE(effective.find("usertimeout=5000"), std::string::npos);
+    EXPECT_NE(effective.find("keepalive=30:10:3"), std::string::npos);
+
+    close(socket);
+}
+
+} // namespace Socket
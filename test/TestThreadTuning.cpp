@@ -0,0 +1,33 @@
+/**
+ * @file TestThreadTuning.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <utilities/ThreadTuning.hpp>
+#include <vector>
+
+namespace Utilities
+{
+
+TEST(ThreadTuningTest, CheckParseCpuList)
+{
+    EXPECT_EQ(ThreadTuning::parseCpuList("3"), std::vector<int>({3}));
+    EXPECT_EQ(ThreadTuning::parseCpuList("2,4-6,0"), std::vector<int>({2, 4, 5, 6, 0}));
+    EXPECT_TRUE(ThreadTuning::parseCpuList("").empty());
+
+    EXPECT_THROW(ThreadTuning::parseCpuList("a"), std::runtime_error);
+    EXPECT_THROW(ThreadTuning::parseCpuList("1,"), std::runtime_error);
+    EXPECT_THROW(ThreadTuning::parseCpuList("5-2"), std::runtime_error);
+
+    /* Round-robin over roles with fewer CPUs than threads */
+    EXPECT_EQ(ThreadTuning::select({2, 3}, 3), 3);
+    EXPECT_EQ(ThreadTuning::select({}, 0), -1);
+}
+
+} // namespace Utilities